@@ -0,0 +1,18 @@
+#version 120
+
+/** Instanced variant of default.vert, a_model advances once per instance */
+
+uniform mat4 u_vp;
+
+attribute vec3 a_v;
+attribute vec3 a_vn;
+attribute vec2 a_vt;
+attribute mat4 a_model;
+
+varying vec2 v_uv;
+
+void main()
+{
+    gl_Position = u_vp * a_model * vec4(a_v, 1.0);
+    v_uv = a_vt;
+}
\ No newline at end of file
@@ -1,13 +1,13 @@
 #version 120
 
-uniform vec4 u_tile = vec4(0.0f, 0.0f, 1.0f, 1.0f);
+/** Batched sprites: v_uv is already mapped to the sprite's uv rect */
+
 uniform sampler2D u_sampler2D;
 
 varying vec2 v_uv;
+varying vec4 v_color;
 
 void main()
 {
-    float scaled_u = u_tile.x + ((u_tile.z - u_tile.x) * v_uv.x);
-    float scaled_v = u_tile.y + ((u_tile.w - u_tile.y) * v_uv.y);
-    gl_FragColor = vec4(texture2D(u_sampler2D, vec2(scaled_u, scaled_v)).rgba);
+    gl_FragColor = texture2D(u_sampler2D, v_uv) * v_color;
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 120
+
+/** Batched text: glyph pages hold signed distance fields in alpha, 0.5 on the outline */
+
+uniform sampler2D u_sampler2D;
+
+varying vec2 v_uv;
+varying vec4 v_color;
+
+void main()
+{
+    float distance = texture2D(u_sampler2D, v_uv).a;
+    float width    = max(fwidth(distance), 0.0001);
+    float alpha    = smoothstep(0.5 - width, 0.5 + width, distance);
+    gl_FragColor = vec4(v_color.rgb, v_color.a * alpha);
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#version 120
+
+/** Batched text: a_v is already in world space, u_mvp is projection * view */
+
+uniform mat4 u_mvp;
+
+attribute vec3 a_v;
+attribute vec2 a_vt;
+attribute vec4 a_c;
+
+varying vec2 v_uv;
+varying vec4 v_color;
+
+void main()
+{
+    gl_Position = u_mvp * vec4(a_v, 1.0);
+    v_uv = a_vt;
+    v_color = a_c;
+}
\ No newline at end of file
@@ -25,7 +25,9 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <memory>
 
 using AssetName  = std::string;
 using AssetPath = std::string;
@@ -33,6 +35,42 @@ using AssetPaths = std::vector<AssetPath>;
 
 class AssetInventory; /** Forward declaration for AssetInventory */
 
+namespace core::assets
+{
+    class AssetPack; /** Forward declaration for AssetPack */
+}
+
+/**
+ * @brief Read-only bytes of an opened asset
+ *
+ * Points into the asset pack when the asset is stored uncompressed there,
+ * otherwise it keeps alive whatever holds the bytes (a mapping of the loose
+ * file or the decompressed copy). Copies share the same bytes.
+ */
+class AssetSpan
+{
+private:
+    const char                 *m_data = nullptr;
+    std::size_t                 m_size = 0;
+    std::shared_ptr<const void> m_owner;
+
+public:
+    AssetSpan() = default;
+    AssetSpan(const char *data, std::size_t size, std::shared_ptr<const void> owner = nullptr)
+        : m_data(data),
+          m_size(size),
+          m_owner(std::move(owner))
+    {
+    }
+
+    const char      *data() const noexcept { return m_data; }
+    std::size_t      size() const noexcept { return m_size; }
+    bool             empty() const noexcept { return m_size == 0; }
+    const char      *begin() const noexcept { return m_data; }
+    const char      *end() const noexcept { return m_data + m_size; }
+    std::string_view view() const noexcept { return std::string_view(m_data, m_size); }
+};
+
 /**
  * @brief Enum class for Asset types
  *
@@ -54,8 +92,12 @@ private:
     using AssetList = std::unordered_map<std::string, AssetPaths>;
     std::unordered_map<AssetType, AssetList> cache;
     std::string                              assetsDirectory;
+    std::unique_ptr<core::assets::AssetPack> pack;
 
     AssetInventory();
+
+    /** @brief Registers the asset at @p assetPath, relative to the project directory */
+    void addAsset(const std::string &assetPath);
 public:
     static AssetInventory &getInstance();
     ~AssetInventory();
@@ -68,6 +110,17 @@ public:
     void loadInventory(const std::string &inventoryFile);
 
     const std::vector<AssetPath>& lookupAssets(const AssetType &type, const AssetName &name);
+    /** @brief Checks if an asset named @p name of @p type was found, lookupAssets throws otherwise */
+    bool hasAsset(const AssetType &type, const AssetName &name) const;
+
+    /**
+     * @brief Opens an asset path returned by lookupAssets
+     *
+     * Safe to call from any thread.
+     *
+     * @throw std::runtime_error if the asset can't be read
+     */
+    AssetSpan openAsset(const AssetPath &path) const;
 };
 
 /** @} endgroup Assets */
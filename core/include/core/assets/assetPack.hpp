@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file core/assets/assetPack.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Assets
+ * @{
+ */
+
+#include "../utils/mappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core::assets
+{
+    /**
+     * @brief Read-only archive of asset files, mapped once and read in place
+     *
+     * File layout in host byte order:
+     *  - Header
+     *  - Entry[entryCount], sorted by name hash so lookups are a binary search
+     *  - names, the asset paths of the entries back to back
+     *  - payloads in the order they were added, each aligned to payloadAlignment
+     *
+     * Entries are named by their asset path relative to the project directory
+     * with forward slashes, e.g. "assets/textures/crate.png", the same paths
+     * AssetInventory::lookupAssets returns for loose files. A payload may be LZ4
+     * compressed, see @ref AssetInventory::openAsset.
+     */
+    class AssetPack
+    {
+    public:
+        static constexpr std::uint32_t magic            = 0x4b415043; /** "CPAK" */
+        static constexpr std::uint32_t version          = 1;
+        static constexpr std::size_t   payloadAlignment = 64;
+
+        enum Flags : std::uint32_t
+        {
+            Lz4 = 1 << 0, /** payload is an LZ4 block of Entry::size bytes */
+        };
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t entryCount;
+            std::uint32_t reserved;
+            std::uint64_t namesOffset;
+            std::uint64_t namesSize;
+        };
+
+        struct Entry
+        {
+            std::uint64_t hash;       /** @ref hashName of the name */
+            std::uint64_t offset;     /** payload offset from the start of the file */
+            std::uint64_t storedSize; /** payload bytes in the file */
+            std::uint64_t size;       /** bytes of the asset once decompressed */
+            std::uint32_t nameOffset; /** from the start of the names */
+            std::uint32_t nameSize;
+            std::uint32_t flags;
+            std::uint32_t reserved;
+        };
+
+    private:
+        core::utils::MappedFile m_file;
+        const Header           *m_header  = nullptr;
+        const Entry            *m_entries = nullptr;
+        const char             *m_names   = nullptr;
+
+    protected:
+    public:
+        AssetPack();
+        /**
+         * @brief Maps the pack at @p path and checks its index
+         *
+         * @throw std::runtime_error if the file can't be mapped or isn't a valid pack
+         */
+        AssetPack(const std::string &path);
+        ~AssetPack();
+
+        AssetPack(AssetPack &o)            = delete;
+        AssetPack &operator=(AssetPack &o) = delete;
+        AssetPack(AssetPack &&o);
+        AssetPack &operator=(AssetPack &&o);
+
+        static std::uint64_t hashName(std::string_view name) noexcept;
+
+        /** @brief Finds the entry named @p name, nullptr if there is none */
+        const Entry *find(std::string_view name) const noexcept;
+
+        /** @brief Number of entries */
+        std::size_t  size() const noexcept { return m_header ? m_header->entryCount : 0; }
+        const Entry &entry(std::size_t index) const noexcept { return m_entries[index]; }
+
+        std::string_view name(const Entry &entry) const noexcept;
+        /** @brief Stored payload of @p entry, compressed if its flags say so */
+        const char *payload(const Entry &entry) const noexcept { return m_file.data() + entry.offset; }
+    };
+
+    /**
+     * @brief Builds asset packs, used by the asset-pack tool
+     */
+    class AssetPackWriter
+    {
+    public:
+        struct Stats
+        {
+            std::size_t entries    = 0;
+            std::size_t compressed = 0; /** entries stored as LZ4 */
+            std::size_t size       = 0; /** bytes of all assets */
+            std::size_t storedSize = 0; /** bytes of all payloads in the pack */
+        };
+
+    private:
+        struct Pending
+        {
+            std::string       name;
+            std::vector<char> data;
+            bool              compress;
+        };
+
+        std::vector<Pending> m_pending;
+
+    protected:
+    public:
+        /**
+         * @brief Adds an asset, payloads are written in the order they're added
+         *
+         * @param name asset path, see AssetPack
+         * @param compress store as LZ4 if that saves at least an eighth of the size
+         */
+        void add(const std::string &name, std::vector<char> data, bool compress);
+
+        /**
+         * @brief Writes the pack to @p path
+         *
+         * @throw std::runtime_error if two assets have the same name or @p path
+         * can't be written
+         */
+        Stats write(const std::string &path) const;
+    };
+} // namespace core::assets
+
+/** @} endgroup Assets */
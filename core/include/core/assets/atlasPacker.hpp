@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file core/assets/atlasPacker.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Assets
+ * @{
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core::assets
+{
+    /**
+     * @brief Packs rectangles into texture atlas pages with MaxRects
+     *
+     * Each page keeps the list of maximal free rectangles, a rectangle is placed
+     * where it leaves the shortest leftover side (best short side fit). Pages
+     * opened by a @ref pack call are shrunk to the area they use afterwards, so
+     * later calls only fill the free space left inside that area before opening
+     * new pages. Placements never move once returned.
+     *
+     * Only computes placements, the caller owns the pixels.
+     */
+    class AtlasPacker
+    {
+    public:
+        struct Settings
+        {
+            std::uint32_t maxPageSize = 2048; /** page width and height limit */
+            std::uint32_t padding     = 2;    /** pixels reserved around each rectangle */
+            bool          powerOfTwo  = true; /** round page sizes up to powers of two */
+        };
+
+        struct Rect
+        {
+            std::uint32_t x = 0, y = 0, w = 0, h = 0;
+        };
+
+        struct Placement
+        {
+            std::size_t page = 0;
+            Rect        rect; /** without the padding */
+        };
+
+        struct Page
+        {
+            std::uint32_t     width  = 0;
+            std::uint32_t     height = 0;
+            std::uint64_t     used   = 0; /** area of the placed rectangles, padding included */
+            std::vector<Rect> free;
+        };
+
+    private:
+        Settings          m_settings;
+        std::vector<Page> m_pages;
+
+        bool place(Page &page, std::uint32_t w, std::uint32_t h, Rect &rect) const;
+        void split(Page &page, const Rect &used) const;
+        void shrink(Page &page, std::uint32_t width, std::uint32_t height) const;
+
+    protected:
+    public:
+        AtlasPacker();
+        AtlasPacker(const Settings &settings);
+        ~AtlasPacker();
+        AtlasPacker(AtlasPacker &o)             = delete;
+        AtlasPacker &operator=(AtlasPacker &o)  = delete;
+        AtlasPacker(AtlasPacker &&o)            = default;
+        AtlasPacker &operator=(AtlasPacker &&o) = default;
+
+        /**
+         * @brief Places rectangles of the given sizes, larger ones first.
+         * Existing pages are filled before new ones are opened.
+         *
+         * @param sizes width and height of each rectangle
+         * @return placements in the order of @p sizes
+         * @throw std::runtime_error if a rectangle doesn't fit in an empty page
+         */
+        std::vector<Placement> pack(const std::vector<Rect> &sizes);
+
+        /** @brief Drops all pages */
+        void clear();
+
+        const Settings          &settings() const noexcept { return m_settings; }
+        const std::vector<Page> &pages() const noexcept { return m_pages; }
+        /** @brief Fraction of the page area used by placed rectangles */
+        float occupancy(std::size_t page) const;
+    };
+} // namespace core::assets
+
+/** @} endgroup Assets */
@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file core/assets/bakedTexture.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Assets
+ * @{
+ */
+
+#include "asset-inventory.hpp"
+#include "texture.hpp"
+#include "../utils/mappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core::assets
+{
+    /**
+     * @brief Texture converted ahead of time into what the renderer uploads
+     *
+     * A baked texture holds every mip level as RGBA8 with rows from bottom to top,
+     * so a load only hands the levels to the graphics API: no decode, no flip and
+     * no mipmap generation in the driver.
+     *
+     * @ref load bakes texture assets into CONFIG_CORE_TEXTURE_CACHE_DIR on first
+     * use and maps the baked file on later runs. Each entry stores the hash of its
+     * source file and is baked again once the source changes.
+     */
+    class BakedTexture
+    {
+    public:
+        static constexpr std::uint32_t magic            = 0x58455443; /** "CTEX" */
+        static constexpr std::uint32_t version          = 1;
+        static constexpr std::size_t   payloadAlignment = 16;
+
+        enum class Format : std::uint32_t
+        {
+            RGBA8 = 0,
+        };
+
+        /** File layout in host byte order: Header, Level[levels], payload */
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t sourceHash; /** hash of the source file, see @ref hashSource */
+            std::uint32_t format;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint32_t levels;
+            std::uint64_t payloadOffset; /** from the start of the file, aligned to payloadAlignment */
+        };
+
+        struct Level
+        {
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint64_t offset; /** from the start of the payload, aligned to payloadAlignment */
+            std::uint64_t size;
+        };
+
+    private:
+        AssetName               m_name;
+        core::utils::MappedFile m_file;
+        std::vector<char>       m_blob; /** used instead of m_file if the bake couldn't be cached */
+        const Header           *m_header  = nullptr;
+        const Level            *m_levels  = nullptr;
+        const char             *m_payload = nullptr;
+
+        /** Points the accessors into @p data, throws if it isn't a valid baked texture */
+        void attach(const char *data, std::size_t size);
+
+    protected:
+    public:
+        BakedTexture();
+        /** @brief Uses the baked texture in @p file */
+        BakedTexture(const AssetName &name, core::utils::MappedFile file);
+        /** @brief Uses the baked texture in @p blob, as returned by @ref bake */
+        BakedTexture(const AssetName &name, std::vector<char> blob);
+        ~BakedTexture();
+
+        BakedTexture(BakedTexture &o)            = delete;
+        BakedTexture &operator=(BakedTexture &o) = delete;
+        BakedTexture(BakedTexture &&o);
+        BakedTexture &operator=(BakedTexture &&o);
+
+        /**
+         * @brief Loads texture asset @p name from the bake cache, baking it first
+         * if it isn't cached yet or its source changed. Thread safe.
+         *
+         * @throw std::runtime_error if the asset can't be found or decoded
+         */
+        static BakedTexture load(const AssetName &name);
+
+        /**
+         * @brief Converts @p texture to a baked texture with its full mip chain
+         *
+         * @param sourceHash stored in the header to detect stale bakes
+         * @return std::vector<char> contents of the baked file
+         */
+        static std::vector<char> bake(const Texture &texture, std::uint64_t sourceHash);
+
+        /** @brief Hash of source file contents as stored in the header */
+        static std::uint64_t hashSource(const char *data, std::size_t size) noexcept;
+
+        const AssetName &name() const noexcept { return m_name; }
+        std::size_t      width() const noexcept { return m_header->width; }
+        std::size_t      height() const noexcept { return m_header->height; }
+        std::size_t      levels() const noexcept { return m_header->levels; }
+        std::uint64_t    sourceHash() const noexcept { return m_header->sourceHash; }
+        /** @brief Mip level @p index, 0 is the full size image */
+        const Level &level(std::size_t index) const noexcept { return m_levels[index]; }
+
+        /** @brief Pixels of all levels, see Level::offset */
+        const char *payload() const noexcept { return m_payload; }
+        std::size_t payloadSize() const noexcept;
+
+        /** @brief Whether the texture is read from a mapped cache file */
+        bool mapped() const noexcept { return !m_file.empty(); }
+    };
+} // namespace core::assets
+
+/** @} endgroup Assets */
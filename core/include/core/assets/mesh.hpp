@@ -14,6 +14,7 @@
 
 #include "asset-inventory.hpp"
 #include "../graphics/vertex.hpp"
+#include "../graphics/culling.hpp"
 
 namespace core::assets
 {
@@ -33,6 +34,10 @@ namespace core::assets
         bool                  m_hasBitangents; /** Whether mesh data has bitangents */
         std::vector<Vertex>   m_vertices;
         std::vector<uint32_t> m_indices;
+        MeshBounds            m_bounds;
+
+        /** @brief Recomputes bounds from the vertices */
+        void computeBounds() noexcept;
     public:
         Mesh(const AssetName &name);
         Mesh(const std::string    &name,
@@ -58,6 +63,8 @@ namespace core::assets
         const std::vector<Vertex> &getVertices() const noexcept;
         /** @brief Returns reference to vector containing the indices */
         const std::vector<uint32_t> &getIndices() const noexcept;
+        /** @brief Returns the bounding box and sphere of the vertices */
+        const MeshBounds &getBounds() const noexcept;
 
         friend Model;
     };
@@ -45,7 +45,7 @@ namespace core::assets
         {
             AssetPath          path;
             Shader::ShaderType shaderType;
-            std::vector<char>  binaryData;
+            AssetSpan          binaryData; /** keeps the mapped source or pack alive */
         };
 
     private:
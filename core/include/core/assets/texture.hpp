@@ -32,6 +32,15 @@ namespace core::assets
     public:
         Texture();
         Texture(const AssetName &name);
+        /**
+         * @brief Creates a texture from pixels built at runtime
+         *
+         * @param name texture name, used as cache key by the asset managers
+         * @param width width in pixels
+         * @param height height in pixels
+         * @param pixels RGBA8 pixels, rows from top to bottom, copied
+         */
+        Texture(const AssetName &name, std::size_t width, std::size_t height, const void *pixels);
         ~Texture();
 
         Texture(Texture &o)            = delete;
@@ -43,6 +52,10 @@ namespace core::assets
         const std::string &name() const noexcept;
         /** @brief Returns the size of texture in bytes */
         std::size_t size() const noexcept;
+        /** @brief Returns the width in pixels */
+        std::size_t width() const noexcept;
+        /** @brief Returns the height in pixels */
+        std::size_t height() const noexcept;
         /** @brief Returns the internal pointer */
         const Internal &getInternal() const noexcept;
 
@@ -3,10 +3,12 @@
 #include <vector>
 #include <string>
 
+#include "asset-inventory.hpp"
 #include "../utils/logging.hpp"
 
 namespace core::assets::utils
 {
-    std::vector<char> loadBinaryFile(const std::string &filename);
+    /** @brief Opens @p filename through the AssetInventory without copying it */
+    AssetSpan loadBinaryFile(const std::string &filename);
 
 }
\ No newline at end of file
@@ -34,10 +34,11 @@ protected:
 public:
 
     ~InputComponent();
-    InputComponent(InputComponent &o)             = delete;
-    InputComponent &operator=(InputComponent &o)  = delete;
-    InputComponent(InputComponent &&o)            = default;
-    InputComponent &operator=(InputComponent &&o) = default;
+    InputComponent(InputComponent &o)            = delete;
+    InputComponent &operator=(InputComponent &o) = delete;
+    /** Moving re-registers listeners with InputManager under the new address */
+    InputComponent(InputComponent &&o);
+    InputComponent &operator=(InputComponent &&o);
 
     /** Component overrides */
     // void awake() override;
@@ -46,6 +47,13 @@ public:
     // void update(time_ms delta) override;
     // void clean() override;
 
+    /**
+     * @brief Sets the listener for @p event, replacing any previous listener.
+     * InputManager only dispatches @p event to components subscribed to it.
+     *
+     * @param event input event type
+     * @param callback listener called for each event of type @p event
+     */
     void setListener(const InputEventType event, const Listener &callback);
 
     friend Entity;
@@ -13,6 +13,7 @@
 #include "../../graphics/renderer.hpp"
 
 #include <bitset>
+#include <cstdint>
 
 constexpr std::size_t maxRenderMaskBits = 32;
 constexpr std::size_t defaultRenderMask = 0x0001;
@@ -44,11 +45,12 @@ protected:
     {
     }
 public:
-    RenderMask m_renderMask{defaultRenderMask};
-    glm::mat4  m_modelMatrix;
-    AssetID    m_meshID;
-    AssetID    m_textureID;
-    AssetID    m_pipelineID;
+    RenderMask   m_renderMask{defaultRenderMask};
+    std::uint8_t m_renderLayer = 0; /** draw order, lower layers are drawn first */
+    glm::mat4    m_modelMatrix;
+    AssetID      m_meshID;
+    AssetID      m_textureID;
+    AssetID      m_pipelineID;
 
     ~RenderComponent();
     RenderComponent(RenderComponent &o)             = delete;
@@ -66,6 +68,10 @@ public:
     void        setRenderMask(RenderMask renderMask) { m_renderMask = renderMask; }
     RenderMask &getRenderMask() { return m_renderMask; };
 
+    /** Set render layer, meshes only use the lower 4 bits */
+    void         setRenderLayer(std::uint8_t layer) noexcept { m_renderLayer = layer; }
+    std::uint8_t getRenderLayer() const noexcept { return m_renderLayer; }
+
     void setMeshID(const AssetID id) noexcept { m_meshID = id; }
     void setTextureID(const AssetID id) noexcept { m_textureID = id; }
     void setPipelineID(const AssetID id) noexcept { m_pipelineID = id; }
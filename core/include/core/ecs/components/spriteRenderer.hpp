@@ -14,17 +14,26 @@
 
 #include <memory>
 
+class SpriteAtlas;
+
 /**
  * @brief The SpriteRenderer allows rendering 2D sprites
  *
+ * Sprites are drawn as unit quads (0,0)-(1,1) transformed by the entity's model
+ * matrix and batched by pipeline and texture, the mesh ID is not used. Custom
+ * pipelines must take world space a_v, a_vt and a_c attributes like the
+ * default "sprite" pipeline.
  */
 class SpriteRenderer : public RenderComponent
 {
 private:
+    AssetName                                  m_sprite;                         /** texture asset of loadSprite */
     bool                                       usingSpriteSheet = false;
     std::shared_ptr<core::assets::SpriteSheet> spriteSheet;
     std::size_t                                activeFrameNumber;
     core::assets::SpriteSheet::Frame           activeFrame;
+    glm::vec4                                  m_uvRect{0.0f, 0.0f, 1.0f, 1.0f}; /** u0, v0, u1, v1 */
+    glm::vec4                                  m_color{1.0f};                    /** tint multiplied with the texture */
 protected:
     SpriteRenderer();
     SpriteRenderer(AssetID meshID, AssetID textureID, AssetID pipelineID);
@@ -36,9 +45,23 @@ public:
     SpriteRenderer &operator=(SpriteRenderer &&o) = default;
 
     void loadSprite(const AssetName &sprite);
+    /**
+     * @brief Shows @p sprite from its page in @p atlas, or loads it on its own
+     * if it isn't packed yet. The atlas remaps the sprite once it is packed.
+     */
+    void loadSprite(const SpriteAtlas &atlas, const AssetName &sprite);
     void loadSpriteSheet(const AssetName &sprite);
     void setSpriteTag(const std::string &tagName, std::size_t frameNumber = 0);
 
+    /** @brief Sets the region of the texture drawn on the sprite, in normalized (u0, v0, u1, v1) */
+    void setUVRect(const glm::vec4 &uvRect) noexcept { m_uvRect = uvRect; }
+    /** @brief Sets the color multiplied with the sprite's texture */
+    void setColor(const glm::vec4 &color) noexcept { m_color = color; }
+
+    const AssetName &getSpriteName() const noexcept { return m_sprite; }
+    const glm::vec4 &getUVRect() const noexcept { return m_uvRect; }
+    const glm::vec4 &getColor() const noexcept { return m_color; }
+
     /** Component overrides */
     // void awake() override;
     // void init() override
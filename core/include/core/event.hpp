@@ -1,31 +1,343 @@
 #pragma once
 
+/**
+ * @file core/event.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @defgroup Event
+ * @brief Typed event bus
+ * @{
+ */
+
+#include "utils/hash.hpp"
+#include "utils/queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
-#include <map>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
-using EventType = std::size_t;
+/** Identifier of an event type, see @ref getEventTypeID */
+using EventTypeID = std::uint64_t;
+/** Identifier of a subscribed handler, used to unsubscribe */
+using EventHandlerID = std::uint32_t;
 
-class EventHandler
+/**
+ * @brief Returns the compile-time identifier for event type @p T
+ *
+ * @tparam T event type
+ * @return constexpr EventTypeID identifier of @p T
+ */
+template <typename T>
+constexpr EventTypeID getEventTypeID() noexcept
 {
-public:
-    virtual void onEvent(const EventType &ev) {}
+    return core::utils::type_hash<std::decay_t<T>>();
+}
+
+/**
+ * @brief Points in the game loop where event handlers are invoked
+ */
+enum class EventPhase : std::uint8_t
+{
+    PreUpdate = 0, /** after managers have grabbed their input */
+    Update,        /** after entity updates */
+    PostUpdate,    /** after entity post updates */
+    PostRender,    /** after the frame was presented */
+    Count
 };
 
+/**
+ * @brief Contiguous batch of events handed to handlers
+ *
+ * @tparam T event type
+ */
+template <typename T>
+struct EventBatch
+{
+    const T    *data;
+    std::size_t size;
+
+    const T *begin() const noexcept { return data; }
+    const T *end() const noexcept { return data + size; }
+    bool     empty() const noexcept { return size == 0; }
+};
+
+/**
+ * @brief Typed event bus
+ *
+ * Events are POD payloads posted into per-type buffers that live for one frame.
+ * Each event type is dispatched at one @ref EventPhase, where every handler of the
+ * type is called once with the whole batch. Posting from the thread that called
+ * @ref init appends directly to the buffer; posting from any other thread goes
+ * through a lock-free queue that is drained at the start of each dispatch.
+ *
+ * Buffers keep their capacity between frames, so steady-state posting does not
+ * allocate.
+ *
+ * @todo: handler ordering/priority within a phase
+ */
 class EventManager
 {
+public:
+    /** Maximum size of events posted from other threads */
+    static constexpr std::size_t deferredPayloadSize = 64;
+
 private:
-    std::map<EventType, std::vector<EventHandler>> m_eventListeners;
+    struct ChannelBase
+    {
+        EventPhase phase = EventPhase::Update;
+
+        virtual ~ChannelBase() = default;
+        virtual void dispatch() = 0;
+        virtual bool unsubscribe(EventHandlerID id) = 0;
+    };
+
+    template <typename T>
+    struct Channel : public ChannelBase
+    {
+        struct Handler
+        {
+            EventHandlerID                             id;
+            std::function<void(const EventBatch<T> &)> fn;
+            bool                                       active = true;
+        };
+
+        std::vector<T>       events;      /** events posted for the next dispatch */
+        std::vector<T>       dispatching; /** events being handed out, swapped with events */
+        std::vector<Handler> handlers;
+        std::vector<Handler> added;       /** subscribed during dispatch, joins handlers after it */
+        bool                 inDispatch = false;
+        bool                 removed    = false; /** a handler was unsubscribed during dispatch */
+
+        void subscribe(Handler handler)
+        {
+            // handlers can't grow while one of them is running, it may reallocate
+            if (inDispatch)
+                added.push_back(std::move(handler));
+            else
+                handlers.push_back(std::move(handler));
+        }
+
+        void dispatch() override
+        {
+            if (events.empty()) return;
+            // handlers may post more events of the same type, they go to the next dispatch
+            std::swap(events, dispatching);
+            const EventBatch<T> batch{dispatching.data(), dispatching.size()};
+            inDispatch = true;
+            for (std::size_t i = 0; i < handlers.size(); i++)
+                if (handlers[i].active) handlers[i].fn(batch);
+            inDispatch = false;
+            dispatching.clear();
+
+            if (removed)
+            {
+                handlers.erase(std::remove_if(handlers.begin(),
+                                              handlers.end(),
+                                              [](const Handler &h) { return !h.active; }),
+                               handlers.end());
+                removed = false;
+            }
+            for (auto &handler : added) handlers.push_back(std::move(handler));
+            added.clear();
+        }
+
+        bool unsubscribe(EventHandlerID id) override
+        {
+            auto match = [id](const Handler &h) { return h.id == id && h.active; };
+            auto it    = std::find_if(handlers.begin(), handlers.end(), match);
+            if (it != handlers.end())
+            {
+                // erasing during dispatch would skip the next handler or destroy the running
+                // one, it's removed once dispatch ends
+                if (inDispatch)
+                {
+                    it->active = false;
+                    removed    = true;
+                }
+                else
+                    handlers.erase(it);
+                return true;
+            }
+
+            it = std::find_if(added.begin(), added.end(), match);
+            if (it == added.end()) return false;
+            added.erase(it);
+            return true;
+        }
+    };
+
+    /** Event posted from another thread, copied into a fixed-size record */
+    struct DeferredEvent
+    {
+        void (*append)(EventManager &, const void *) = nullptr;
+        alignas(std::max_align_t) unsigned char data[deferredPayloadSize];
+    };
+
+    std::unordered_map<EventTypeID, std::unique_ptr<ChannelBase>> m_channels;
+    std::vector<ChannelBase *> m_phaseChannels[static_cast<std::size_t>(EventPhase::Count)];
+    core::utils::atomic_queue<DeferredEvent> m_deferred;
+    std::atomic<std::size_t>                 m_deferredDropped{0}; /** since the last dispatch */
+    std::size_t                              m_droppedTotal = 0;
+    std::thread::id                          m_ownerThread;
+    EventHandlerID                           m_nextHandlerID = 1;
+
+    template <typename T>
+    Channel<T> &getChannel()
+    {
+        auto it = m_channels.find(getEventTypeID<T>());
+        if (it != m_channels.end()) return static_cast<Channel<T> &>(*it->second);
+
+        auto  channel = std::make_unique<Channel<T>>();
+        auto &ref     = *channel;
+        m_phaseChannels[static_cast<std::size_t>(ref.phase)].push_back(&ref);
+        m_channels.emplace(getEventTypeID<T>(), std::move(channel));
+        return ref;
+    }
+
+    template <typename T>
+    static void appendDeferred(EventManager &manager, const void *data)
+    {
+        manager.getChannel<T>().events.push_back(*static_cast<const T *>(data));
+    }
+
+    /** Moves events posted from other threads into their buffers */
+    void drainDeferred();
 
 protected:
 public:
-    EventManager() {}
+    EventManager();
+    ~EventManager();
+    EventManager(EventManager &o)             = delete;
+    EventManager(EventManager &&o)            = delete;
+    EventManager &operator=(EventManager &o)  = delete;
+    EventManager &operator=(EventManager &&o) = delete;
+
+    /** Initialize EventManager, the calling thread becomes the owner thread */
+    void init();
 
-    void addListener(const EventType &evType, const EventHandler &eventHandler)
+    /**
+     * @brief Sets the loop phase where events of type @p T are dispatched.
+     * Types that are never registered are dispatched at EventPhase::Update.
+     *
+     * @tparam T event type
+     * @param phase phase to dispatch at
+     */
+    template <typename T>
+    void registerEvent(EventPhase phase)
     {
-        m_eventListeners[evType].push_back(eventHandler);
+        auto &channel = getChannel<T>();
+        if (channel.phase == phase) return;
+
+        auto &from = m_phaseChannels[static_cast<std::size_t>(channel.phase)];
+        from.erase(std::remove(from.begin(), from.end(), &channel), from.end());
+        m_phaseChannels[static_cast<std::size_t>(phase)].push_back(&channel);
+        channel.phase = phase;
+    }
+
+    /**
+     * @brief Subscribes @p handler to events of type @p T. Must be called from the
+     * owner thread.
+     *
+     * @tparam T event type
+     * @tparam F callable with signature void(const EventBatch<T> &)
+     * @param handler handler called once per dispatch with all events of the frame
+     * @return EventHandlerID id used to unsubscribe
+     */
+    template <typename T, typename F>
+    EventHandlerID subscribe(F &&handler)
+    {
+        EventHandlerID id = m_nextHandlerID++;
+        getChannel<T>().subscribe({id, std::forward<F>(handler)});
+        return id;
     }
 
-    void init() {}
-};
\ No newline at end of file
+    /**
+     * @brief Removes handler with @p id. Must be called from the owner thread.
+     * Handlers may unsubscribe themselves or others while they are called, the
+     * removed handlers are not called again.
+     *
+     * @param id id returned by @ref subscribe
+     */
+    void unsubscribe(EventHandlerID id);
+
+    /**
+     * @brief Posts event @p e. Events posted from threads other than the owner thread
+     * are forwarded to @ref postDeferred.
+     *
+     * @tparam T event type
+     * @param e event to post
+     * @return true if the event was queued
+     * @return false if the cross-thread queue was full
+     */
+    template <typename T>
+    bool post(const T &e)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "events must be trivially copyable");
+        if (std::this_thread::get_id() != m_ownerThread) return postDeferred(e);
+        getChannel<T>().events.push_back(e);
+        return true;
+    }
+
+    /**
+     * @brief Posts event @p e through the lock-free queue. Safe to call from any thread,
+     * the event becomes visible at the next dispatch on the owner thread.
+     *
+     * @tparam T event type, at most @ref deferredPayloadSize bytes
+     * @param e event to post
+     * @return true if the event was queued
+     * @return false if the queue was full, the event is dropped and counted in
+     * @ref droppedCount
+     */
+    template <typename T>
+    bool postDeferred(const T &e)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "events must be trivially copyable");
+        static_assert(sizeof(T) <= deferredPayloadSize, "event too large to post across threads");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "event alignment not supported");
+
+        DeferredEvent d;
+        d.append = &EventManager::appendDeferred<T>;
+        std::memcpy(d.data, &e, sizeof(T));
+        if (m_deferred.try_push(std::move(d))) return true;
+        m_deferredDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief Retrieves the number of events dropped because the cross-thread queue
+     * was full, counted at each dispatch. Must be called from the owner thread.
+     */
+    std::size_t droppedCount() const noexcept { return m_droppedTotal; }
+
+    /**
+     * @brief Invokes the handlers of every event type registered to @p phase.
+     * Must be called from the owner thread.
+     *
+     * @param phase current loop phase
+     */
+    void dispatch(EventPhase phase);
+
+    /**
+     * @brief Retrieves the number of events of type @p T waiting for dispatch
+     *
+     * @tparam T event type
+     * @return std::size_t count of pending events
+     */
+    template <typename T>
+    std::size_t pendingCount() const
+    {
+        auto it = m_channels.find(getEventTypeID<T>());
+        if (it == m_channels.end()) return 0;
+        return static_cast<const Channel<T> &>(*it->second).events.size();
+    }
+};
+
+/** @} endgroup Event */
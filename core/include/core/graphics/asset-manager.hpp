@@ -12,6 +12,7 @@
 #include "../assets/mesh.hpp"
 #include "../assets/texture.hpp"
 #include "../assets/shader.hpp"
+#include "culling.hpp"
 
 using AssetID = std::intmax_t;
 
@@ -37,6 +38,29 @@ public:
     virtual AssetID loadMesh(const core::assets::Mesh &mesh) = 0;
     virtual AssetID loadTexture(const core::assets::Texture &texture) = 0;
     virtual AssetID loadPipeline(const core::assets::Shader &shader) = 0;
+
+    /**
+     * @brief Loads texture @p name without waiting for it to be decoded. The ID
+     * is valid right away and shows a placeholder until the image is uploaded.
+     * Loads synchronously unless the implementation streams textures.
+     */
+    virtual AssetID loadTextureAsync(const AssetName &name) { return loadAsset(AssetType::Texture, name); }
+
+    /**
+     * @brief Replaces the pixels of texture @p id, the ID stays valid. Used for
+     * textures built at runtime like sprite atlas pages.
+     */
+    virtual void updateTexture(AssetID id, const core::assets::Texture &texture) = 0;
+
+    /**
+     * @brief Replaces the pixels of a region of texture @p id with @p region,
+     * its top-left corner at (@p x, @p y) counted from the top row. The region
+     * must fit in the current image of the texture.
+     */
+    virtual void updateTextureRegion(AssetID id, const core::assets::Texture &region, std::size_t x, std::size_t y) = 0;
+
+    /** @brief Retrieves the model space bounds of mesh @p id */
+    virtual const MeshBounds &getMeshBounds(AssetID id) const = 0;
 };
 
 /** @} endgroup Renderer */
@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file core/graphics/culling.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Renderer
+ * @{
+ */
+
+#include "vertex.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Axis aligned box and bounding sphere of a mesh in model space
+ */
+struct MeshBounds
+{
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+    glm::vec3 center{0.0f}; /** sphere center, center of the box */
+    float     radius = 0.0f;
+
+    /** @brief Computes the bounds of @p count vertices */
+    static MeshBounds fromVertices(const Vertex *vertices, std::size_t count) noexcept;
+
+    /**
+     * @brief Transforms the bounding sphere by @p model
+     * The radius is scaled by the largest axis scale so the sphere stays conservative.
+     */
+    void transformSphere(const glm::mat4 &model, glm::vec3 &worldCenter, float &worldRadius) const noexcept;
+};
+
+/**
+ * @brief Frustum planes extracted from a projection * view matrix
+ * Planes point inwards and are normalized, order: left, right, bottom, top, near, far.
+ */
+struct Frustum
+{
+    std::array<glm::vec4, 6> planes;
+
+    static Frustum fromMatrix(const glm::mat4 &viewProjection) noexcept;
+};
+
+/**
+ * @brief Bounding spheres in structure-of-arrays layout for batch culling
+ *
+ * @ref cull tests 4 spheres per iteration with SSE when available.
+ */
+class CullBatch
+{
+private:
+    std::vector<float> m_x, m_y, m_z, m_r;
+
+    void cullFrustum(const glm::mat4 &viewProjection, std::vector<std::uint32_t> &visible) const;
+    void cullOrthographic(const glm::mat4 &viewProjection, std::vector<std::uint32_t> &visible) const;
+
+protected:
+public:
+    void clear();
+    void reserve(std::size_t count);
+
+    /** @brief Adds a world space sphere, its index is the position it was pushed at */
+    void push(const glm::vec3 &center, float radius);
+
+    std::size_t size() const noexcept { return m_x.size(); }
+
+    /**
+     * @brief Writes the indices of the spheres intersecting the view volume to @p visible
+     *
+     * @param viewProjection projection * view of the camera
+     * @param orthographic the projection is affine, uses the clip-space box test
+     * instead of the 6 frustum planes
+     * @param visible cleared and filled with indices in ascending order
+     */
+    void cull(const glm::mat4 &viewProjection, bool orthographic, std::vector<std::uint32_t> &visible) const;
+};
+
+/** @} endgroup Renderer */
@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * @file core/graphics/framePacket.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Renderer
+ * @{
+ */
+
+#include "asset-manager.hpp"
+#include "culling.hpp"
+#include "renderQueue.hpp"
+#include "renderer.hpp"
+#include "../ecs/components/renderComponent.hpp"
+#include "../ui/text/textBatch.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Copy of everything the renderer needs to draw one frame
+ *
+ * Filled from the components by @ref extract on the simulation thread, then
+ * drawn without touching any component, so the renderer may consume it on
+ * another thread while the next frame is simulated.
+ */
+struct FramePacket
+{
+    struct Camera
+    {
+        glm::mat4  view;
+        glm::mat4  projection;
+        bool       orthographic;
+        RenderMask renderMask;
+    };
+
+    struct Mesh
+    {
+        glm::mat4    model;
+        AssetID      pipeline;
+        AssetID      texture;
+        AssetID      mesh;
+        std::uint8_t layer;
+        RenderMask   renderMask;
+    };
+
+    struct Sprite
+    {
+        glm::mat4    model;
+        glm::vec4    uvRect;
+        glm::vec4    color;
+        AssetID      pipeline;
+        AssetID      texture;
+        std::uint8_t layer;
+        RenderMask   renderMask;
+    };
+
+    /** Prebuilt text, shared with the TextBatch until it rebuilds */
+    struct Text
+    {
+        std::shared_ptr<const core::ui::TextBatch::Mesh> mesh;
+        AssetID                                          pipeline;
+        RenderMask                                       renderMask;
+    };
+
+    std::uint64_t       frame = 0;
+    std::vector<Camera> cameras;
+    std::vector<Mesh>   meshes;
+    std::vector<Sprite> sprites;
+    std::vector<Text>   texts;
+
+    /** @brief Clears the packet, capacity is kept */
+    void clear();
+
+    /**
+     * @brief Copies cameras and renderables from the ComponentManager and the
+     * text batches of the UIManager. Renderables with an empty render mask are
+     * skipped.
+     *
+     * @param frame frame number stored in the packet
+     */
+    void extract(std::uint64_t frame);
+};
+
+/**
+ * @brief Checks if a renderable with @p mask is drawn by @p camera
+ */
+inline bool isVisibleTo(const FramePacket::Camera &camera, const RenderMask &mask)
+{
+    return mask.any() && (mask & camera.renderMask) == mask;
+}
+
+/**
+ * @brief Culls the renderables of a packet against one camera at a time
+ *
+ * Shared by the renderer backends so they agree on what is drawn. Storage is
+ * kept between calls to avoid reallocating each frame.
+ */
+class FrameCulling
+{
+private:
+    CullBatch                  m_spheres;
+    std::vector<std::uint32_t> m_visible;
+    std::vector<std::size_t>   m_candidates; /** packet index of each sphere */
+    std::vector<std::size_t>   m_indices;
+
+    const std::vector<std::size_t> &cull(const FramePacket::Camera &camera, RendererStats &stats);
+
+protected:
+public:
+    /**
+     * @brief Culls @p sprites, unit quads spanning [0, 1] in model space
+     *
+     * @return packet indices of the visible sprites, ascending
+     */
+    const std::vector<std::size_t> &sprites(const FramePacket::Camera              &camera,
+                                            const std::vector<FramePacket::Sprite> &sprites,
+                                            RendererStats                          &stats);
+
+    /**
+     * @brief Culls @p meshes with their bounds from @p am
+     *
+     * @return packet indices of the visible meshes, ascending
+     */
+    const std::vector<std::size_t> &meshes(const AssetManager                   &am,
+                                           const FramePacket::Camera            &camera,
+                                           const std::vector<FramePacket::Mesh> &meshes,
+                                           RendererStats                        &stats);
+};
+
+/**
+ * @brief Fills @p queue with the meshes at @p indices, depth sorted for @p camera
+ *
+ * @param queue cleared, then sorted
+ * @param camera camera the meshes are seen from
+ * @param meshes meshes of the packet
+ * @param indices visible meshes, see FrameCulling::meshes
+ */
+void queueMeshes(RenderQueue                          &queue,
+                 const FramePacket::Camera            &camera,
+                 const std::vector<FramePacket::Mesh> &meshes,
+                 const std::vector<std::size_t>       &indices);
+
+/** @} endgroup Renderer */
@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * @file core/graphics/renderQueue.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Renderer
+ * @{
+ */
+
+#include "asset-manager.hpp"
+#include "renderer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 64-bit sort key of a draw, most significant field first:
+ *
+ *  | layer (4) | pipeline (12) | texture (16) | mesh (12) | depth (20) |
+ *
+ * Sorting by key groups draws by layer, then by the most expensive state to
+ * change. Depth sorts front to back within identical state.
+ */
+namespace RenderKey
+{
+    constexpr unsigned depthBits    = 20;
+    constexpr unsigned meshBits     = 12;
+    constexpr unsigned textureBits  = 16;
+    constexpr unsigned pipelineBits = 12;
+    constexpr unsigned layerBits    = 4;
+
+    constexpr unsigned depthShift    = 0;
+    constexpr unsigned meshShift     = depthShift + depthBits;
+    constexpr unsigned textureShift  = meshShift + meshBits;
+    constexpr unsigned pipelineShift = textureShift + textureBits;
+    constexpr unsigned layerShift    = pipelineShift + pipelineBits;
+    static_assert(layerShift + layerBits == 64, "render key must fill 64 bits");
+
+    constexpr std::uint64_t field(std::uint64_t value, unsigned bits, unsigned shift)
+    {
+        return (value & ((std::uint64_t(1) << bits) - 1)) << shift;
+    }
+
+    /**
+     * @brief Quantizes a view distance to @ref depthBits
+     * Positive IEEE floats compare like integers, so the top bits of the float keep
+     * the ordering without knowing the camera's clipping planes.
+     */
+    std::uint32_t quantizeDepth(float viewDepth) noexcept;
+
+    /** @brief Packs the fields of a draw into a sort key */
+    constexpr std::uint64_t make(std::uint8_t  layer,
+                                 AssetID       pipeline,
+                                 AssetID       texture,
+                                 AssetID       mesh,
+                                 std::uint32_t depth)
+    {
+        return field(layer, layerBits, layerShift) | field(pipeline, pipelineBits, pipelineShift)
+             | field(texture, textureBits, textureShift) | field(mesh, meshBits, meshShift)
+             | field(depth, depthBits, depthShift);
+    }
+} // namespace RenderKey
+
+/**
+ * @brief Single draw emitted to the render queue
+ */
+struct DrawCommand
+{
+    AssetID   pipeline;
+    AssetID   texture;
+    AssetID   mesh;
+    glm::mat4 model;
+};
+
+/**
+ * @brief Collects draws for a frame, radix sorts them by @ref RenderKey and
+ * replays them on a backend with redundant binds removed.
+ *
+ * The backend is any type providing:
+ *  - void bindPipeline(const DrawCommand &)
+ *  - void bindTexture(const DrawCommand &)
+ *  - void bindMesh(const DrawCommand &)
+ *  - void draw(const DrawCommand &)
+ *  - bool drawInstanced(const DrawCommand *const *commands, std::size_t count)
+ *    returns false if it fell back to one draw per command
+ *
+ * State changes are detected on the asset IDs of consecutive draws, the key
+ * only decides the order, so IDs wider than their key field still bind
+ * correctly. Consecutive draws sharing pipeline, texture and mesh are handed to
+ * drawInstanced as one run.
+ */
+class RenderQueue
+{
+private:
+    struct Entry
+    {
+        std::uint64_t key;
+        std::uint32_t index; /** into m_commands */
+    };
+
+    std::vector<DrawCommand>         m_commands;
+    std::vector<Entry>               m_entries;
+    std::vector<Entry>               m_scratch;
+    std::vector<const DrawCommand *> m_run; /** draws of the current instanced run */
+
+protected:
+public:
+    RenderQueue();
+    ~RenderQueue();
+
+    /** @brief Removes all draws, keeps capacity */
+    void clear();
+
+    /**
+     * @brief Adds a draw to the queue
+     *
+     * @param command draw to emit
+     * @param layer coarse ordering, lower layers draw first
+     * @param viewDepth distance from the camera, used for front to back order
+     */
+    void push(const DrawCommand &command, std::uint8_t layer, float viewDepth);
+
+    /** @brief LSD radix sort of the queued draws, byte passes with a single bucket are skipped */
+    void sort();
+
+    std::size_t size() const noexcept { return m_entries.size(); }
+    std::uint64_t key(std::size_t i) const noexcept { return m_entries[i].key; }
+    const DrawCommand &command(std::size_t i) const noexcept { return m_commands[m_entries[i].index]; }
+
+    /**
+     * @brief Replays the sorted draws on @p backend, only binding state that changed
+     *
+     * @param backend render backend
+     * @param stats bind counters to update
+     */
+    template <typename Backend>
+    void submit(Backend &backend, RendererStats &stats)
+    {
+        const DrawCommand *last  = nullptr;
+        const std::size_t  count = m_entries.size();
+        for (std::size_t i = 0; i < count;)
+        {
+            const DrawCommand &cmd = m_commands[m_entries[i].index];
+
+            if (!last || last->pipeline != cmd.pipeline)
+            {
+                backend.bindPipeline(cmd);
+                stats.pipelineBinds++;
+            }
+            else
+                stats.bindsAvoided++;
+
+            if (!last || last->texture != cmd.texture)
+            {
+                backend.bindTexture(cmd);
+                stats.textureBinds++;
+            }
+            else
+                stats.bindsAvoided++;
+
+            if (!last || last->mesh != cmd.mesh)
+            {
+                backend.bindMesh(cmd);
+                stats.meshBinds++;
+            }
+            else
+                stats.bindsAvoided++;
+
+            /** extend the run while the state matches */
+            std::size_t end = i + 1;
+            while (end < count && sameState(cmd, m_commands[m_entries[end].index]))
+                end++;
+
+            if (end - i > 1)
+            {
+                m_run.clear();
+                for (std::size_t j = i; j < end; j++)
+                    m_run.push_back(&m_commands[m_entries[j].index]);
+                stats.bindsAvoided += 3 * (m_run.size() - 1);
+                if (backend.drawInstanced(m_run.data(), m_run.size()))
+                {
+                    stats.instancedDraws++;
+                    stats.instances += m_run.size();
+                    stats.drawCalls++;
+                }
+                else
+                    stats.drawCalls += m_run.size();
+            }
+            else
+            {
+                backend.draw(cmd);
+                stats.drawCalls++;
+            }
+
+            last = &m_commands[m_entries[end - 1].index];
+            i    = end;
+        }
+    }
+
+    static bool sameState(const DrawCommand &a, const DrawCommand &b) noexcept
+    {
+        return a.pipeline == b.pipeline && a.texture == b.texture && a.mesh == b.mesh;
+    }
+};
+
+/** @} endgroup Renderer */
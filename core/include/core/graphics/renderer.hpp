@@ -14,6 +14,100 @@
 #include "asset-manager.hpp"
 #include "../time.hpp"
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Per-frame counters filled by renderer implementations
+ *
+ */
+struct RendererStats
+{
+    std::size_t drawCalls           = 0; /** draw calls issued */
+    std::size_t spriteCount         = 0; /** sprites submitted to the sprite batcher */
+    std::size_t spriteBatches       = 0; /** sprite draw calls, one per pipeline/texture run */
+    std::size_t textQuads           = 0; /** glyph quads drawn from text meshes */
+    std::size_t streamedBytes       = 0; /** vertex data uploaded to streaming buffers */
+    std::size_t texturesStreamed    = 0; /** textures swapped in by background loads */
+    std::size_t textureBytes        = 0; /** pixels uploaded by background loads */
+    std::size_t pipelineBinds       = 0; /** pipeline changes issued by the render queue */
+    std::size_t textureBinds        = 0; /** texture changes issued by the render queue */
+    std::size_t meshBinds           = 0; /** mesh buffer changes issued by the render queue */
+    std::size_t bindsAvoided        = 0; /** binds skipped because the state didn't change */
+    std::size_t instancedDraws      = 0; /** instanced draw calls */
+    std::size_t instances           = 0; /** instances drawn by instanced draw calls */
+    std::size_t visible             = 0; /** renderables that passed culling, summed over cameras */
+    std::size_t culled              = 0; /** renderables outside the camera's view volume */
+    std::size_t stateChanges        = 0; /** GL state changes passed to the driver */
+    std::size_t stateChangesSkipped = 0; /** GL state changes filtered as redundant */
+
+    void reset() { *this = RendererStats(); }
+};
+
+/**
+ * @brief Per-frame timings of the render pipeline, in milliseconds
+ *
+ * Extract and wait are spent on the simulation thread, submit and present on
+ * the thread owning the graphics context. Without a render thread all of them
+ * add up on the simulation thread.
+ */
+struct RenderTimings
+{
+    float       extractMs      = 0.0f; /** copying renderables into the frame packet */
+    float       waitMs         = 0.0f; /** waiting for a free frame packet */
+    float       submitMs       = 0.0f; /** culling and issuing draws of the packet */
+    float       presentMs      = 0.0f; /** swapping buffers */
+    std::size_t framesInFlight = 1;    /** frames the simulation may run ahead of presentation */
+};
+
+/**
+ * @brief Frames handed over and presented by a renderer
+ *
+ * Frames are numbered from 0 in submission order. The renderer publishes each
+ * presented frame after the buffer swap, on the render thread if there is one,
+ * so readers on other threads see when a frame actually reached the screen.
+ */
+class FramePresentation
+{
+public:
+    /** Present times are kept for this many frames */
+    static constexpr std::size_t history = 8;
+
+private:
+    std::uint64_t                                  m_submitted = 0;
+    std::atomic<std::uint64_t>                     m_presented{0};
+    std::array<std::atomic<std::int64_t>, history> m_times{}; /** present time (us) by frame number */
+
+public:
+    /** @brief Counts a frame handed over in renderEnd, on the simulation thread */
+    void submitted() { m_submitted++; }
+
+    /** @brief Publishes that the next frame was presented at @p time, right after the swap */
+    void presented(time_us time)
+    {
+        std::uint64_t frame = m_presented.load(std::memory_order_relaxed);
+        m_times[frame % history].store(time.count(), std::memory_order_relaxed);
+        m_presented.store(frame + 1, std::memory_order_release);
+    }
+
+    /** @brief Frames handed over so far, the last one has the number framesSubmitted() - 1 */
+    std::uint64_t framesSubmitted() const noexcept { return m_submitted; }
+
+    /** @brief Frames presented so far, frame n was presented once this is above n */
+    std::uint64_t framesPresented() const noexcept { return m_presented.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Time frame @p frame was presented, only valid for the last
+     * @ref history frames below @ref framesPresented
+     */
+    time_us presentTime(std::uint64_t frame) const noexcept
+    {
+        return time_us(m_times[frame % history].load(std::memory_order_relaxed));
+    }
+};
+
 /**
  * @brief Base class for renderer implementations
  *
@@ -22,10 +116,23 @@ class Renderer
 {
 private:
     std::string m_rendererName;
+    /** on the heap, the render thread keeps a reference across moves of the renderer */
+    std::unique_ptr<FramePresentation> m_presentation = std::make_unique<FramePresentation>();
+
 protected:
+    /** Counters for the frame being rendered, reset on renderBegin */
+    RendererStats m_stats;
+    /** Timings of the last rendered frame */
+    RenderTimings m_timings;
+
+    /** Implementations count submitted frames and publish presented ones here */
+    FramePresentation &framePresentation() { return *m_presentation; }
+
 public:
     Renderer(const std::string &rendererName) : m_rendererName(rendererName) {}
     virtual ~Renderer() = default;
+    Renderer(Renderer &&o)            = default;
+    Renderer &operator=(Renderer &&o) = default;
 
     virtual void init()                      = 0;
     virtual void update(const time_ms delta) = 0;
@@ -39,6 +146,13 @@ public:
     virtual AssetManager &getAssetManager() = 0;
 
     const std::string      &rendererName() { return m_rendererName; }
+    /** @brief Counters of the last rendered frame */
+    const RendererStats    &stats() const { return m_stats; }
+    /** @brief Timings of the last rendered frame */
+    const RenderTimings    &timings() const { return m_timings; }
+
+    /** @brief Frames submitted and presented, safe to read from any thread */
+    const FramePresentation &presentation() const { return *m_presentation; }
 };
 
 /** @} endgroup Renderer */
\ No newline at end of file
@@ -14,12 +14,18 @@
 #include "gl-texture.hpp"
 #include "gl-mesh.hpp"
 
+#include <functional>
+
 /**
  * @brief OpenGL implementation of the AssetManager
  * 
  */
 class OpenGLAssetManager : public AssetManager
 {
+public:
+    /** Runs the given load on the thread owning the GL context and returns once it is done */
+    typedef std::function<void(const std::function<void()> &)> Executor;
+
 private:
     struct Internal;
     std::unique_ptr<Internal> m_internal;
@@ -34,10 +40,44 @@ public:
     AssetID loadMesh(const core::assets::Mesh &mesh) override;
     AssetID loadTexture(const core::assets::Texture &texture) override;
     AssetID loadPipeline(const core::assets::Shader &shader) override;
+    AssetID loadTextureAsync(const AssetName &name) override;
+    void    updateTexture(AssetID id, const core::assets::Texture &texture) override;
+    void    updateTextureRegion(AssetID id, const core::assets::Texture &region, std::size_t x, std::size_t y) override;
+
+    const MeshBounds &getMeshBounds(AssetID id) const override;
 
     OpenGLMesh     &getMesh(AssetID id) const;
     OpenGLPipeline &getPipeline(AssetID id) const;
     OpenGLTexture  &getTexture(AssetID id) const;
+
+    /**
+     * @brief Retrieves the instanced variant of @p pipeline. The variant is loaded
+     * from the "<name>_instanced" shader together with the pipeline, so this never
+     * loads and is safe to call while drawing.
+     *
+     * @param pipeline pipeline asset
+     * @return AssetID instanced pipeline, or -1 if there is no instanced variant or
+     * the context can't draw instanced
+     */
+    AssetID getInstancedPipeline(AssetID pipeline) const;
+
+    /**
+     * @brief Uploads the textures of @ref loadTextureAsync that finished decoding,
+     * up to CONFIG_CORE_TEXTURE_UPLOAD_BUDGET bytes. Called by the renderer at
+     * the start of every frame, on the thread owning the context.
+     */
+    void streamTextures(RendererStats &stats);
+
+    /**
+     * @brief Sets where loads run. Loads create GL objects, so when the context
+     * is current on another thread the renderer marshals them there. Loads run
+     * inline if no executor is set. Assets already cached are returned on the
+     * calling thread without going through the executor.
+     *
+     * @param executor executor, must propagate exceptions thrown by the load and
+     * throw if the load can no longer run
+     */
+    void setExecutor(Executor executor);
 };
 
 /** @} endgroup OpenGL */
@@ -8,7 +8,10 @@
  * @{
  */
 
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "gl-wrapper.hpp"
 
 #include <core/graphics/vertex.hpp>
@@ -17,6 +20,10 @@
 /**
  * @brief Allows storing mesh data for rendering
  *
+ * Vertex array objects are cached per attribute mask, a bitmask of the
+ * attribute locations a pipeline reads (see OpenGLPipeline::getAttributeMask).
+ * Locations are bound explicitly when linking, so every pipeline reading the
+ * same attributes shares one vertex array per mesh.
  */
 class OpenGLMesh
 {
@@ -39,6 +46,9 @@ public:
     };
 private:
     VertexInfo m_vertexInfo;
+    MeshBounds m_bounds;
+    /** (attribute mask, vertex array) */
+    mutable std::vector<std::pair<std::uint32_t, GLuint>> m_vertexArrays;
     OpenGLMesh();
 protected:
 public:
@@ -71,6 +81,25 @@ public:
     const GLsizei &getOffsetTexCoords() const noexcept;
     /** Retrieve vertex info for the the mesh object */
     const VertexInfo &getVertexInfo() const noexcept;
+    /** Retrieve model space bounds computed when the mesh was loaded */
+    const MeshBounds &getBounds() const noexcept;
+    /** Retrieve mask of the attribute locations provided by the vertex buffer */
+    std::uint32_t getLayoutMask() const noexcept;
+
+    /**
+     * @brief Retrieve the vertex array enabling the attributes in @p attributeMask
+     * that the mesh provides, created on first use
+     *
+     * @param attributeMask attribute locations read by the pipeline
+     * @return GLuint vertex array, 0 if the context has no vertex array objects
+     */
+    GLuint getVertexArray(std::uint32_t attributeMask) const;
+
+    /** @brief Configures the attributes of @p attributeMask on the current vertex array */
+    void setupAttributes(std::uint32_t attributeMask) const;
+
+    /** @brief Checks if the context supports vertex array objects (GL 3.0) */
+    static bool supportsVertexArrays();
 };
 
 /** @} endgroup OpenGL */
@@ -8,13 +8,16 @@
  * @{
  */
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include <glm/glm.hpp>
 
 #include "../../../assets/shader.hpp"
+#include "../../../utils/hash.hpp"
 #include "gl-wrapper.hpp"
 #include "gl-mesh.hpp"
 #include "gl-texture.hpp"
@@ -26,7 +29,14 @@
  *  Index 0: Geometry vertice
  *  Index 1: Vertex Normals
  *  Index 2: Texture Coordinates
+ *  Index 3: Tangents
+ *  Index 5: Bitangents
+ *  Index 6: Vertex Color
+ *  Index 8-11: Per-instance model matrix (instanced pipelines)
  *
+ * Uniforms are addressed by @ref UniformHandle, the hash of the uniform name.
+ * Handles are resolved once when the program is linked so drawing never
+ * touches uniform names.
  */
 class OpenGLPipeline
 {
@@ -37,6 +47,9 @@ private:
     OpenGLPipeline();
 protected:
 public:
+    /** Hash of a uniform name, see @ref uniformHandle */
+    typedef std::uint64_t UniformHandle;
+
     struct ShaderStage
     {
         GLenum      shaderType;
@@ -51,15 +64,21 @@ public:
 
     struct Uniform
     {
-        GLenum      type;
-        std::size_t dataSize;
-        GLboolean   matrixTransponse;
-        void       *data;
+        UniformHandle handle;
+        GLenum        type;
+        std::size_t   dataSize;
+        GLboolean     matrixTransponse;
+        void         *data;
     };
 
     struct VertexAttributes
     {
-        GLuint index;
+        GLuint      index;      /** attribute location, see attribute bindings above */
+        GLint       size;       /** number of components */
+        GLenum      type;       /** component type */
+        GLboolean   normalized; /** normalize integer components to [0, 1] */
+        GLsizei     stride;
+        std::size_t offset; /** offset in the bound GL_ARRAY_BUFFER */
     };
 
     struct DrawInfo
@@ -75,8 +94,9 @@ public:
     {
         std::vector<GLuint> textures; /** Each texture in the vector is bound to texture units */
         std::vector<std::pair<GLenum, GLuint>> buffers; /** Bind buffers targets to specified buffer objects */
-        std::vector<std::pair<std::string, Uniform>> uniforms;
-        // std::vector<std::pair<std::string, Attributes>> attributes;
+        std::vector<Uniform> uniforms; /** Uniforms the pipeline doesn't have are ignored */
+        /** Enabled and configured before the draw, disabled after. Empty keeps the current attribute state */
+        std::vector<VertexAttributes> attributes;
         DrawInfo drawInfo;
     };
 
@@ -93,6 +113,45 @@ public:
     void render(const OpenGLMesh &mesh, const OpenGLTexture &texture, const glm::mat4 &mvp) const;
     void render(RenderInfo &renderInfo) const;
 
+    /** @brief Makes this pipeline the current program */
+    void bind() const;
+    /** @brief Binds the cached vertex array of @p mesh for this pipeline's attributes */
+    void bindMesh(const OpenGLMesh &mesh) const;
+    /** @brief Restores the default vertex array after drawing meshes */
+    void unbindMesh(const OpenGLMesh &mesh) const;
+    /** @brief Retrieve mask of the vertex attribute locations (0-7) read by the pipeline */
+    std::uint32_t getAttributeMask() const noexcept;
+    /** @brief Binds @p texture to the active texture unit */
+    void bindTexture(const OpenGLTexture &texture) const;
+    /** @brief Draws the bound mesh with @p mvp, the pipeline must be bound */
+    void draw(const OpenGLMesh &mesh, const glm::mat4 &mvp) const;
+    /**
+     * @brief Draws @p count instances of the bound mesh, the pipeline must be bound
+     *
+     * @param mesh mesh bound with bindMesh
+     * @param instanceBuffer buffer holding one model matrix per instance
+     * @param offset byte offset of the first matrix in @p instanceBuffer
+     * @param count number of instances
+     * @param viewProjection projection * view, passed as u_vp
+     */
+    void drawInstanced(const OpenGLMesh &mesh,
+                       GLuint            instanceBuffer,
+                       std::size_t       offset,
+                       GLsizei           count,
+                       const glm::mat4  &viewProjection) const;
+
+    /**
+     * @brief Returns the handle of uniform @p name, usable in constant expressions
+     * Array uniforms are addressed without the "[0]" suffix.
+     */
+    static constexpr UniformHandle uniformHandle(std::string_view name) { return core::utils::hash_fnv1a(name); }
+
+    /** @brief Checks if the pipeline has an active uniform with @p handle */
+    bool hasUniform(UniformHandle handle) const;
+
+    /** @brief Checks if the context supports instanced arrays (GL 3.3) */
+    static bool supportsInstancing();
+
     /**
      * @brief Identify type of shader based from name
      *
@@ -17,7 +17,10 @@
 #include "core/graphics/renderer.hpp"
 
 #include <SDL.h>
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class OpenGLRenderer : public Renderer
 {
@@ -45,6 +48,36 @@ public:
 
     /** @brief Returns reference to asset manager */
     AssetManager &getAssetManager() override;
+
+    /**
+     * @brief Sets how many frames the game loop may submit before one is
+     * presented, only used with CONFIG_CORE_RENDER_THREAD
+     *
+     * @param frames 1 or 2, clamped
+     */
+    void setFramesInFlight(std::size_t frames);
+
+    /**
+     * @brief Reads back every presented frame to compute @ref frameChecksum.
+     * Stalls the pipeline, meant for tests and benchmarks.
+     */
+    void setFrameCapture(bool enabled);
+    /**
+     * @brief FNV-1a hash of the RGBA8 pixels of the last presented frame, 0 if
+     * frame capture is disabled. With CONFIG_CORE_RENDER_THREAD it is updated on
+     * renderBegin, like @ref stats, and may skip frames with 2 frames in flight.
+     */
+    std::uint64_t frameChecksum() const;
+    /**
+     * @brief Checksums of every frame presented with capture enabled since the
+     * last call, as (frame number, checksum) in presentation order. Unlike
+     * @ref frameChecksum no frame is skipped, whatever the frames in flight.
+     */
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> takeFrameChecksums();
+
+    /** @brief Waits until every submitted frame was presented, no-op without a render thread */
+    void finish();
+
     /** @brief Returns flags needed for window creation */
     static SDL_WindowFlags getWindowFlags();
 };
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file core/renderer/opengl/gl-ringBuffer.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup OpenGL
+ * @{
+ */
+
+#include "gl-wrapper.hpp"
+#include "../../ringAllocator.hpp"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Per-frame allocator for streamed GPU data (instances, vertices, uniform blocks)
+ *
+ * The buffer is split in @ref frameCount regions. Each frame writes into its own
+ * region, which is fenced at @ref endFrame and only reused once the GPU has
+ * passed the fence, so writes never stall on draws still in flight.
+ *
+ * With GL 4.4 / ARB_buffer_storage the storage is persistently and coherently
+ * mapped, allocations point straight into GPU visible memory. Otherwise writes
+ * go to a CPU staging copy that @ref flush uploads with glBufferSubData, and the
+ * buffer is orphaned at every @ref beginFrame.
+ *
+ * @ref allocate may be called from any thread; everything else needs the GL
+ * context. Writers must finish before the range is drawn from (@ref flush).
+ */
+class OpenGLRingBuffer
+{
+public:
+    static constexpr std::size_t frameCount = 3;
+
+    struct Allocation
+    {
+        void       *data   = nullptr; /** write pointer, nullptr if the frame region is full */
+        GLuint      buffer = 0;       /** buffer to bind the range from */
+        std::size_t offset = 0;       /** byte offset in @ref buffer */
+        std::size_t size   = 0;
+
+        explicit operator bool() const noexcept { return data != nullptr; }
+    };
+
+private:
+    GLuint                               m_buffer     = 0;
+    bool                                 m_persistent = false;
+    RingAllocator                        m_ring;                 /** regions and offsets, one region for the fallback */
+    char                                *m_mapped = nullptr;     /** persistent mapping of the whole buffer */
+    std::vector<char>                    m_staging;              /** fallback: CPU copy of the frame region */
+    std::size_t                          m_flushed = 0;          /** fallback: bytes already uploaded */
+    std::array<GLsync, frameCount>       m_fences  = {};
+    std::vector<std::pair<GLuint, bool>> m_retired; /** (buffer, mapped) replaced by a growth this frame */
+
+    /** Creates the buffer for the current size of m_ring */
+    void create();
+    void retire();
+
+protected:
+public:
+    /**
+     * @brief Creates the buffer, requires a current GL context
+     *
+     * @param frameSize initial bytes available per frame, grows with @ref reserve
+     */
+    OpenGLRingBuffer(std::size_t frameSize);
+    ~OpenGLRingBuffer();
+    OpenGLRingBuffer(OpenGLRingBuffer &o)             = delete;
+    OpenGLRingBuffer(OpenGLRingBuffer &&o)            = delete;
+    OpenGLRingBuffer &operator=(OpenGLRingBuffer &o)  = delete;
+    OpenGLRingBuffer &operator=(OpenGLRingBuffer &&o) = delete;
+
+    /** @brief Moves to the next region, waits for the GPU if it is still reading it */
+    void beginFrame();
+    /** @brief Fences the current region */
+    void endFrame();
+
+    /**
+     * @brief Makes sure @p bytes more can be allocated this frame, growing the
+     * buffer if needed. Growing swaps the buffer, earlier allocations of this frame
+     * stay valid but must be done writing.
+     *
+     * @param bytes bytes about to be allocated
+     */
+    void reserve(std::size_t bytes);
+
+    /**
+     * @brief Reserves @p bytes in the current region, thread safe
+     *
+     * @param bytes size of the allocation
+     * @param alignment power of two alignment of the offset
+     * @return Allocation empty allocation if the region is full
+     */
+    Allocation allocate(std::size_t bytes, std::size_t alignment = 16);
+
+    /** @brief Makes the written allocations visible to the GPU, call before drawing from them */
+    void flush();
+
+    /** @brief Whether the buffer is persistently mapped */
+    bool persistent() const noexcept { return m_persistent; }
+    /** @brief Bytes available per frame */
+    std::size_t frameSize() const noexcept { return m_ring.frameSize(); }
+
+    /** @brief Offset alignment required by glBindBufferRange(GL_UNIFORM_BUFFER) */
+    static std::size_t uniformAlignment();
+};
+
+/** @} endgroup OpenGL */
@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * @file core/renderer/opengl/gl-spriteBatcher.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup OpenGL
+ * @{
+ */
+
+#include "../../renderer.hpp"
+#include "../../spriteBatch.hpp"
+#include "../../../ui/text/textBatch.hpp"
+#include "gl-wrapper.hpp"
+#include "gl-ringBuffer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+class OpenGLAssetManager;
+
+/**
+ * @brief Draws sprites as transformed quads streamed into a single vertex buffer
+ *
+ * Sprites are collected with @ref submit, sorted by layer, pipeline and texture
+ * by a SpriteBatch on @ref flush and written into one range of the frame's ring
+ * buffer, then each run of sprites sharing a pipeline and texture is drawn with
+ * a single glDrawElements.
+ * The draw count scales with the number of distinct textures per layer instead
+ * of sprites. See SpriteBatch for the ordering contract.
+ *
+ * Text meshes share the vertex layout and quad indices but are kept in their
+ * own buffers, uploaded only when the TextBatch rebuilt them.
+ */
+class OpenGLSpriteBatcher
+{
+public:
+    /** Vertex layout of batched sprites, see sprite.vert */
+    struct Vertex
+    {
+        glm::vec3     position; /** world space */
+        glm::vec2     uv;
+        std::uint32_t color;    /** RGBA8 */
+    };
+
+private:
+    /** Vertex buffer of a text mesh, kept until the mesh version changes */
+    struct TextBuffer
+    {
+        GLuint        buffer  = 0;
+        std::uint64_t version = 0;
+    };
+
+    SpriteBatch m_batch;
+
+    GLuint                  m_indiceBuffer = 0;
+    std::size_t             m_quadCapacity = 0; /** quads covered by the indice buffer */
+    std::vector<TextBuffer> m_textBuffers;
+
+    void reserveIndices(std::size_t quadCount);
+
+protected:
+public:
+    /** Creates the quad indice buffer, requires a current GL context */
+    OpenGLSpriteBatcher();
+    ~OpenGLSpriteBatcher();
+    OpenGLSpriteBatcher(OpenGLSpriteBatcher &o)             = delete;
+    OpenGLSpriteBatcher(OpenGLSpriteBatcher &&o)            = delete;
+    OpenGLSpriteBatcher &operator=(OpenGLSpriteBatcher &o)  = delete;
+    OpenGLSpriteBatcher &operator=(OpenGLSpriteBatcher &&o) = delete;
+
+    /**
+     * @brief Queues a sprite for the next flush
+     *
+     * @param layer draw order, lower layers are drawn first
+     * @param pipeline pipeline asset, must use the sprite vertex layout
+     * @param texture texture asset
+     * @param model model matrix applied to the unit quad
+     * @param uvRect texture region (u0, v0, u1, v1)
+     * @param color tint multiplied with the texture
+     */
+    void submit(std::uint8_t     layer,
+                AssetID          pipeline,
+                AssetID          texture,
+                const glm::mat4 &model,
+                const glm::vec4 &uvRect,
+                const glm::vec4 &color);
+
+    /**
+     * @brief Uploads and draws every queued sprite, then clears the queue
+     *
+     * @param am asset manager owning the pipelines and textures
+     * @param stream ring buffer the vertices are written to
+     * @param viewProjection projection * view of the current camera
+     * @param stats counters to update
+     */
+    void flush(OpenGLAssetManager &am, OpenGLRingBuffer &stream, const glm::mat4 &viewProjection, RendererStats &stats);
+
+    /**
+     * @brief Draws a text mesh, one draw call per glyph page
+     *
+     * @param am asset manager owning the pipeline and glyph pages
+     * @param slot buffer the mesh is kept in, one per text batch drawn each frame
+     * @param pipeline pipeline asset, must use the sprite vertex layout
+     * @param mesh mesh from TextBatch::build, uploaded if @p slot holds another version
+     * @param viewProjection projection * view of the current camera
+     * @param stats counters to update
+     */
+    void drawText(OpenGLAssetManager              &am,
+                  std::size_t                      slot,
+                  AssetID                          pipeline,
+                  const core::ui::TextBatch::Mesh &mesh,
+                  const glm::mat4                 &viewProjection,
+                  RendererStats                   &stats);
+
+    /** @brief Number of sprites waiting for flush */
+    std::size_t size() const noexcept { return m_batch.size(); }
+};
+
+/** @} endgroup OpenGL */
@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * @file core/renderer/opengl/gl-stateCache.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup OpenGL
+ * @{
+ */
+
+#include "gl-wrapper.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Shadow copy of the bound GL state, filters out redundant state changes
+ *
+ * Tracks the program, buffers, vertex array, textures per unit and the
+ * blend/depth/cull state. A call that would set the value already bound is
+ * skipped. State starts unknown, so the first call of each kind always reaches
+ * the driver.
+ *
+ * Every bind in the OpenGL backend must go through the cache or the shadow
+ * state goes stale; code that changes state behind its back calls
+ * @ref invalidate. Objects must be deleted through the cache as well since GL
+ * reuses the names of deleted objects.
+ *
+ * The renderer owns the instance, @ref current returns it.
+ */
+class OpenGLStateCache
+{
+public:
+    struct Counters
+    {
+        std::size_t issued  = 0; /** state changes passed to the driver */
+        std::size_t skipped = 0; /** state changes filtered out */
+    };
+
+    static constexpr std::size_t textureUnits = 16;
+
+private:
+    /** marks state not known to the cache */
+    static constexpr GLuint unknown = ~GLuint(0);
+
+    enum Capability : std::uint8_t
+    {
+        Blend = 0,
+        DepthTest,
+        CullFace,
+        CapabilityCount
+    };
+
+    enum BufferTarget : std::uint8_t
+    {
+        ArrayBuffer = 0,
+        ElementArrayBuffer, /** part of the vertex array state */
+        UniformBuffer,
+        PixelUnpackBuffer,
+        BufferTargetCount
+    };
+
+    GLuint                                    m_program;
+    GLuint                                    m_vertexArray;
+    std::array<GLuint, BufferTargetCount>     m_buffers;
+    GLenum                                    m_activeTexture;
+    std::array<GLuint, textureUnits>          m_textures; /** GL_TEXTURE_2D per unit */
+    std::array<std::int8_t, CapabilityCount>  m_capabilities; /** -1 unknown */
+    GLenum                                    m_blendSrc;
+    GLenum                                    m_blendDst;
+    GLenum                                    m_depthFunc;
+    GLuint                                    m_depthMask;
+    GLenum                                    m_polygonMode;
+    Counters                                  m_counters;
+
+    /** Updates @p cached to @p value, returns false if it already was */
+    bool update(GLuint &cached, GLuint value);
+
+protected:
+public:
+    OpenGLStateCache();
+    ~OpenGLStateCache();
+    OpenGLStateCache(OpenGLStateCache &o)             = delete;
+    OpenGLStateCache(OpenGLStateCache &&o)            = delete;
+    OpenGLStateCache &operator=(OpenGLStateCache &o)  = delete;
+    OpenGLStateCache &operator=(OpenGLStateCache &&o) = delete;
+
+    /** @brief Retrieve the state cache of the current renderer */
+    static OpenGLStateCache &current();
+
+    /** @brief Forgets all tracked state, the next call of each kind is issued */
+    void invalidate();
+
+    void useProgram(GLuint program);
+    /** @brief Binds @p buffer, targets that aren't tracked are always issued */
+    void bindBuffer(GLenum target, GLuint buffer);
+    void bindVertexArray(GLuint vertexArray);
+    /** @param unit texture unit index, not the GL_TEXTUREi enum */
+    void activeTexture(GLuint unit);
+    /** @brief Binds @p texture to the active unit, targets other than GL_TEXTURE_2D are always issued */
+    void bindTexture(GLenum target, GLuint texture);
+
+    /** @brief glEnable/glDisable, capabilities that aren't tracked are always issued */
+    void setEnabled(GLenum capability, bool enabled);
+    void blendFunc(GLenum src, GLenum dst);
+    void depthFunc(GLenum func);
+    void depthMask(GLboolean mask);
+    /** @brief glPolygonMode for GL_FRONT_AND_BACK */
+    void polygonMode(GLenum mode);
+
+    void deleteBuffer(GLuint buffer);
+    void deleteVertexArray(GLuint vertexArray);
+    void deleteTexture(GLuint texture);
+    void deleteProgram(GLuint program);
+
+    const Counters &counters() const noexcept { return m_counters; }
+    void            resetCounters() noexcept { m_counters = Counters(); }
+};
+
+/** @} endgroup OpenGL */
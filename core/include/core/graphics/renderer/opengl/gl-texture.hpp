@@ -11,6 +11,7 @@
 #include <memory>
 #include "gl-wrapper.hpp"
 
+#include <assets/bakedTexture.hpp>
 #include <assets/texture.hpp>
 
 class OpenGLTexture
@@ -22,6 +23,8 @@ protected:
 public:
     OpenGLTexture();
     OpenGLTexture(const core::assets::Texture &mesh);
+    /** @brief Uploads the baked mip chain as is */
+    OpenGLTexture(const core::assets::BakedTexture &texture);
     ~OpenGLTexture();
 
     OpenGLTexture(OpenGLTexture &o)            = delete;
@@ -29,7 +32,53 @@ public:
     OpenGLTexture(OpenGLTexture &&o);
     OpenGLTexture &operator=(OpenGLTexture &&o);
 
+    /** @brief Uploads the pixels of @p texture, replacing the current ones */
+    void update(const core::assets::Texture &texture);
+    /**
+     * @brief Uploads the pixels of @p region with its top-left corner at
+     * (@p x, @p y), counted from the top row like the texture's pixels
+     */
+    void update(const core::assets::Texture &region, std::size_t x, std::size_t y);
+
     GLuint getTextureID() const;
+
+    /**
+     * @brief Writes the RGBA8 pixels of @p texture to @p target bottom row
+     * first, the order glTexImage2D expects. Doesn't need the GL context.
+     *
+     * @param target width * height * 4 bytes
+     */
+    static void copyRows(const core::assets::Texture &texture, void *target);
+
+    /**
+     * @brief Replaces the image of @p texture and regenerates its mipmaps
+     *
+     * @param pixels RGBA8 rows from bottom to top, an offset into the bound
+     * GL_PIXEL_UNPACK_BUFFER if there is one
+     */
+    static void upload(GLuint texture, std::size_t width, std::size_t height, const void *pixels);
+
+    /**
+     * @brief Replaces a region of the image of @p texture and regenerates its
+     * mipmaps
+     *
+     * @param x, y bottom-left corner of the region in GL texel coordinates
+     * @param pixels RGBA8 rows from bottom to top
+     */
+    static void upload(GLuint      texture,
+                       std::size_t x,
+                       std::size_t y,
+                       std::size_t width,
+                       std::size_t height,
+                       const void *pixels);
+
+    /**
+     * @brief Replaces the image of @p texture with every mip level of @p baked
+     *
+     * @param payload start of the baked payload, in client memory or as an
+     * offset into the bound GL_PIXEL_UNPACK_BUFFER
+     */
+    static void upload(GLuint texture, const core::assets::BakedTexture &baked, const char *payload);
 };
 
 /** @} endgroup OpenGL */
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file core/renderer/opengl/gl-textureStreamer.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup OpenGL
+ * @{
+ */
+
+#include "gl-wrapper.hpp"
+
+#include <assets/bakedTexture.hpp>
+
+#include <cstddef>
+#include <future>
+#include <list>
+
+struct RendererStats;
+
+/**
+ * @brief Loads textures in the background and uploads them within a per-frame budget
+ *
+ * @ref request loads the baked texture on the job pool, baking it first if the
+ * cache is stale. Once it is loaded, @ref update maps a pixel unpack buffer and a
+ * worker copies the mip chain into it, which also faults the cache file in off
+ * the GL thread. A later @ref update unmaps the buffer and respecifies the target
+ * texture from it, replacing whatever the texture showed until then.
+ *
+ * Uploads stop for the frame once @ref budget bytes went up. An image larger than
+ * the budget is uploaded alone in its frame. Without pixel buffer objects the
+ * levels are uploaded straight from the baked texture.
+ *
+ * Everything must be called on the thread the context is current on.
+ */
+class OpenGLTextureStreamer
+{
+private:
+    struct Load
+    {
+        enum class State
+        {
+            Decoding, /** waiting for @ref decoded, loading or baking */
+            Copying,  /** waiting for @ref copied */
+            Ready     /** waiting for budget */
+        };
+
+        GLuint                                  texture;
+        AssetName                               name;
+        State                                   state = State::Decoding;
+        std::future<core::assets::BakedTexture> decoded;
+        core::assets::BakedTexture              image; /** read by the copy job */
+        std::future<void>                       copied;
+        GLuint                                  buffer = 0; /** mapped pixel unpack buffer, 0 to upload from @ref image */
+    };
+
+    std::list<Load> m_loads; /** in request order, the copy jobs point into the nodes */
+    std::size_t     m_budget;
+    bool            m_pixelBuffers;
+
+    void map(Load &load);
+    void upload(Load &load);
+    void release(Load &load);
+
+protected:
+public:
+    /** @param budget bytes uploaded per frame */
+    OpenGLTextureStreamer(std::size_t budget);
+    ~OpenGLTextureStreamer();
+    OpenGLTextureStreamer(OpenGLTextureStreamer &o)             = delete;
+    OpenGLTextureStreamer(OpenGLTextureStreamer &&o)            = delete;
+    OpenGLTextureStreamer &operator=(OpenGLTextureStreamer &o)  = delete;
+    OpenGLTextureStreamer &operator=(OpenGLTextureStreamer &&o) = delete;
+
+    /**
+     * @brief Starts loading texture asset @p name into @p texture
+     *
+     * @param texture GL texture showing a placeholder until the image is uploaded
+     * @param name texture asset, a failed decode is logged and leaves the placeholder
+     */
+    void request(GLuint texture, const AssetName &name);
+
+    /** @brief Drops pending loads into @p texture, e.g. because its pixels were replaced */
+    void cancel(GLuint texture);
+
+    /** @brief Advances the pending loads and uploads the ready ones, call once per frame */
+    void update(RendererStats &stats);
+
+    /** @brief Number of loads not uploaded yet */
+    std::size_t pending() const noexcept { return m_loads.size(); }
+
+    std::size_t budget() const noexcept { return m_budget; }
+    void        setBudget(std::size_t budget) noexcept { m_budget = budget; }
+};
+
+/** @} endgroup OpenGL */
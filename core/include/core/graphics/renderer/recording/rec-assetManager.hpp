@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file core/renderer/recording/rec-assetManager.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Recording
+ * @{
+ */
+
+#include "../../asset-manager.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief AssetManager that only hands out IDs
+ *
+ * Assets are identified by name like in the OpenGLAssetManager, but nothing is
+ * read or uploaded. Meshes keep their bounds so culling matches the real
+ * renderers; meshes loaded by name get the bounds of a unit cube.
+ */
+class RecordingAssetManager : public AssetManager
+{
+private:
+    struct Registry
+    {
+        std::vector<std::string>                 names;
+        std::unordered_map<std::string, AssetID> ids;
+    };
+
+    Registry                             m_meshes;
+    Registry                             m_textures;
+    Registry                             m_pipelines;
+    std::vector<MeshBounds>              m_meshBounds;
+    std::unordered_map<AssetID, AssetID> m_instancedPipelines;
+    bool                                 m_instancing   = true;
+    std::size_t                          m_textureBytes = 0;
+
+    static AssetID find(const Registry &registry, const std::string &name);
+    static AssetID add(Registry &registry, const std::string &name);
+    Registry      &registry(const AssetType &type);
+    /** Adds a pipeline and its "<name>_instanced" variant */
+    AssetID        addPipeline(const std::string &name);
+
+protected:
+public:
+    RecordingAssetManager();
+    ~RecordingAssetManager();
+
+    AssetID loadAsset(const AssetType &type, const AssetName &name) override;
+    AssetID loadMesh(const core::assets::Mesh &mesh) override;
+    AssetID loadTexture(const core::assets::Texture &texture) override;
+    AssetID loadPipeline(const core::assets::Shader &shader) override;
+    void    updateTexture(AssetID id, const core::assets::Texture &texture) override;
+    void    updateTextureRegion(AssetID id, const core::assets::Texture &region, std::size_t x, std::size_t y) override;
+
+    const MeshBounds &getMeshBounds(AssetID id) const override;
+
+    /** @brief Adds a mesh with @p bounds, or updates the bounds of the existing one */
+    AssetID addMesh(const std::string &name, const MeshBounds &bounds);
+
+    /** @brief Name the asset was loaded with */
+    const std::string &getName(const AssetType &type, AssetID id);
+
+    /** @brief Number of loaded assets of @p type */
+    std::size_t count(const AssetType &type);
+
+    /** @brief Bytes of pixels passed to texture updates */
+    std::size_t textureBytes() const noexcept { return m_textureBytes; }
+
+    /**
+     * @brief Mirrors OpenGLAssetManager::getInstancedPipeline, the variant is the
+     * "<name>_instanced" pipeline and is added when the pipeline is loaded
+     *
+     * @return AssetID instanced pipeline, -1 if instancing is disabled
+     */
+    AssetID getInstancedPipeline(AssetID pipeline) const;
+
+    /** @brief Whether instanced variants are available, enabled by default */
+    void setInstancing(bool enabled);
+    bool instancing() const noexcept { return m_instancing; }
+};
+
+/** @} endgroup Recording */
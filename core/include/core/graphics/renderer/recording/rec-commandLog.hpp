@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file core/renderer/recording/rec-commandLog.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Recording
+ * @{
+ */
+
+#include "../../asset-manager.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Draw calls and state changes submitted by the RecordingRenderer
+ *
+ * Binds are filtered like OpenGLStateCache does: binding the asset already
+ * bound is counted as redundant and not recorded, so the log holds the state
+ * changes a driver would see.
+ */
+class CommandLog
+{
+public:
+    enum class Op : std::uint8_t
+    {
+        BeginFrame = 0, /** id: frame number */
+        Camera,         /** id: camera index in the packet */
+        BindPipeline,   /** id: pipeline asset */
+        BindTexture,    /** id: texture asset */
+        BindMesh,       /** id: mesh asset */
+        Uniform,        /** id: uniform name hash, count: bytes */
+        Draw,           /** id: mesh asset */
+        DrawInstanced,  /** id: mesh asset, count: instances */
+        DrawSprites,    /** id: texture asset, count: sprites */
+        UploadText,     /** id: text mesh version, count: glyph quads */
+        DrawText,       /** id: texture asset, count: glyph quads */
+        Present,
+        Count
+    };
+    static constexpr std::size_t opCount = static_cast<std::size_t>(Op::Count);
+
+    struct Command
+    {
+        Op            op;
+        std::uint32_t count;
+        std::int64_t  id;
+
+        bool operator==(const Command &o) const noexcept { return op == o.op && count == o.count && id == o.id; }
+        bool operator!=(const Command &o) const noexcept { return !(*this == o); }
+    };
+
+    /** @brief Upper bounds checked by @ref checkBudget */
+    struct Budget
+    {
+        static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+        std::size_t drawCalls     = unlimited; /** Draw, DrawInstanced, DrawSprites and DrawText */
+        std::size_t pipelineBinds = unlimited;
+        std::size_t textureBinds  = unlimited;
+        std::size_t meshBinds     = unlimited;
+        std::size_t uniforms      = unlimited;
+    };
+
+    /** @brief Result of @ref diff */
+    struct Diff
+    {
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        std::size_t                          firstMismatch = npos; /** index of the first differing command */
+        std::array<std::ptrdiff_t, opCount> countDelta    = {};   /** commands per op, b - a */
+        std::string                          report;               /** empty if the logs are identical */
+
+        bool identical() const noexcept { return firstMismatch == npos; }
+    };
+
+private:
+    std::vector<Command>               m_commands;
+    std::array<std::size_t, opCount>   m_counts    = {};
+    std::size_t                        m_redundant = 0;
+    std::int64_t                       m_pipeline  = -1;
+    std::int64_t                       m_texture   = -1;
+    std::int64_t                       m_mesh      = -1;
+
+    void bind(Op op, std::int64_t &bound, AssetID id);
+
+protected:
+public:
+    /** @brief Removes all commands and forgets the bound state */
+    void clear();
+    /** @brief Forgets the bound state, the next bind of each kind is recorded */
+    void invalidate();
+
+    void record(Op op, std::int64_t id = 0, std::uint32_t count = 0);
+
+    void bindPipeline(AssetID id) { bind(Op::BindPipeline, m_pipeline, id); }
+    void bindTexture(AssetID id) { bind(Op::BindTexture, m_texture, id); }
+    void bindMesh(AssetID id) { bind(Op::BindMesh, m_mesh, id); }
+
+    std::size_t    size() const noexcept { return m_commands.size(); }
+    const Command &operator[](std::size_t i) const noexcept { return m_commands[i]; }
+    const std::vector<Command> &commands() const noexcept { return m_commands; }
+
+    /** @brief Number of recorded commands of type @p op */
+    std::size_t count(Op op) const noexcept { return m_counts[static_cast<std::size_t>(op)]; }
+    /** @brief Draw, DrawInstanced and DrawSprites commands */
+    std::size_t drawCalls() const noexcept;
+    /** @brief Binds recorded as state changes */
+    std::size_t binds() const noexcept;
+    /** @brief Binds filtered because the asset was already bound */
+    std::size_t redundantBinds() const noexcept { return m_redundant; }
+
+    /**
+     * @brief Checks the log against @p budget
+     *
+     * @return std::string empty if within budget, otherwise one line per exceeded limit
+     */
+    std::string checkBudget(const Budget &budget) const;
+
+    /** @brief Compares two logs command by command, ignoring the frame number of BeginFrame */
+    static Diff diff(const CommandLog &a, const CommandLog &b);
+
+    static const char *opName(Op op) noexcept;
+    /** @brief Formats command @p i, e.g. "BindTexture 3" */
+    std::string toString(std::size_t i) const;
+    /** @brief Formats the whole log, one command per line */
+    std::string toString() const;
+};
+
+/** @} endgroup Recording */
@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * @file core/renderer/recording/rec-renderer.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @defgroup Recording
+ * @brief Renderer recording draw calls and state changes instead of drawing
+ *
+ * Runs the same culling, render queue and sprite batching as the OpenGL
+ * renderer without a graphics context, so tests can assert on what a frame
+ * submits.
+ *
+ * @ingroup Renderer
+ * @{
+ */
+
+#include "../../renderer.hpp"
+#include "../../framePacket.hpp"
+#include "rec-assetManager.hpp"
+#include "rec-commandLog.hpp"
+
+#include <memory>
+
+/**
+ * @brief Renderer writing every bind, uniform upload and draw into a CommandLog
+ *
+ * @ref render extracts a packet from the ComponentManager like the OpenGL
+ * renderer; tests can build a FramePacket by hand and pass it to
+ * @ref renderFrame instead. The log holds the commands of the last frame.
+ */
+class RecordingRenderer : public Renderer
+{
+private:
+    struct Internal;
+    std::unique_ptr<Internal> m_internal;
+protected:
+public:
+    RecordingRenderer();
+    ~RecordingRenderer();
+    RecordingRenderer(RecordingRenderer &o)             = delete;
+    RecordingRenderer(RecordingRenderer &&o)            = delete;
+    RecordingRenderer &operator=(RecordingRenderer &o)  = delete;
+    RecordingRenderer &operator=(RecordingRenderer &&o) = delete;
+
+    void init() override;
+    void update(const time_ms delta) override;
+    void clean() override;
+    void refresh() override;
+
+    bool renderBegin() override;
+    void render() override;
+    void renderEnd() override;
+
+    /** @brief Records the draws of @p packet, between renderBegin and renderEnd */
+    void submit(const FramePacket &packet);
+    /** @brief Records a whole frame drawing @p packet, returns its log */
+    const CommandLog &renderFrame(const FramePacket &packet);
+
+    /** @brief Commands of the last frame */
+    const CommandLog &log() const;
+
+    AssetManager          &getAssetManager() override;
+    RecordingAssetManager &assetManager();
+};
+
+/** @} endgroup Recording */
@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file core/graphics/ringAllocator.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Renderer
+ * @{
+ */
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Offset bookkeeping of a per-frame ring buffer, without the GPU side
+ *
+ * The buffer holds @ref regionCount regions of @ref frameSize bytes. Each frame
+ * allocates from its own region and @ref nextRegion cycles through them, so a
+ * region is only written again @ref regionCount frames later, once the caller
+ * waited on the fence of that region. With one region every frame starts at
+ * offset 0, for buffers that are orphaned instead of fenced.
+ *
+ * Used by OpenGLRingBuffer, kept apart so the arithmetic can be tested without
+ * a context. @ref allocate may be called from any thread.
+ */
+class RingAllocator
+{
+public:
+    /** Region sizes are kept a multiple of this so every region start is aligned */
+    static constexpr std::size_t regionAlignment = 256;
+
+private:
+    std::size_t              m_frameSize   = 0;
+    std::size_t              m_regionCount = 1;
+    std::size_t              m_region      = 0;
+    std::atomic<std::size_t> m_head{0}; /** bytes allocated in the current region */
+
+protected:
+public:
+    /**
+     * @param frameSize bytes per region, rounded up to @ref regionAlignment
+     * @param regionCount regions in the buffer, frames in flight
+     */
+    RingAllocator(std::size_t frameSize, std::size_t regionCount);
+
+    /**
+     * @brief Moves to the next region and empties it
+     * @return std::size_t the new region, the caller must wait until the GPU is
+     * done reading it before handing out allocations
+     */
+    std::size_t nextRegion();
+
+    /** @brief Whether @p bytes more can be allocated, with worst case alignment padding */
+    bool fits(std::size_t bytes) const;
+
+    /**
+     * @brief Grows the regions so @p bytes fit in an empty one, at least doubling.
+     * The current region stays selected and is emptied, the caller moves to a new
+     * buffer of @ref bufferSize bytes.
+     */
+    void grow(std::size_t bytes);
+
+    /**
+     * @brief Reserves @p bytes in the current region, thread safe
+     *
+     * @param bytes size of the allocation
+     * @param alignment power of two alignment of the offset
+     * @param offset set to the offset from the start of the region
+     * @return false if the region is full
+     */
+    bool allocate(std::size_t bytes, std::size_t alignment, std::size_t &offset);
+
+    /** @brief Bytes allocated in the current region, including padding */
+    std::size_t head() const noexcept { return m_head.load(std::memory_order_acquire); }
+
+    std::size_t frameSize() const noexcept { return m_frameSize; }
+    std::size_t regionCount() const noexcept { return m_regionCount; }
+    std::size_t region() const noexcept { return m_region; }
+    /** @brief Offset of the current region in the buffer */
+    std::size_t regionOffset() const noexcept { return m_region * m_frameSize; }
+    /** @brief Size of the whole buffer */
+    std::size_t bufferSize() const noexcept { return m_frameSize * m_regionCount; }
+};
+
+/** @} endgroup Renderer */
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file core/graphics/spriteAtlas.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Graphics
+ * @{
+ */
+
+#include "asset-manager.hpp"
+#include "../assets/atlasPacker.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Packs sprite textures into shared atlas pages at runtime
+ *
+ * Sprites are registered by texture asset name with @ref add, then packed by
+ * @ref build on a worker thread which loads the images, places them with the
+ * AtlasPacker and copies them into the page pixels. @ref update, called from
+ * the game thread, uploads the pages through the AssetManager once the build is
+ * done and remaps the SpriteRenderers showing a packed sprite to their page
+ * texture and UV rect, so sprites from different files batch together.
+ *
+ * Sprites added after a build are packed incrementally by the next one: they
+ * fill the free space of the existing pages first, then open new pages. A page
+ * that receives sprites is uploaded again as a whole.
+ */
+class SpriteAtlas
+{
+public:
+    struct Settings
+    {
+        core::assets::AtlasPacker::Settings packer;
+        bool bleed = true; /** extends sprite edges into the padding, avoids seams with linear filtering */
+    };
+
+    struct Region
+    {
+        AssetID     texture = -1; /** page texture */
+        std::size_t page    = 0;
+        glm::vec4   uvRect{0.0f, 0.0f, 1.0f, 1.0f}; /** u0, v0, u1, v1 like SpriteRenderer::setUVRect */
+    };
+
+private:
+    struct Internal;
+    std::unique_ptr<Internal> m_internal;
+
+protected:
+public:
+    SpriteAtlas(AssetManager &assetManager);
+    SpriteAtlas(AssetManager &assetManager, const Settings &settings);
+    ~SpriteAtlas();
+    SpriteAtlas(SpriteAtlas &o)             = delete;
+    SpriteAtlas &operator=(SpriteAtlas &o)  = delete;
+    SpriteAtlas(SpriteAtlas &&o);
+    SpriteAtlas &operator=(SpriteAtlas &&o);
+
+    /** @brief Registers texture asset @p sprite for the next build, repeated names are ignored */
+    void add(const AssetName &sprite);
+
+    /**
+     * @brief Starts packing the sprites added since the last build on a worker
+     * thread. If a build is already running, the sprites are packed once it is
+     * published by @ref update.
+     */
+    void build();
+
+    /**
+     * @brief Publishes a finished build: uploads the changed pages and remaps
+     * the SpriteRenderers of the packed sprites. Call from the game thread.
+     *
+     * @return true if regions were published
+     * @throw std::runtime_error if the build failed, e.g. a sprite could not be loaded
+     */
+    bool update();
+
+    /** @brief Waits for the running builds, then publishes them like @ref update */
+    bool wait();
+
+    /** @brief Whether a build is running or waiting to be published */
+    bool busy() const;
+
+    /**
+     * @brief Retrieves the published region of @p sprite
+     *
+     * @return false if the sprite isn't packed yet
+     */
+    bool find(const AssetName &sprite, Region &region) const;
+
+    /** @brief Number of published pages */
+    std::size_t pageCount() const;
+};
+
+/** @} endgroup Graphics */
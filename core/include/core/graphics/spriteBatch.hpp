@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file core/graphics/spriteBatch.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Renderer
+ * @{
+ */
+
+#include "asset-manager.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Collects sprites and groups them into runs sharing pipeline and texture
+ *
+ * Holds the API independent part of sprite batching: after @ref sort the
+ * sprites are ordered by (layer, pipeline, texture) and each @ref Run is meant
+ * to be drawn with a single draw call.
+ *
+ * Ordering contract:
+ * - every sprite of a lower layer is drawn before any sprite of a higher layer,
+ *   so overlapping alpha blended sprites are composed by layer
+ * - within a layer, sprites are grouped by pipeline and texture and their
+ *   relative draw order across different textures is not kept
+ * - sprites sharing layer, pipeline and texture keep their submission order
+ *
+ * Sprites that overlap and must blend in a given order either go on different
+ * layers or share a texture (e.g. a sprite atlas).
+ */
+class SpriteBatch
+{
+public:
+    struct Sprite
+    {
+        std::uint64_t key;    /** layer (8) | pipeline (24) | texture (32) */
+        glm::vec3     origin; /** world space corner (0,0) */
+        glm::vec3     axisX;  /** world space edge to corner (1,0) */
+        glm::vec3     axisY;  /** world space edge to corner (0,1) */
+        glm::vec4     uvRect;
+        std::uint32_t color;  /** RGBA8 */
+    };
+
+    struct Run
+    {
+        AssetID     pipeline;
+        AssetID     texture;
+        std::size_t begin; /** first sorted sprite */
+        std::size_t count;
+    };
+
+private:
+    std::vector<Sprite>                                  m_sprites;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> m_order; /** (key, sprite index) */
+    std::vector<Run>                                     m_runs;
+
+protected:
+public:
+    SpriteBatch();
+    ~SpriteBatch();
+
+    /**
+     * @brief Queues a sprite
+     *
+     * @param layer draw order, lower layers are drawn first
+     * @param pipeline pipeline asset
+     * @param texture texture asset
+     * @param model model matrix applied to the unit quad
+     * @param uvRect texture region (u0, v0, u1, v1)
+     * @param color tint multiplied with the texture
+     */
+    void submit(std::uint8_t     layer,
+                AssetID          pipeline,
+                AssetID          texture,
+                const glm::mat4 &model,
+                const glm::vec4 &uvRect,
+                const glm::vec4 &color);
+
+    /** @brief Orders the queued sprites and computes the runs */
+    void sort();
+
+    /** @brief Removes all sprites, keeps capacity */
+    void clear();
+
+    /** @brief Number of queued sprites */
+    std::size_t size() const noexcept { return m_sprites.size(); }
+    bool        empty() const noexcept { return m_sprites.empty(); }
+
+    /** @brief Sprite at position @p i of the sorted order, valid after @ref sort */
+    const Sprite &sorted(std::size_t i) const noexcept { return m_sprites[m_order[i].second]; }
+    /** @brief Runs of the sorted sprites, valid after @ref sort */
+    const std::vector<Run> &runs() const noexcept { return m_runs; }
+};
+
+/** @} endgroup Renderer */
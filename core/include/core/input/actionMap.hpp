@@ -0,0 +1,182 @@
+#pragma once
+
+/**
+ * @file core/input/actionMap.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Input
+ * @{
+ */
+
+#include <SDL.h>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/** Index of a digital action in @ref ActionMap */
+using ActionID = std::uint8_t;
+/** Index of an analog axis in @ref ActionMap */
+using AxisID = std::uint8_t;
+
+/** Maximum number of digital actions per ActionMap */
+constexpr std::size_t MaxActions = 64;
+/** Maximum number of analog axes per ActionMap */
+constexpr std::size_t MaxAxes = 16;
+/** Returned by ActionMap lookups when no action/axis matches */
+constexpr std::uint8_t InvalidAction = 0xff;
+
+/** Relative mouse axes that can be bound to an analog axis */
+enum class MouseAxis : std::uint8_t
+{
+    X,
+    Y,
+    Wheel
+};
+
+/**
+ * @brief Raw device state for one frame, filled by InputManager
+ */
+struct InputSample
+{
+    const std::uint8_t                        *keys              = nullptr; /** SDL_GetKeyboardState array */
+    int                                        keyCount          = 0;
+    std::uint32_t                              mouseButtons      = 0;  /** SDL_BUTTON() mask */
+    std::uint32_t                              controllerButtons = 0;  /** 1 << SDL_GameControllerButton mask */
+    std::array<float, 3>                       mouse             = {}; /** relative motion, indexed by MouseAxis */
+    std::array<float, SDL_CONTROLLER_AXIS_MAX> controllerAxes    = {}; /** normalized to [-1, 1] */
+};
+
+/**
+ * @brief Per-frame snapshot of all actions
+ *
+ * Trivially copyable so it can be stored for replay or rollback.
+ */
+struct ActionState
+{
+    std::uint64_t              frame = 0;
+    std::bitset<MaxActions>    down;      /** action is held */
+    std::bitset<MaxActions>    pressed;   /** action went down this frame */
+    std::bitset<MaxActions>    released;  /** action went up this frame */
+    std::array<float, MaxAxes> axes = {}; /** analog axis values */
+
+    bool  isDown(ActionID id) const { return down[id]; }
+    bool  wasPressed(ActionID id) const { return pressed[id]; }
+    bool  wasReleased(ActionID id) const { return released[id]; }
+    float axis(AxisID id) const { return axes[id]; }
+};
+
+/**
+ * @brief Maps named actions and axes to keys, buttons and device axes.
+ *
+ * Bindings are compiled into lookup tables, after which @ref evaluate turns an
+ * @ref InputSample into an @ref ActionState without any per-binding branching
+ * on names or callbacks. Several bindings may drive the same action.
+ *
+ * @todo: load bindings from json
+ */
+class ActionMap
+{
+private:
+    typedef std::bitset<MaxActions> ActionMask;
+
+    enum class AxisSource : std::uint8_t
+    {
+        KeyPair,
+        Mouse,
+        Controller
+    };
+
+    struct AxisBinding
+    {
+        AxisID     axis;
+        AxisSource source;
+        int        code;  /** scancode (negative key), MouseAxis or SDL_GameControllerAxis */
+        int        code2; /** scancode of positive key for KeyPair */
+        float      scale;
+        float      deadzone;
+    };
+
+    std::vector<std::string> m_actionNames;
+    std::vector<std::string> m_axisNames;
+
+    /** bindings as added by the user */
+    std::vector<std::pair<SDL_Scancode, ActionID>>             m_keyBindings;
+    std::vector<std::pair<std::uint8_t, ActionID>>             m_mouseBindings;
+    std::vector<std::pair<SDL_GameControllerButton, ActionID>> m_controllerBindings;
+    std::vector<AxisBinding>                                   m_axisBindings;
+
+    /** compiled tables */
+    bool                                              m_compiled = false;
+    std::vector<std::uint16_t>                        m_boundKeys; /** unique bound scancodes */
+    std::array<ActionMask, SDL_NUM_SCANCODES>         m_keyMasks;
+    std::array<ActionMask, 32>                        m_mouseMasks;
+    std::array<ActionMask, SDL_CONTROLLER_BUTTON_MAX> m_controllerMasks;
+    std::uint32_t                                     m_usedMouseButtons      = 0;
+    std::uint32_t                                     m_usedControllerButtons = 0;
+
+protected:
+public:
+    ActionMap();
+    ~ActionMap();
+
+    /**
+     * @brief Adds a digital action, or returns the existing one with @p name
+     *
+     * @param name name of the action
+     * @return ActionID id used to query @ref ActionState
+     */
+    ActionID addAction(std::string_view name);
+
+    /**
+     * @brief Adds an analog axis, or returns the existing one with @p name
+     *
+     * @param name name of the axis
+     * @return AxisID id used to query @ref ActionState
+     */
+    AxisID addAxis(std::string_view name);
+
+    /** @brief Find action by name, returns InvalidAction if not found */
+    ActionID findAction(std::string_view name) const;
+    /** @brief Find axis by name, returns InvalidAction if not found */
+    AxisID findAxis(std::string_view name) const;
+
+    ActionMap &bindKey(ActionID action, SDL_Scancode key);
+    ActionMap &bindMouseButton(ActionID action, std::uint8_t button);
+    ActionMap &bindControllerButton(ActionID action, SDL_GameControllerButton button);
+
+    /** @brief Binds a key pair to @p axis: @p negative gives -1, @p positive gives +1 */
+    ActionMap &bindKeyAxis(AxisID axis, SDL_Scancode negative, SDL_Scancode positive, float scale = 1.0f);
+    ActionMap &bindMouseAxis(AxisID axis, MouseAxis mouseAxis, float scale = 1.0f);
+    ActionMap &bindControllerAxis(AxisID                 axis,
+                                  SDL_GameControllerAxis controllerAxis,
+                                  float                  scale    = 1.0f,
+                                  float                  deadzone = 0.15f);
+
+    /** @brief Removes all bindings, actions and axes are kept */
+    void clearBindings();
+
+    /** @brief Builds the lookup tables, called by evaluate if bindings changed */
+    void compile();
+
+    /**
+     * @brief Evaluates bindings against @p sample and writes the result in @p state.
+     * Edge bits (pressed/released) are computed against the previous contents of
+     * @p state.
+     *
+     * @param sample device state for this frame
+     * @param state snapshot to update
+     */
+    void evaluate(const InputSample &sample, ActionState &state);
+
+    std::size_t        actionCount() const { return m_actionNames.size(); }
+    std::size_t        axisCount() const { return m_axisNames.size(); }
+    const std::string &actionName(ActionID id) const { return m_actionNames.at(id); }
+    const std::string &axisName(AxisID id) const { return m_axisNames.at(id); }
+};
+
+/** @} endgroup Input */
@@ -8,6 +8,7 @@
  * @{
  */
 
+#include <cstddef>
 #include <string>
 #include <stdexcept>
 
@@ -61,6 +62,9 @@ enum class InputEventType
     DropComplete             = SDL_DROPCOMPLETE
 };
 
+/** Number of entries in InputEventType */
+constexpr std::size_t InputEventTypeCount = 33;
+
 /** InputEventType enum to string conversion ( aka maintenance hell) */
 constexpr inline const char *to_string(const InputEventType &e)
 {
@@ -9,15 +9,40 @@
  */
 
 #include "../time.hpp"
+#include "actionMap.hpp"
 #include "../ecs/component.hpp"
 #include "../ecs/components/inputComponent.hpp"
 
 #include <SDL.h>
 #include <SDL_scancode.h>
 
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 
+class InputSampler;        /** Forward declaration to input sampling thread */
+class InputLatencyProbe;   /** Forward declaration to input latency probe */
+class FramePresentation;   /** Forward declaration to the renderer's presentation counters */
+
+/** Input event with the time it was taken from SDL */
+struct TimedInputEvent
+{
+    time_us   timestamp;
+    SDL_Event event;
+};
+
+/** Input-to-present latency percentiles reported by the latency probe */
+struct InputLatencyReport
+{
+    std::size_t samples = 0; /** synthetic events that reached a presented frame */
+    time_us     p50{0};
+    time_us     p90{0};
+    time_us     p99{0};
+    time_us     max{0};
+};
+
 /**
  * @brief Manager for all Input related system
  * @todo: maybe replace SDL_Scancode with our own type and reduce dependence on SDL2 (at least on upper levels)
@@ -25,10 +50,78 @@
  */
 class InputManager
 {
+public:
+    /**
+     * @brief Called right before the renderer builds view matrices
+     * @param state action snapshot re-sampled at late-latch time
+     * @param delta scaled delta time of the current frame
+     */
+    typedef std::function<void(const ActionState &state, const time_ms &delta)> LateLatchCallback;
+    typedef std::uint32_t                                                            LateLatchID;
+
 private:
+    /** InputComponent listener subscribed to an event type, component is null once removed */
+    struct Subscription
+    {
+        InputComponent                 *component;
+        const InputComponent::Listener *listener;
+    };
+
     const uint8_t         *m_keyState;
     std::vector<uint8_t>   m_lastFrameKeyState;
     std::vector<SDL_Event> m_inputEvents;
+    std::vector<time_us>   m_inputEventTimes; /** sample time of each entry in m_inputEvents */
+    time_us                m_currentEventTime{0};
+
+    /** Opened game controllers, SDL only reports controller events for open ones */
+    std::vector<SDL_GameController *> m_controllers;
+
+    /** Input sampling thread, only used with CONFIG_CORE_INPUT_THREAD */
+    std::unique_ptr<InputSampler> m_sampler;
+
+    ActionMap   m_actionMap;
+    ActionState m_actionState;
+    InputSample m_inputSample;
+
+    /** Subscribers indexed by input event slot, see inputEventSlot() */
+    std::array<std::vector<Subscription>, InputEventTypeCount> m_subscriptions;
+    /** Set while update calls listeners, unsubscribe then only disables subscriptions */
+    bool m_dispatching  = false;
+    bool m_unsubscribed = false;
+
+    /** Late-latch callbacks and the snapshot handed to them */
+    std::vector<std::pair<LateLatchID, LateLatchCallback>> m_lateLatchCallbacks;
+    LateLatchID                                            m_nextLateLatchID = 1;
+    ActionState                                            m_latchedState;
+    time_ms                                                m_frameDelta{0};
+    /** Events drained from the sampler at late-latch time, consumed by the next preUpdate */
+    std::vector<TimedInputEvent> m_latchedEvents;
+
+    /** Synthetic input injection for latency measurement, null unless started */
+    std::unique_ptr<InputLatencyProbe> m_probe;
+
+    /** Updates relative/controller device state from this frame's events */
+    void sampleDevices();
+
+    /** Opens controllers on device add and closes them on removal */
+    void openController(int deviceIndex);
+    void closeController(SDL_JoystickID instanceID);
+
+    /** Hands probe events in m_inputEvents to the latency probe and removes them */
+    void filterProbeEvents();
+
+    /**
+     * @brief Adds @p listener of @p component to the subscribers of @p event
+     * Called by InputComponent::setListener
+     */
+    void subscribe(InputComponent *component, const InputEventType event, const InputComponent::Listener *listener);
+
+    /**
+     * @brief Removes all subscriptions of @p component
+     * Called when an InputComponent with listeners is moved or destroyed. During
+     * dispatch the subscriptions are only disabled and erased once it ends.
+     */
+    void unsubscribe(InputComponent *component);
 
     /** InputManager is a singleton */
     InputManager();
@@ -53,11 +146,72 @@ public:
     void update(const time_ms &delta);
     void postUpdate();
     void refresh();
+    /** Stops the input sampling thread and latency probe if running, closes controllers */
+    void clean();
+
+    /**
+     * @brief Re-samples input right before rendering and runs the late-latch callbacks.
+     *
+     * With CONFIG_CORE_INPUT_LATE_LATCH, events are pumped again and polled device
+     * state (keys, buttons) is re-evaluated into a separate snapshot so anything
+     * pressed since preUpdate already affects this frame. The frame snapshot from
+     * @ref actions is left untouched, pressed/released edges are still reported to
+     * gameplay code on the next frame. Relative mouse motion is not re-sampled,
+     * its events are only consumed once in preUpdate.
+     *
+     * Called by Game between Renderer::renderBegin and Renderer::render.
+     */
+    void lateLatch();
+
+    /**
+     * @brief Registers @p callback to run at late-latch time, e.g. to update camera
+     * orientation from the freshest input. Callbacks must only touch state that is
+     * read by the renderer.
+     *
+     * @return LateLatchID id used to remove the callback
+     */
+    LateLatchID addLateLatchCallback(LateLatchCallback callback);
+    void        removeLateLatchCallback(LateLatchID id);
+
+    /**
+     * @brief Called by Game after Renderer::renderEnd, used by the latency probe.
+     * Probe events consumed by this frame are timed once @p presentation reports
+     * the frame as presented, which may be frames later with a render thread.
+     */
+    void frameSubmitted(const FramePresentation &presentation);
+
+    /**
+     * @brief Starts injecting synthetic key events every @p interval (jittered by
+     * +-50%) and measures the time until the frame that consumed each of them was
+     * presented. Can also be started by setting CORE_INPUT_LATENCY_PROBE to the
+     * interval in milliseconds.
+     */
+    void startLatencyProbe(time_us interval);
+
+    /** @brief Stops the latency probe, logs and returns the measured percentiles */
+    InputLatencyReport stopLatencyProbe();
+
+    /** @brief Percentiles measured so far, empty if the probe is not running */
+    InputLatencyReport latencyReport() const;
 
     bool isPressed(const SDL_Scancode scanCode);
     bool isTapped(const SDL_Scancode scanCode);
     bool getKeyUp(const SDL_Scancode scanCode);
     bool getKeyDown(const SDL_Scancode scanCode);
+
+    /** @brief Action bindings, evaluated once per frame in preUpdate */
+    ActionMap &actionMap() { return m_actionMap; }
+    /**
+     * @brief Time the event currently being dispatched to listeners was sampled.
+     * With CONFIG_CORE_INPUT_THREAD this has sub-frame resolution, otherwise it's
+     * the time InputManager took the event from SDL.
+     */
+    time_us currentEventTime() const { return m_currentEventTime; }
+
+    /** @brief Action snapshot for the current frame */
+    const ActionState &actions() const { return m_actionState; }
+
+    friend InputComponent;
 };
 
 /** @} endgroup Input */
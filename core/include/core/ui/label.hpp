@@ -8,33 +8,79 @@
  * @{
  */
 
+#include "text/textBatch.hpp"
+#include "text/textLayout.hpp"
+
 #include <glm/glm.hpp>
 
+#include <memory>
+#include <string>
+
 namespace core::ui
 {
 
     /**
-     * @brief The Label enables to play/hear audio
+     * @brief The Label shows a line or block of text
      *
+     * The text is shaped by a TextLayout on the first @ref update after a
+     * change and added to a TextBatch, where it is drawn with every other label
+     * of the batch. A label that doesn't change only checks that its glyphs are
+     * still cached on update, its quads stay in the batch's mesh.
      */
     class Label
     {
     private:
-        glm::vec2 m_rectPos;
-        glm::vec2 m_rectSize;
+        TextLayout       &m_textLayout;
+        TextBatch        &m_textBatch;
+        TextBatch::Handle m_handle;
+
+        std::string        m_text;
+        GlyphCache::FontID m_font      = 0;
+        std::uint32_t      m_size      = 16;
+        float              m_wrapWidth = 0.0f;
+        glm::vec4          m_color{1.0f};
+        glm::mat4          m_model{1.0f};
+
+        std::shared_ptr<const TextLayout::Layout> m_layout;
+        bool                                      m_shape  = true; /** text, font, size or wrap width changed */
+        bool                                      m_placed = true; /** color or model changed */
     protected:
-        /** Protected Constructors (use entity to add components) */
-        Label();
-        Label(const glm::vec2& rectPos, const glm::vec2& rectSize);
     public:
+        /**
+         * @param textLayout shapes and caches the text
+         * @param textBatch batch the label is drawn in, must outlive the label
+         */
+        Label(TextLayout &textLayout, TextBatch &textBatch);
 
         ~Label();
         Label(Label &o)             = delete;
         Label &operator=(Label &o)  = delete;
-        Label(Label &&o)            = default;
-        Label &operator=(Label &&o) = default;
+        Label(Label &&o)            = delete;
+        Label &operator=(Label &&o) = delete;
+
+        /** @brief Sets the UTF-8 text, '\n' starts a new line */
+        Label &setText(const std::string &text);
+        Label &setFont(GlyphCache::FontID font);
+        /** @brief Sets the pixel height of the glyphs */
+        Label &setSize(std::uint32_t size);
+        /** @brief Breaks lines between words to fit @p width pixels, 0 to disable */
+        Label &setWrapWidth(float width);
+        /** @brief Sets the color multiplied with the glyphs */
+        Label &setColor(const glm::vec4 &color);
+        /** @brief Sets the transform from layout pixels to world space, see TextLayout */
+        Label &setModel(const glm::mat4 &model);
+
+        /**
+         * @brief Shapes the text if it changed or its glyphs were evicted and
+         * updates the batch. Call once per frame before building the batch.
+         */
+        void update();
+
+        const std::string &getText() const noexcept { return m_text; }
+        /** @brief Size of the shaped text in pixels, valid after @ref update */
+        glm::vec2 getSize() const noexcept { return m_layout ? m_layout->size : glm::vec2(0.0f); }
     };
 
-} // namespace core::graphics
+} // namespace core::ui
 
-/** @} endgroup Components */
+/** @} endgroup UI */
@@ -78,6 +78,19 @@ namespace core::ui
         FontLoader &setFontKerning(bool enable);
         FontLoader &setFontOutline(const int &outline);
         FontLoader &setFontStyle();
+        /**
+         * @brief Renders glyphs on the shared JobPool, each worker with its own
+         * FreeType face. Enabled by default, the glyphs are the same either way.
+         */
+        FontLoader &setParallel(bool enable);
+
+        /**
+         * @brief Renders the glyphs of the open font without packing them in an
+         * atlas, valid until the next call or @ref generateFont
+         *
+         * @throw std::runtime_error if a glyph can't be rendered
+         */
+        const std::vector<Glyph> &generateGlyphs();
 
         core::assets::Font generateFont();
 
@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file core/ui/text/glyphCache.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup UI
+ * @{
+ */
+
+#include <core/graphics/asset-manager.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace core::ui
+{
+    /**
+     * @brief Rasterizes glyphs on first use into shared atlas pages
+     *
+     * Glyphs are keyed by (font, pixel size, code point), any Unicode code point
+     * the font maps can be used. A missing glyph is rendered with FreeType and
+     * copied into a page; pages are split in shelves of similar glyph heights
+     * and are added as needed up to the memory budget. Once the budget is
+     * reached the least recently used glyphs are evicted to make room, glyphs
+     * used in the current frame are never evicted.
+     *
+     * New glyphs are only written to the page pixels, @ref update uploads the
+     * rows of the shelves that changed at most once per frame. Not thread-safe.
+     */
+    class GlyphCache
+    {
+    public:
+        typedef std::uint16_t FontID;
+
+        struct Settings
+        {
+            std::uint32_t pageSize     = 512;             /** page width and height */
+            std::size_t   memoryBudget = 8 * 1024 * 1024; /** bytes of page pixels, at least one page */
+            std::uint32_t padding      = 1;               /** pixels kept free around each glyph */
+            bool          sdf          = true;            /** render signed distance fields */
+        };
+
+        struct Glyph
+        {
+            AssetID     texture = -1; /** page texture, -1 for glyphs without pixels */
+            std::size_t page    = 0;
+            glm::vec4   uvRect{0.0f}; /** u0, v0, u1, v1 */
+            glm::ivec2  size{0};      /** bitmap size in pixels */
+            glm::ivec2  bearing{0};   /** offset from the pen position to the bitmap's top-left */
+            float       advance = 0;  /** pen advance in pixels */
+        };
+
+        struct Stats
+        {
+            std::size_t glyphs      = 0; /** cached glyphs */
+            std::size_t pages       = 0;
+            std::size_t bytes       = 0; /** bytes of page pixels */
+            std::size_t hits        = 0;
+            std::size_t misses      = 0; /** glyphs rasterized */
+            std::size_t evictions   = 0;
+            std::size_t uploads     = 0; /** page uploads */
+            std::size_t uploadBytes = 0; /** bytes of page pixels uploaded */
+        };
+
+    private:
+        struct Internal;
+        std::unique_ptr<Internal> m_internal;
+
+    protected:
+    public:
+        GlyphCache(AssetManager &assetManager);
+        GlyphCache(AssetManager &assetManager, const Settings &settings);
+        ~GlyphCache();
+        GlyphCache(GlyphCache &o)             = delete;
+        GlyphCache &operator=(GlyphCache &o)  = delete;
+        GlyphCache(GlyphCache &&o);
+        GlyphCache &operator=(GlyphCache &&o);
+
+        /**
+         * @brief Opens the font asset @p name, fonts already open are reused
+         *
+         * @throw std::runtime_error if the font can't be opened
+         */
+        FontID loadFont(const AssetName &name);
+
+        /**
+         * @brief Opens the font in @p file under @p name, fonts already open are reused
+         *
+         * @param name name the font is reused by
+         * @param file font file contents, kept alive while the font is open
+         * @throw std::runtime_error if the font can't be opened
+         */
+        FontID loadFont(const AssetName &name, AssetSpan file);
+
+        /**
+         * @brief Retrieves a glyph, rasterizing it if it isn't cached. Code points
+         * missing from the font give the font's missing glyph.
+         *
+         * @param font font from @ref loadFont
+         * @param size pixel height
+         * @param codepoint Unicode code point
+         * @return the glyph, texture coordinates are valid once @ref update uploads its page
+         */
+        Glyph get(FontID font, std::uint32_t size, char32_t codepoint);
+
+        /** @brief Horizontal kerning between two code points in pixels, 0 if the font has none */
+        float kerning(FontID font, std::uint32_t size, char32_t left, char32_t right);
+
+        /** @brief Distance between two baselines in pixels */
+        float lineHeight(FontID font, std::uint32_t size);
+
+        /**
+         * @brief Uploads the pages changed since the last call and starts a new
+         * frame for the LRU. Call once per frame before rendering.
+         */
+        void update();
+
+        /** @brief Drops all glyphs, pages are kept */
+        void clear();
+
+        /**
+         * @brief Changes whenever glyphs are evicted or cleared. Glyphs retrieved
+         * under an older generation may no longer be on their page.
+         */
+        std::uint64_t generation() const noexcept;
+
+        const Stats    &stats() const noexcept;
+        const Settings &settings() const noexcept;
+    };
+} // namespace core::ui
+
+/** @} endgroup UI */
@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * @file core/ui/text/textBatch.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup UI
+ * @{
+ */
+
+#include "textLayout.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace core::ui
+{
+    /**
+     * @brief Merges the glyph quads of many texts into one vertex buffer
+     *
+     * Each text is a layout placed by a model matrix. @ref build writes the quads
+     * of all texts grouped by glyph page into a @ref Mesh, one @ref Run per page,
+     * so the whole batch draws with one draw call per page. The mesh is only
+     * rebuilt after a text changed; until then build returns the same mesh and
+     * renderers can keep its vertices uploaded.
+     */
+    class TextBatch
+    {
+    public:
+        typedef std::uint32_t Handle;
+
+        /** Vertex layout of text, same as batched sprites */
+        struct Vertex
+        {
+            glm::vec3     position; /** world space */
+            glm::vec2     uv;
+            std::uint32_t color; /** RGBA8 */
+        };
+
+        struct Run
+        {
+            AssetID     texture;
+            std::size_t first; /** first quad */
+            std::size_t count; /** quads */
+        };
+
+        /** Snapshot of the batch, never modified while shared */
+        struct Mesh
+        {
+            std::vector<Vertex> vertices;    /** 4 per quad, counter-clockwise from the bottom-left */
+            std::vector<Run>    runs;        /** ordered by texture */
+            std::uint64_t       version = 0; /** unique across batches, changes on every rebuild */
+
+            std::size_t quads() const noexcept { return vertices.size() / 4; }
+        };
+
+    private:
+        struct Text
+        {
+            std::shared_ptr<const TextLayout::Layout> layout;
+            glm::mat4                                 model{1.0f};
+            std::uint32_t                             color = 0xffffffff;
+            bool                                      used  = false;
+        };
+
+        std::vector<Text>                            m_texts;
+        std::vector<Handle>                          m_free;
+        std::vector<std::pair<AssetID, std::size_t>> m_pages; /** (texture, next quad) while building */
+        std::shared_ptr<Mesh>                        m_mesh;
+        bool                                         m_dirty = true;
+
+    protected:
+    public:
+        TextBatch();
+        ~TextBatch();
+        TextBatch(TextBatch &o)             = delete;
+        TextBatch &operator=(TextBatch &o)  = delete;
+        TextBatch(TextBatch &&o)            = default;
+        TextBatch &operator=(TextBatch &&o) = default;
+
+        /** @brief Adds an empty text */
+        Handle add();
+
+        /**
+         * @brief Sets the contents of a text
+         *
+         * @param handle text from @ref add
+         * @param layout glyph quads, null to show nothing
+         * @param model transform from layout pixels to world space
+         * @param color tint multiplied with the glyphs
+         */
+        void set(Handle                                           handle,
+                 const std::shared_ptr<const TextLayout::Layout> &layout,
+                 const glm::mat4                                 &model,
+                 const glm::vec4                                 &color);
+
+        /** @brief Removes a text, its handle may be returned by a later @ref add */
+        void remove(Handle handle);
+
+        /**
+         * @brief Returns the mesh of all texts, rebuilding it if a text changed
+         * since the last call
+         */
+        std::shared_ptr<const Mesh> build();
+
+        /** @brief Number of texts */
+        std::size_t size() const noexcept { return m_texts.size() - m_free.size(); }
+    };
+} // namespace core::ui
+
+/** @} endgroup UI */
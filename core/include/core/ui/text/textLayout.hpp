@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file core/ui/text/textLayout.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup UI
+ * @{
+ */
+
+#include "glyphCache.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core::ui
+{
+    /**
+     * @brief Shapes strings into glyph quads and caches the result
+     *
+     * Layouts are keyed by (text, font, size, wrap width), shaping the same text
+     * again returns the cached layout without touching the glyphs. Layouts hold
+     * texture coordinates of the GlyphCache, a layout made under an older
+     * @ref GlyphCache::generation is shaped again on its next request.
+     *
+     * Positions are in pixels with y up, the baseline of the first line starts
+     * at (0, 0) and following lines go down by the font's line height. Text is
+     * UTF-8, '\n' starts a new line. Not thread-safe.
+     */
+    class TextLayout
+    {
+    public:
+        struct Settings
+        {
+            std::size_t maxEntries = 512; /** cached layouts, least recently used are dropped first */
+        };
+
+        struct Quad
+        {
+            AssetID   texture; /** glyph page */
+            glm::vec2 min;     /** bottom-left corner */
+            glm::vec2 max;     /** top-right corner */
+            glm::vec4 uvRect;  /** u0, v0, u1, v1 */
+        };
+
+        struct Layout
+        {
+            std::vector<Quad> quads;          /** glyphs with pixels in text order */
+            glm::vec2         size{0.0f};     /** widest line and height of all lines */
+            std::size_t       lines      = 0;
+            std::uint64_t     generation = 0; /** GlyphCache generation the quads are valid for */
+        };
+
+        struct Stats
+        {
+            std::size_t entries = 0;
+            std::size_t hits    = 0;
+            std::size_t misses  = 0; /** layouts shaped */
+        };
+
+    private:
+        struct Key
+        {
+            std::string        text;
+            GlyphCache::FontID font;
+            std::uint32_t      size;
+            float              wrapWidth;
+
+            bool operator==(const Key &o) const
+            {
+                return font == o.font && size == o.size && wrapWidth == o.wrapWidth && text == o.text;
+            }
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key &key) const;
+        };
+
+        struct Entry
+        {
+            std::shared_ptr<const Layout>    layout;
+            std::list<const Key *>::iterator lru;
+        };
+
+        GlyphCache                             &m_glyphCache;
+        Settings                                m_settings;
+        std::unordered_map<Key, Entry, KeyHash> m_entries;
+        std::list<const Key *>                  m_lru; /** most recently used first */
+        Stats                                   m_stats;
+
+        std::shared_ptr<const Layout> shape(const Key &key);
+
+    protected:
+    public:
+        TextLayout(GlyphCache &glyphCache);
+        TextLayout(GlyphCache &glyphCache, const Settings &settings);
+        ~TextLayout();
+        TextLayout(TextLayout &o)            = delete;
+        TextLayout &operator=(TextLayout &o) = delete;
+
+        /**
+         * @brief Retrieves the layout of @p text, shaping it if it isn't cached
+         *
+         * @param text UTF-8 text
+         * @param font font from GlyphCache::loadFont
+         * @param size pixel height
+         * @param wrapWidth lines are broken between words to fit this width, 0 to disable
+         * @return the layout, kept alive by the caller even once dropped from the cache
+         */
+        std::shared_ptr<const Layout> layout(const std::string &text,
+                                             GlyphCache::FontID font,
+                                             std::uint32_t      size,
+                                             float              wrapWidth = 0.0f);
+
+        /** @brief Checks if the quads of @p layout still match the glyph pages */
+        bool valid(const Layout &layout) const noexcept;
+
+        /** @brief Drops all cached layouts */
+        void clear();
+
+        GlyphCache     &glyphCache() noexcept { return m_glyphCache; }
+        const Stats    &stats() const noexcept { return m_stats; }
+        const Settings &settings() const noexcept { return m_settings; }
+    };
+} // namespace core::ui
+
+/** @} endgroup UI */
@@ -12,7 +12,9 @@
 #include "../ecs/component.hpp"
 
 #include <memory>
+#include <vector>
 #include <core/assets/font.hpp>
+#include <core/ui/text/textBatch.hpp>
 
 /**
  * @brief Manager for all UI related system
@@ -20,7 +22,16 @@
  */
 class UIManager
 {
+public:
+    struct TextBatchEntry
+    {
+        core::ui::TextBatch *batch;
+        AssetID              pipeline;
+    };
+
 private:
+    std::vector<TextBatchEntry> m_textBatches;
+
     /** UIManager is a singleton */
     UIManager();
 protected:
@@ -46,6 +57,19 @@ public:
     void refresh();
 
     core::assets::Font loadFont(const AssetName &name);
+
+    /**
+     * @brief Draws the labels of @p batch every frame until it is removed
+     *
+     * @param batch text batch, must stay alive until removed
+     * @param pipeline pipeline with the sprite vertex layout, "text" for
+     * signed distance field glyphs
+     */
+    void addTextBatch(core::ui::TextBatch &batch, AssetID pipeline);
+    void removeTextBatch(core::ui::TextBatch &batch);
+
+    /** @brief Text batches extracted into each frame packet */
+    const std::vector<TextBatchEntry> &getTextBatches() const noexcept { return m_textBatches; }
 };
 
 /** @} endgroup UI */
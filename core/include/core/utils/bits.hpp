@@ -0,0 +1,41 @@
+#pragma once
+
+/**
+ * @file core/utils/bits.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Utils
+ * @{
+ */
+
+#include <cstdint>
+
+#if __cplusplus >= 202002L
+#include <bit>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace core::utils
+{
+    /**
+     * @brief Number of zero bits below the lowest set bit of @p value, i.e. the
+     * index of that bit. Shim for C++20 std::countr_zero.
+     *
+     * @param value must not be 0
+     */
+    inline unsigned int countr_zero(std::uint32_t value) noexcept
+    {
+#if __cplusplus >= 202002L
+        return static_cast<unsigned int>(std::countr_zero(value));
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<unsigned int>(index);
+#else
+        return static_cast<unsigned int>(__builtin_ctz(value));
+#endif
+    }
+} // namespace core::utils
+
+/** @} endgroup Utils */
@@ -11,6 +11,9 @@
  */
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 namespace core::utils
 {
@@ -23,6 +26,41 @@ namespace core::utils
         seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
         hash_combine(seed, hashValues...);
     }
+
+    /**
+     * @brief 64-bit FNV-1a hash, usable in constant expressions so identifiers
+     * can be hashed at compile time
+     *
+     * @param str string to hash
+     * @return std::uint64_t hash of @p str
+     */
+    constexpr std::uint64_t hash_fnv1a(std::string_view str) noexcept
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : str)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Compile-time identifier for type @p T, stable across shared library
+     * boundaries since it's derived from the type's name
+     *
+     * @tparam T type to identify
+     * @return std::uint64_t identifier for @p T
+     */
+    template <typename T>
+    constexpr std::uint64_t type_hash() noexcept
+    {
+#if defined(_MSC_VER)
+        return hash_fnv1a(__FUNCSIG__);
+#else
+        return hash_fnv1a(__PRETTY_FUNCTION__);
+#endif
+    }
 } // namespace core::utils
 
-/** @} endgroup JSON */
\ No newline at end of file
+/** @} endgroup Hash */
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file core/utils/jobs.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @defgroup Jobs
+ * @brief Worker threads for CPU work that can run off the game thread
+ * @ingroup Utils
+ * @{
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace core::utils
+{
+    /**
+     * @brief Fixed set of worker threads running jobs in submission order
+     *
+     * Jobs must not touch state owned by the game or render threads (GL objects,
+     * components) without their own synchronization. Threads waiting on
+     * @ref parallelFor run queued jobs meanwhile, so jobs may use it too.
+     */
+    class JobPool
+    {
+    private:
+        std::vector<std::thread>          m_workers;
+        std::deque<std::function<void()>> m_jobs;
+        std::mutex                        m_mutex;
+        std::condition_variable           m_cv;
+        bool                              m_stop = false;
+
+        void push(std::function<void()> job);
+        /** Runs one queued job on the calling thread, false if there was none */
+        bool runOne();
+        void run();
+
+    protected:
+    public:
+        /**
+         * @param workers worker threads, 0 uses CONFIG_CORE_JOB_WORKERS or one
+         * less than the hardware threads
+         */
+        JobPool(std::size_t workers = 0);
+        ~JobPool();
+        JobPool(JobPool &o)             = delete;
+        JobPool(JobPool &&o)            = delete;
+        JobPool &operator=(JobPool &o)  = delete;
+        JobPool &operator=(JobPool &&o) = delete;
+
+        /** @brief Shared pool, created on first use */
+        static JobPool &getInstance();
+
+        /** @brief Number of worker threads */
+        std::size_t size() const noexcept { return m_workers.size(); }
+
+        /**
+         * @brief Queues @p job
+         *
+         * @return future of the job's result, exceptions are rethrown by get()
+         */
+        template <typename F>
+        std::future<std::invoke_result_t<F>> submit(F &&job)
+        {
+            auto task   = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(job));
+            auto result = task->get_future();
+            push([task]() { (*task)(); });
+            return result;
+        }
+
+        /**
+         * @brief Calls @p job for each index in [0, count) across the workers and
+         * the calling thread, returns once all calls are done
+         *
+         * @throw rethrows the first exception thrown by @p job, after all calls finished
+         */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t index)> &job);
+    };
+} // namespace core::utils
+
+/** @} endgroup Jobs */
@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file core/utils/lz4.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @defgroup LZ4
+ * @brief LZ4 block compression, compatible with the reference LZ4 block format
+ * @ingroup Utils
+ * @{
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace core::utils::lz4
+{
+    /** @brief Largest block @ref compress can produce for @p size bytes */
+    constexpr std::size_t compressBound(std::size_t size) noexcept { return size + size / 255 + 16; }
+
+    /**
+     * @brief Compresses @p size bytes of @p src into one LZ4 block
+     *
+     * Greedy single pass matcher, fast enough to pack assets at build time.
+     * Blocks must be smaller than 4 GiB.
+     */
+    std::vector<char> compress(const char *src, std::size_t size);
+
+    /**
+     * @brief Decompresses one LZ4 block
+     *
+     * @param dstSize exact decompressed size, blocks don't store it
+     * @return false if the block is malformed or doesn't decompress to @p dstSize bytes
+     */
+    bool decompress(const char *src, std::size_t srcSize, char *dst, std::size_t dstSize) noexcept;
+} // namespace core::utils::lz4
+
+/** @} endgroup LZ4 */
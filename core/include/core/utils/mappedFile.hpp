@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ * @file core/utils/mappedFile.hpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * @addtogroup Utils
+ * @{
+ */
+
+#include <cstddef>
+#include <string>
+
+namespace core::utils
+{
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Pages are loaded by the OS on first access and shared with every other
+     * mapping of the file, so reading assets through a mapping costs no copy.
+     * The file must not be truncated while mapped.
+     */
+    class MappedFile
+    {
+    private:
+        const char *m_data = nullptr;
+        std::size_t m_size = 0;
+#ifdef _WIN32
+        void *m_mapping = nullptr; /** file mapping handle */
+#endif
+
+        void unmap() noexcept;
+
+    protected:
+    public:
+        MappedFile();
+        /**
+         * @brief Maps @p path
+         *
+         * @throw std::runtime_error if the file can't be opened or mapped
+         */
+        MappedFile(const std::string &path);
+        ~MappedFile();
+        MappedFile(MappedFile &o)            = delete;
+        MappedFile &operator=(MappedFile &o) = delete;
+        MappedFile(MappedFile &&o) noexcept;
+        MappedFile &operator=(MappedFile &&o) noexcept;
+
+        /** @brief First byte of the file, nullptr if nothing is mapped or the file is empty */
+        const char *data() const noexcept { return m_data; }
+        std::size_t size() const noexcept { return m_size; }
+        bool        empty() const noexcept { return m_size == 0; }
+    };
+} // namespace core::utils
+
+/** @} endgroup Utils */
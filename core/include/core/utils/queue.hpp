@@ -20,7 +20,7 @@ namespace core::utils
     /**
      * @brief Wrapper class for thread safe std::queue + mutex
      * @ingroup Queue
-     * @todo: maybe replace with a lock-free queue? is it worth it? check latency
+     * @note: compare against the lock-free queues with the queue_bench example
      */
     template <typename _T>
     class mutex_queue
@@ -99,6 +99,9 @@ namespace core::utils
 #if defined(CONFIG_CORE_QUEUE_LOCKFREE_ENABLE)
 
 #include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace core::utils
 {
@@ -227,7 +230,7 @@ namespace core::utils
             {
                 // weak check that we are not behind head
                 unsigned int head = std::atomic_load_explicit(&_head, std::memory_order_relaxed);
-                if ((tail % _bufsize) - (head % _bufsize) >= _bufsize) return false;
+                if (tail - head >= _bufsize) return false;
             } while (!std::atomic_compare_exchange_weak_explicit(&_tail,
                                                                  &tail,
                                                                  tail + 1,
@@ -271,7 +274,7 @@ namespace core::utils
             {
                 // weak check that we are not behind head
                 unsigned int head = std::atomic_load_explicit(&_head, std::memory_order_relaxed);
-                if ((tail % _bufsize) - (head % _bufsize) >= _bufsize) return false;
+                if (tail - head >= _bufsize) return false;
             } while (!std::atomic_compare_exchange_weak_explicit(&_tail,
                                                                  &tail,
                                                                  tail + 1,
@@ -343,6 +346,247 @@ namespace core::utils
         }
     };
 
+    /**
+     * @brief Bounded single-producer single-consumer ring buffer
+     * @ingroup Queue
+     *
+     * Wait-free as long as only one thread pushes and one thread pops. Head and tail
+     * live on separate cache lines, and each side keeps a cached copy of the opposite
+     * index so the shared line is only touched when the cached value says the ring is
+     * full (producer) or empty (consumer). Only acquire/release ordering is used.
+     *
+     * @tparam _T type of element
+     * @tparam _N capacity of the ring, must be a power of two
+     */
+    template <typename _T, std::size_t _N>
+    class spsc_ring
+    {
+    private:
+        static constexpr std::size_t _cacheline = 64;
+        static constexpr std::size_t _mask      = _N - 1;
+
+        static_assert(_N >= 2 && (_N & (_N - 1)) == 0, "spsc_ring capacity must be a power of two");
+        static_assert(std::is_move_assignable<_T>::value, "spsc_ring requires a move assignable type");
+
+        /** consumer side: owned index and cached producer index */
+        alignas(_cacheline) std::atomic<std::size_t> _head{0};
+        std::size_t _cachedTail = 0;
+        /** producer side: owned index and cached consumer index */
+        alignas(_cacheline) std::atomic<std::size_t> _tail{0};
+        std::size_t _cachedHead = 0;
+
+        alignas(_cacheline) _T _nodes[_N] = {};
+
+        template <typename _U>
+        bool _push(_U &&o) noexcept
+        {
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cachedHead >= _N)
+            {
+                // looks full, refresh our view of the consumer
+                _cachedHead = _head.load(std::memory_order_acquire);
+                if (tail - _cachedHead >= _N) return false;
+            }
+            _nodes[tail & _mask] = std::forward<_U>(o);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+    protected:
+    public:
+        typedef _T value_type;
+
+        spsc_ring()                             = default;
+        spsc_ring(const spsc_ring &)            = delete;
+        spsc_ring &operator=(const spsc_ring &) = delete;
+        spsc_ring(spsc_ring &&)                 = delete;
+        spsc_ring &operator=(spsc_ring &&)      = delete;
+
+        /** @brief Capacity of the ring */
+        static constexpr std::size_t capacity() noexcept { return _N; }
+
+        /**
+         * @brief Checks whether the ring was empty at time of call.
+         *
+         * @return true if the ring is empty
+         * @return false if the ring is not empty
+         */
+        bool was_empty() const noexcept { return was_size() == 0; }
+
+        /**
+         * @brief Retrieves the count of elements in the ring at time of calling.
+         *
+         * @return std::size_t count of elements in ring
+         */
+        std::size_t was_size() const noexcept
+        {
+            const std::size_t head = _head.load(std::memory_order_acquire);
+            const std::size_t tail = _tail.load(std::memory_order_acquire);
+            return tail - head;
+        }
+
+        /**
+         * @brief Push data to the ring. Must only be called from the producer thread.
+         *
+         * @param o data to be added
+         * @return true if the data was added
+         * @return false if the ring is full
+         */
+        bool try_push(const _T &o) noexcept { return _push(o); }
+
+        /** @copydoc try_push(const _T &) */
+        bool try_push(_T &&o) noexcept { return _push(std::move(o)); }
+
+        /**
+         * @brief Pop data from the ring. Must only be called from the consumer thread.
+         *
+         * @param o where to store the popped data
+         * @return true if data was popped
+         * @return false if the ring is empty
+         */
+        bool try_pop(_T &o) noexcept
+        {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _cachedTail)
+            {
+                // looks empty, refresh our view of the producer
+                _cachedTail = _tail.load(std::memory_order_acquire);
+                if (head == _cachedTail) return false;
+            }
+            o = std::move(_nodes[head & _mask]);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    /**
+     * @brief Intrusive hook for @ref mpsc_queue. Elements pushed into an mpsc_queue
+     * must derive from this.
+     * @ingroup Queue
+     */
+    struct mpsc_node
+    {
+        std::atomic<mpsc_node *> _next{nullptr};
+    };
+
+    /**
+     * @brief Unbounded intrusive multi-producer single-consumer queue
+     * @ingroup Queue
+     *
+     * Dmitry Vyukov's MPSC node queue. Producers only do a single exchange on the
+     * shared tail and never wait on each other or the consumer. The queue never
+     * allocates: nodes are owned by the caller and must outlive their time in the
+     * queue. try_pop can report empty while a producer is between its exchange and
+     * its link store; the element shows up on a later try_pop.
+     *
+     * @tparam _T type of element, must derive from @ref mpsc_node
+     */
+    template <typename _T>
+    class mpsc_queue
+    {
+    private:
+        static constexpr std::size_t _cacheline = 64;
+
+        static_assert(std::is_base_of<mpsc_node, _T>::value, "mpsc_queue requires elements derived from mpsc_node");
+
+        /** producers exchange on _tail, the consumer walks from _head */
+        alignas(_cacheline) std::atomic<mpsc_node *> _tail;
+        alignas(_cacheline) mpsc_node *_head;
+        mpsc_node _stub;
+
+        void _push(mpsc_node *n) noexcept
+        {
+            n->_next.store(nullptr, std::memory_order_relaxed);
+            mpsc_node *prev = _tail.exchange(n, std::memory_order_acq_rel);
+            prev->_next.store(n, std::memory_order_release);
+        }
+    protected:
+    public:
+        typedef _T *value_type;
+
+        mpsc_queue() : _tail(&_stub), _head(&_stub) {}
+        mpsc_queue(const mpsc_queue &)            = delete;
+        mpsc_queue &operator=(const mpsc_queue &) = delete;
+        mpsc_queue(mpsc_queue &&)                 = delete;
+        mpsc_queue &operator=(mpsc_queue &&)      = delete;
+
+        /**
+         * @brief Checks whether the queue was empty at time of call.
+         * Must only be called from the consumer thread.
+         *
+         * @return true if the queue is empty
+         * @return false if the queue is not empty
+         */
+        bool was_empty() const noexcept
+        {
+            return _head == _tail.load(std::memory_order_acquire) && _head == &_stub;
+        }
+
+        /**
+         * @brief Retrieves the count of elements in queue at time of calling.
+         * Walks the list, must only be called from the consumer thread.
+         *
+         * @return std::size_t count of elements in queue
+         */
+        std::size_t was_size() const noexcept
+        {
+            std::size_t count = 0;
+            for (const mpsc_node *n = _head; n; n = n->_next.load(std::memory_order_acquire))
+                if (n != &_stub) count++;
+            return count;
+        }
+
+        /**
+         * @brief Push a node to the queue. Safe to call from any thread.
+         *
+         * @param o node to be added, must not be in any queue
+         * @return true always, the queue is unbounded
+         */
+        bool try_push(_T *o) noexcept
+        {
+            _push(static_cast<mpsc_node *>(o));
+            return true;
+        }
+
+        /**
+         * @brief Pop a node from the queue. Must only be called from the consumer thread.
+         *
+         * @param o where to store the popped node
+         * @return true if a node was popped
+         * @return false if no node was available
+         */
+        bool try_pop(_T *&o) noexcept
+        {
+            mpsc_node *head = _head;
+            mpsc_node *next = head->_next.load(std::memory_order_acquire);
+            if (head == &_stub)
+            {
+                // skip over the stub
+                if (!next) return false;
+                _head = next;
+                head  = next;
+                next  = next->_next.load(std::memory_order_acquire);
+            }
+            if (next)
+            {
+                _head = next;
+                o     = static_cast<_T *>(head);
+                return true;
+            }
+            // head is the last node, a producer may be mid-push
+            if (head != _tail.load(std::memory_order_acquire)) return false;
+            // re-insert the stub so head can be detached
+            _push(&_stub);
+            next = head->_next.load(std::memory_order_acquire);
+            if (next)
+            {
+                _head = next;
+                o     = static_cast<_T *>(head);
+                return true;
+            }
+            return false;
+        }
+    };
+
 } // namespace core::utils
 #endif
 
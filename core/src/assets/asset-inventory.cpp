@@ -1,5 +1,8 @@
 #include <core/assets/asset-inventory.hpp>
+#include <core/assets/assetPack.hpp>
 #include <core/utils/logging.hpp>
+#include <core/utils/lz4.hpp>
+#include <core/utils/mappedFile.hpp>
 #include <core/utils/platform.hpp>
 
 #include <filesystem>
@@ -19,6 +22,16 @@ static void normalizePathSeparators(std::string &path)
 
 /** @todo: dynamic scan of asset folder or have a manifest file? */
 
+/** Asset type of each subdirectory of assets, and whether names drop the file extension */
+static const std::unordered_map<std::string, std::pair<bool, AssetType>> assetTypeMap = {
+    {"audio",        {false, AssetType::Audio}      }, // no strip extension
+    {"models",       {false, AssetType::Mesh}       }, // no strip extension
+    {"shaders",      {true, AssetType::Pipeline}    }, // strip extension
+    {"textures",     {false, AssetType::Texture}    }, // no strip extension
+    {"spritesheets", {false, AssetType::SpriteSheet}}, // no strip extension
+    {"fonts",        {false, AssetType::Fonts}      }  // no strip extension
+};
+
 AssetInventory &AssetInventory::getInstance()
 {
     static AssetInventory instance;
@@ -33,49 +46,64 @@ AssetInventory::AssetInventory()
     fs::path projectDirectory = core::utils::platform::getProjectPath();
     assetsDirectory           = fs::path(projectDirectory).append("assets").string();
 
-    const std::unordered_map<std::string, std::pair<bool, AssetType>> assetTypeMap = {
-        {"audio",        {false, AssetType::Audio}      }, // no strip extension
-        {"models",       {false, AssetType::Mesh}       }, // no strip extension
-        {"shaders",      {true, AssetType::Pipeline}    }, // strip extension
-        {"textures",     {false, AssetType::Texture}    }, // no strip extension
-        {"spritesheets", {false, AssetType::SpriteSheet}}, // no strip extension
-        {"fonts",        {false, AssetType::Fonts}      }  // no strip extension
-    };
+#if defined(CONFIG_CORE_ASSET_PACK)
+    // Assets in the pack take the place of loose files with the same path
+    fs::path packPath = projectDirectory / CONFIG_CORE_ASSET_PACK_FILE;
+    if (fs::exists(packPath))
+    {
+        try
+        {
+            pack = std::make_unique<core::assets::AssetPack>(packPath.string());
+            for (std::size_t i = 0; i < pack->size(); i++) addAsset(std::string(pack->name(pack->entry(i))));
+        }
+        catch (const std::exception &e)
+        {
+            L_WARN("Ignoring asset pack: {}", e.what());
+            pack.reset();
+            cache.clear();
+        }
+    }
+#endif
 
     // Scan assets folder
     L_TRACE("Scanning {}", assetsDirectory);
-    for (auto &dir : fs::directory_iterator(assetsDirectory))
+    if (fs::is_directory(assetsDirectory))
     {
-        if (!dir.is_directory()) continue;
-        std::string assetDir = dir.path().stem().string();
-
-        auto res = assetTypeMap.find(assetDir);
-        if (res != assetTypeMap.end())
+        for (const auto &path : fs::recursive_directory_iterator(assetsDirectory))
         {
-            L_TRACE("\tScanning subdirectory: {}", assetDir);
-            for (const auto &path : fs::recursive_directory_iterator(dir.path()))
-            {
-                if (path.is_directory()) continue;
-                std::string assetPath = fs::relative(path.path(), projectDirectory).string();
-                std::string assetName = fs::relative(path.path(), dir.path()).string();
-                // Strip extension if needed
-                if (res->second.first)
-                {
-                    assetName.erase(assetName.find_last_of('.'));
-                }
-
-                // Replace path separators for assetName if separators are not forward-slashes
-                normalizePathSeparators(assetName);
-
-                L_TRACE("\t\t{}: {}", assetName, assetPath);
-                cache[res->second.second][assetName].push_back(assetPath);
-            }
+            if (path.is_directory()) continue;
+            fs::path assetPath = fs::relative(path.path(), projectDirectory);
+            if (pack && pack->find(assetPath.generic_string())) continue;
+            addAsset(assetPath.string());
         }
     }
 
     L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
 }
 
+void AssetInventory::addAsset(const std::string &assetPath)
+{
+    // assets/<type>/<name>
+    fs::path path = assetPath;
+    auto     part = path.begin();
+    if (part == path.end() || *part++ != "assets" || part == path.end()) return;
+
+    auto res = assetTypeMap.find(part->string());
+    if (res == assetTypeMap.end() || ++part == path.end()) return;
+
+    fs::path name;
+    for (; part != path.end(); part++) name /= *part;
+    // Strip extension if needed
+    if (res->second.first) name.replace_extension();
+
+    // Replace path separators for assetName if separators are not forward-slashes
+    std::string assetName = name.string();
+    normalizePathSeparators(assetName);
+
+    L_TRACE("\t\t{}: {}", assetName, assetPath);
+    cache[res->second.second][assetName].push_back(assetPath);
+}
+
 AssetInventory::~AssetInventory() = default;
 
 void AssetInventory::loadInventory(const std::string &inventoryFile)
@@ -101,4 +129,34 @@ const std::vector<AssetPath> &AssetInventory::lookupAssets(const AssetType &type
     }
 
     L_THROW_RUNTIME("Could not find matching assets");
-}
\ No newline at end of file
+}
+
+bool AssetInventory::hasAsset(const AssetType &type, const AssetName &name) const
+{
+    auto assetList = cache.find(type);
+    return assetList != cache.end() && assetList->second.find(name) != assetList->second.end();
+}
+
+AssetSpan AssetInventory::openAsset(const AssetPath &path) const
+{
+    L_TAG("AssetInventory::openAsset");
+
+    const core::assets::AssetPack::Entry *entry = pack ? pack->find(fs::path(path).generic_string()) : nullptr;
+    if (!entry)
+    {
+        auto file = std::make_shared<core::utils::MappedFile>(path);
+        return AssetSpan(file->data(), file->size(), file);
+    }
+
+    // The pack lives as long as the inventory, stored assets are read in place
+    if (!(entry->flags & core::assets::AssetPack::Lz4))
+        return AssetSpan(pack->payload(*entry), static_cast<std::size_t>(entry->size));
+
+    auto buffer = std::make_shared<std::vector<char>>(static_cast<std::size_t>(entry->size));
+    if (!core::utils::lz4::decompress(pack->payload(*entry),
+                                      static_cast<std::size_t>(entry->storedSize),
+                                      buffer->data(),
+                                      buffer->size()))
+        L_THROW_RUNTIME("Corrupt asset in pack: {}", path);
+    return AssetSpan(buffer->data(), buffer->size(), buffer);
+}
@@ -0,0 +1,190 @@
+#include <core/assets/assetPack.hpp>
+#include <core/utils/hash.hpp>
+#include <core/utils/logging.hpp>
+#include <core/utils/lz4.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace core::assets
+{
+    static_assert(sizeof(AssetPack::Header) == 32 && sizeof(AssetPack::Entry) == 48, "Asset pack layout changed");
+
+    static std::size_t alignUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /** Orders entries by hash, then name, so equal hashes still have one place in the index */
+    static bool entryLess(std::uint64_t lhsHash,
+                          std::string_view lhsName,
+                          std::uint64_t rhsHash,
+                          std::string_view rhsName) noexcept
+    {
+        return lhsHash != rhsHash ? lhsHash < rhsHash : lhsName < rhsName;
+    }
+
+    AssetPack::AssetPack() = default;
+
+    AssetPack::AssetPack(const std::string &path)
+        : m_file(path)
+    {
+        L_TAG("AssetPack::AssetPack");
+
+        const char       *data   = m_file.data();
+        const std::size_t size   = m_file.size();
+        const Header     *header = reinterpret_cast<const Header *>(data);
+        if (size < sizeof(Header) || header->magic != magic || header->version != version)
+            L_THROW_RUNTIME("Not an asset pack: {}", path);
+
+        const std::size_t indexEnd = sizeof(Header) + static_cast<std::size_t>(header->entryCount) * sizeof(Entry);
+        if (indexEnd > size || header->namesOffset < indexEnd || header->namesOffset > size
+            || header->namesSize > size - header->namesOffset)
+            L_THROW_RUNTIME("Corrupt asset pack: {}", path);
+
+        const Entry *entries = reinterpret_cast<const Entry *>(data + sizeof(Header));
+        for (std::uint32_t i = 0; i < header->entryCount; i++)
+        {
+            const Entry &entry = entries[i];
+            if (static_cast<std::uint64_t>(entry.nameOffset) + entry.nameSize > header->namesSize
+                || entry.offset > size || entry.storedSize > size - entry.offset
+                || (!(entry.flags & Lz4) && entry.storedSize != entry.size))
+                L_THROW_RUNTIME("Corrupt asset pack: {}", path);
+        }
+
+        m_header  = header;
+        m_entries = entries;
+        m_names   = data + header->namesOffset;
+
+        L_DEBUG("Opened asset pack {} ({} assets, {} bytes)", path, header->entryCount, size);
+    }
+
+    AssetPack::~AssetPack() = default;
+
+    AssetPack::AssetPack(AssetPack &&o) { *this = std::move(o); }
+
+    AssetPack &AssetPack::operator=(AssetPack &&o)
+    {
+        if (this == &o) return *this;
+        m_file    = std::move(o.m_file);
+        m_header  = std::exchange(o.m_header, nullptr);
+        m_entries = std::exchange(o.m_entries, nullptr);
+        m_names   = std::exchange(o.m_names, nullptr);
+        return *this;
+    }
+
+    std::uint64_t AssetPack::hashName(std::string_view name) noexcept { return core::utils::hash_fnv1a(name); }
+
+    std::string_view AssetPack::name(const Entry &entry) const noexcept
+    {
+        return std::string_view(m_names + entry.nameOffset, entry.nameSize);
+    }
+
+    const AssetPack::Entry *AssetPack::find(std::string_view name) const noexcept
+    {
+        const std::uint64_t hash  = hashName(name);
+        const Entry        *begin = m_entries;
+        const Entry        *end   = m_entries + size();
+
+        const Entry *entry = std::lower_bound(begin, end, hash, [&](const Entry &e, std::uint64_t h) {
+            return entryLess(e.hash, this->name(e), h, name);
+        });
+        if (entry != end && entry->hash == hash && this->name(*entry) == name) return entry;
+        return nullptr;
+    }
+
+    void AssetPackWriter::add(const std::string &name, std::vector<char> data, bool compress)
+    {
+        m_pending.push_back({name, std::move(data), compress});
+    }
+
+    AssetPackWriter::Stats AssetPackWriter::write(const std::string &path) const
+    {
+        L_TAG("AssetPackWriter::write");
+
+        Stats stats;
+        stats.entries = m_pending.size();
+
+        /** names and entries, payload offsets are filled in once the index size is known */
+        std::string                   names;
+        std::vector<AssetPack::Entry> entries(m_pending.size());
+        std::vector<std::vector<char>> compressed(m_pending.size());
+        for (std::size_t i = 0; i < m_pending.size(); i++)
+        {
+            const Pending    &pending = m_pending[i];
+            AssetPack::Entry &entry   = entries[i];
+            entry                     = {};
+            entry.hash                = AssetPack::hashName(pending.name);
+            entry.nameOffset          = static_cast<std::uint32_t>(names.size());
+            entry.nameSize            = static_cast<std::uint32_t>(pending.name.size());
+            entry.size                = pending.data.size();
+            entry.storedSize          = pending.data.size();
+            names += pending.name;
+
+            if (pending.compress && !pending.data.empty())
+            {
+                std::vector<char> block = core::utils::lz4::compress(pending.data.data(), pending.data.size());
+                if (block.size() <= pending.data.size() - pending.data.size() / 8)
+                {
+                    entry.flags      = AssetPack::Lz4;
+                    entry.storedSize = block.size();
+                    compressed[i]    = std::move(block);
+                    stats.compressed++;
+                }
+            }
+            stats.size += entry.size;
+            stats.storedSize += entry.storedSize;
+        }
+
+        AssetPack::Header header = {};
+        header.magic             = AssetPack::magic;
+        header.version           = AssetPack::version;
+        header.entryCount        = static_cast<std::uint32_t>(entries.size());
+        header.namesOffset       = sizeof(AssetPack::Header) + entries.size() * sizeof(AssetPack::Entry);
+        header.namesSize         = names.size();
+
+        std::size_t offset = alignUp(header.namesOffset + names.size(), AssetPack::payloadAlignment);
+        for (AssetPack::Entry &entry : entries)
+        {
+            entry.offset = offset;
+            offset       = alignUp(offset + entry.storedSize, AssetPack::payloadAlignment);
+        }
+
+        /** the index is sorted, the payloads stay in the order they were added */
+        std::vector<std::size_t> order(entries.size());
+        for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return entryLess(entries[lhs].hash, m_pending[lhs].name, entries[rhs].hash, m_pending[rhs].name);
+        });
+        for (std::size_t i = 1; i < order.size(); i++)
+        {
+            if (m_pending[order[i - 1]].name == m_pending[order[i]].name)
+                L_THROW_RUNTIME("Duplicate asset in pack: {}", m_pending[order[i]].name);
+        }
+
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        if (!f) L_THROW_RUNTIME("Could not open {}", path);
+
+        f.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (std::size_t i : order) f.write(reinterpret_cast<const char *>(&entries[i]), sizeof(AssetPack::Entry));
+        f.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        static const char padding[AssetPack::payloadAlignment] = {};
+        std::size_t       written = header.namesOffset + names.size();
+        for (std::size_t i = 0; i < entries.size(); i++)
+        {
+            f.write(padding, static_cast<std::streamsize>(entries[i].offset - written));
+            const std::vector<char> &payload = entries[i].flags & AssetPack::Lz4 ? compressed[i] : m_pending[i].data;
+            f.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            written = entries[i].offset + payload.size();
+        }
+
+        f.close();
+        if (!f) L_THROW_RUNTIME("Could not write {}", path);
+
+        L_DEBUG("Wrote asset pack {} ({} assets, {} bytes)", path, stats.entries, written);
+        return stats;
+    }
+} // namespace core::assets
@@ -0,0 +1,185 @@
+#include <core/assets/atlasPacker.hpp>
+#include <core/utils/logging.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace core::assets
+{
+    static bool intersects(const AtlasPacker::Rect &a, const AtlasPacker::Rect &b)
+    {
+        return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+
+    static bool contains(const AtlasPacker::Rect &outer, const AtlasPacker::Rect &inner)
+    {
+        return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w
+            && inner.y + inner.h <= outer.y + outer.h;
+    }
+
+    static std::uint32_t nextPowerOfTwo(std::uint32_t value)
+    {
+        std::uint32_t result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    /** Removes free rectangles contained in another, keeps one of identical ones */
+    static void prune(std::vector<AtlasPacker::Rect> &free)
+    {
+        for (std::size_t i = 0; i < free.size(); i++)
+        {
+            for (std::size_t j = i + 1; j < free.size(); j++)
+            {
+                if (contains(free[j], free[i]))
+                {
+                    free.erase(free.begin() + i--);
+                    break;
+                }
+                if (contains(free[i], free[j])) free.erase(free.begin() + j--);
+            }
+        }
+    }
+
+    AtlasPacker::AtlasPacker() : AtlasPacker(Settings()) {}
+    AtlasPacker::AtlasPacker(const Settings &settings) : m_settings(settings) {}
+    AtlasPacker::~AtlasPacker() = default;
+
+    bool AtlasPacker::place(Page &page, std::uint32_t w, std::uint32_t h, Rect &rect) const
+    {
+        const Rect   *best      = nullptr;
+        std::uint32_t bestShort = ~std::uint32_t(0);
+        std::uint32_t bestLong  = ~std::uint32_t(0);
+        for (const Rect &free : page.free)
+        {
+            if (free.w < w || free.h < h) continue;
+            std::uint32_t leftoverW = free.w - w;
+            std::uint32_t leftoverH = free.h - h;
+            std::uint32_t shortSide = std::min(leftoverW, leftoverH);
+            std::uint32_t longSide  = std::max(leftoverW, leftoverH);
+            if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+            {
+                best      = &free;
+                bestShort = shortSide;
+                bestLong  = longSide;
+            }
+        }
+        if (!best) return false;
+
+        rect = Rect{best->x, best->y, w, h};
+        split(page, rect);
+        page.used += std::uint64_t(w) * h;
+        return true;
+    }
+
+    void AtlasPacker::split(Page &page, const Rect &used) const
+    {
+        std::vector<Rect> free;
+        free.reserve(page.free.size() + 4);
+        for (const Rect &f : page.free)
+        {
+            if (!intersects(f, used))
+            {
+                free.push_back(f);
+                continue;
+            }
+            /** keep the parts of f on each side of the used rectangle */
+            if (used.x > f.x) free.push_back({f.x, f.y, used.x - f.x, f.h});
+            if (used.x + used.w < f.x + f.w)
+                free.push_back({used.x + used.w, f.y, f.x + f.w - used.x - used.w, f.h});
+            if (used.y > f.y) free.push_back({f.x, f.y, f.w, used.y - f.y});
+            if (used.y + used.h < f.y + f.h)
+                free.push_back({f.x, used.y + used.h, f.w, f.y + f.h - used.y - used.h});
+        }
+        prune(free);
+        page.free = std::move(free);
+    }
+
+    void AtlasPacker::shrink(Page &page, std::uint32_t width, std::uint32_t height) const
+    {
+        if (m_settings.powerOfTwo)
+        {
+            width  = std::min(nextPowerOfTwo(width), page.width);
+            height = std::min(nextPowerOfTwo(height), page.height);
+        }
+
+        std::vector<Rect> free;
+        for (const Rect &f : page.free)
+        {
+            if (f.x >= width || f.y >= height) continue;
+            free.push_back({f.x, f.y, std::min(f.w, width - f.x), std::min(f.h, height - f.y)});
+        }
+        prune(free);
+        page.free   = std::move(free);
+        page.width  = width;
+        page.height = height;
+    }
+
+    std::vector<AtlasPacker::Placement> AtlasPacker::pack(const std::vector<Rect> &sizes)
+    {
+        L_TAG("AtlasPacker::pack");
+
+        const std::uint32_t padding = m_settings.padding;
+        const std::uint32_t maxSize = m_settings.maxPageSize;
+
+        /** larger first, the index keeps the order deterministic */
+        std::vector<std::size_t> order(sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            std::uint32_t sideA = std::max(sizes[a].w, sizes[a].h), sideB = std::max(sizes[b].w, sizes[b].h);
+            if (sideA != sideB) return sideA > sideB;
+            std::uint64_t areaA = std::uint64_t(sizes[a].w) * sizes[a].h;
+            std::uint64_t areaB = std::uint64_t(sizes[b].w) * sizes[b].h;
+            if (areaA != areaB) return areaA > areaB;
+            return a < b;
+        });
+
+        const std::size_t      firstNew = m_pages.size();
+        std::vector<Placement> placements(sizes.size());
+        std::vector<Rect>      extents; /** used area of the pages opened here */
+        for (std::size_t index : order)
+        {
+            const Rect   &size = sizes[index];
+            std::uint32_t w    = size.w + 2 * padding;
+            std::uint32_t h    = size.h + 2 * padding;
+            if (size.w == 0 || size.h == 0 || w > maxSize || h > maxSize)
+                L_THROW_RUNTIME("Cannot pack {}x{} rectangle in {}x{} pages", size.w, size.h, maxSize, maxSize);
+
+            Rect        rect;
+            std::size_t page = 0;
+            while (page < m_pages.size() && !place(m_pages[page], w, h, rect)) page++;
+            if (page == m_pages.size())
+            {
+                m_pages.push_back(Page{maxSize, maxSize, 0, {Rect{0, 0, maxSize, maxSize}}});
+                place(m_pages.back(), w, h, rect);
+            }
+            if (page >= firstNew)
+            {
+                if (extents.size() <= page - firstNew) extents.resize(page - firstNew + 1);
+                Rect &extent = extents[page - firstNew];
+                extent.w     = std::max(extent.w, rect.x + w);
+                extent.h     = std::max(extent.h, rect.y + h);
+            }
+            placements[index] = Placement{page, Rect{rect.x + padding, rect.y + padding, size.w, size.h}};
+        }
+
+        for (std::size_t page = firstNew; page < m_pages.size(); page++)
+        {
+            shrink(m_pages[page], extents[page - firstNew].w, extents[page - firstNew].h);
+            L_DEBUG("Atlas page {}: {}x{}, {:.1f}% used",
+                    page,
+                    m_pages[page].width,
+                    m_pages[page].height,
+                    100.0f * occupancy(page));
+        }
+        return placements;
+    }
+
+    void AtlasPacker::clear() { m_pages.clear(); }
+
+    float AtlasPacker::occupancy(std::size_t page) const
+    {
+        const Page &p = m_pages.at(page);
+        return p.width && p.height ? static_cast<float>(p.used) / (std::uint64_t(p.width) * p.height) : 0.0f;
+    }
+} // namespace core::assets
@@ -0,0 +1,253 @@
+#include <core/assets/bakedTexture.hpp>
+#include <core/assets/utils.hpp>
+#include <core/utils/hash.hpp>
+#include <core/utils/logging.hpp>
+#include <core/utils/platform.hpp>
+
+#include <assets/texture_p.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace core::assets
+{
+    static_assert(sizeof(BakedTexture::Header) == 40 && sizeof(BakedTexture::Level) == 24, "Baked texture layout changed");
+
+    static std::size_t alignUp(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+#if defined(CONFIG_CORE_TEXTURE_CACHE)
+    /** Cache file of texture asset @p name, asset names may contain path separators */
+    static fs::path cachePath(const AssetName &name)
+    {
+        std::string file = name;
+        std::replace(file.begin(), file.end(), '/', '_');
+        return core::utils::platform::getProjectPath() / CONFIG_CORE_TEXTURE_CACHE_DIR / (file + ".ctex");
+    }
+
+    /** Writes @p blob to @p path through a temporary file, so readers never map a partial bake */
+    static bool writeCache(const fs::path &path, const std::vector<char> &blob)
+    {
+        L_TAG("BakedTexture::writeCache");
+
+        std::error_code ec;
+        fs::create_directories(path.parent_path(), ec);
+
+        fs::path temp = path;
+        temp += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        {
+            std::ofstream f(temp, std::ios::binary | std::ios::trunc);
+            f.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            if (!f)
+            {
+                L_WARN("Could not write {}", temp.string());
+                fs::remove(temp, ec);
+                return false;
+            }
+        }
+        fs::rename(temp, path, ec);
+        if (ec)
+        {
+            L_WARN("Could not write {}: {}", path.string(), ec.message());
+            fs::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    /** Averages 2x2 blocks of @p src into @p dst, edges are clamped for odd sizes */
+    static void downsample(const std::uint8_t *src,
+                           std::size_t         srcWidth,
+                           std::size_t         srcHeight,
+                           std::uint8_t       *dst,
+                           std::size_t         dstWidth,
+                           std::size_t         dstHeight)
+    {
+        for (std::size_t y = 0; y < dstHeight; y++)
+        {
+            const std::uint8_t *row0 = src + std::min(y * 2, srcHeight - 1) * srcWidth * 4;
+            const std::uint8_t *row1 = src + std::min(y * 2 + 1, srcHeight - 1) * srcWidth * 4;
+            for (std::size_t x = 0; x < dstWidth; x++)
+            {
+                std::size_t x0 = std::min(x * 2, srcWidth - 1) * 4;
+                std::size_t x1 = std::min(x * 2 + 1, srcWidth - 1) * 4;
+                for (std::size_t c = 0; c < 4; c++)
+                {
+                    unsigned int sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    *dst++           = static_cast<std::uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    BakedTexture::BakedTexture() = default;
+
+    BakedTexture::BakedTexture(const AssetName &name, core::utils::MappedFile file)
+        : m_name(name),
+          m_file(std::move(file))
+    {
+        attach(m_file.data(), m_file.size());
+    }
+
+    BakedTexture::BakedTexture(const AssetName &name, std::vector<char> blob)
+        : m_name(name),
+          m_blob(std::move(blob))
+    {
+        attach(m_blob.data(), m_blob.size());
+    }
+
+    BakedTexture::~BakedTexture() = default;
+
+    BakedTexture::BakedTexture(BakedTexture &&o)            = default;
+    BakedTexture &BakedTexture::operator=(BakedTexture &&o) = default;
+
+    void BakedTexture::attach(const char *data, std::size_t size)
+    {
+        L_TAG("BakedTexture::attach");
+
+        const Header *header = reinterpret_cast<const Header *>(data);
+        if (size < sizeof(Header) || header->magic != magic || header->version != version)
+            L_THROW_RUNTIME("Not a baked texture: {}", m_name);
+        if (header->format != static_cast<std::uint32_t>(Format::RGBA8) || header->levels == 0
+            || header->levels > 32 || header->payloadOffset < sizeof(Header) + header->levels * sizeof(Level)
+            || header->payloadOffset > size)
+            L_THROW_RUNTIME("Corrupt baked texture: {}", m_name);
+
+        const Level *levels = reinterpret_cast<const Level *>(data + sizeof(Header));
+        for (std::uint32_t i = 0; i < header->levels; i++)
+        {
+            const Level &level = levels[i];
+            if (level.size != static_cast<std::uint64_t>(level.width) * level.height * 4
+                || level.offset + level.size > size - header->payloadOffset)
+                L_THROW_RUNTIME("Corrupt baked texture: {}", m_name);
+        }
+
+        m_header  = header;
+        m_levels  = levels;
+        m_payload = data + header->payloadOffset;
+    }
+
+    std::size_t BakedTexture::payloadSize() const noexcept
+    {
+        const Level &last = m_levels[m_header->levels - 1];
+        return static_cast<std::size_t>(last.offset + last.size);
+    }
+
+    std::uint64_t BakedTexture::hashSource(const char *data, std::size_t size) noexcept
+    {
+        return core::utils::hash_fnv1a(std::string_view(data, size));
+    }
+
+    std::vector<char> BakedTexture::bake(const Texture &texture, std::uint64_t sourceHash)
+    {
+        L_TAG("BakedTexture::bake");
+
+        const SDL_Surface *surface = texture.getInternal().m_surface;
+        const std::size_t  width   = static_cast<std::size_t>(surface->w);
+        const std::size_t  height  = static_cast<std::size_t>(surface->h);
+        if (width == 0 || height == 0) L_THROW_RUNTIME("Empty texture: {}", texture.name());
+
+        /** every level down to 1x1 */
+        std::vector<Level> levels;
+        std::size_t        payload = 0;
+        for (std::size_t w = width, h = height;;)
+        {
+            Level level;
+            level.width  = static_cast<std::uint32_t>(w);
+            level.height = static_cast<std::uint32_t>(h);
+            level.offset = payload;
+            level.size   = w * h * 4;
+            levels.push_back(level);
+            payload = alignUp(payload + level.size, payloadAlignment);
+            if (w == 1 && h == 1) break;
+            w = std::max<std::size_t>(w / 2, 1);
+            h = std::max<std::size_t>(h / 2, 1);
+        }
+
+        Header header;
+        header.magic         = magic;
+        header.version       = version;
+        header.sourceHash    = sourceHash;
+        header.format        = static_cast<std::uint32_t>(Format::RGBA8);
+        header.width         = static_cast<std::uint32_t>(width);
+        header.height        = static_cast<std::uint32_t>(height);
+        header.levels        = static_cast<std::uint32_t>(levels.size());
+        header.payloadOffset = alignUp(sizeof(Header) + levels.size() * sizeof(Level), payloadAlignment);
+
+        std::vector<char> blob(header.payloadOffset + payload);
+        std::memcpy(blob.data(), &header, sizeof(Header));
+        std::memcpy(blob.data() + sizeof(Header), levels.data(), levels.size() * sizeof(Level));
+
+        /** level 0 bottom row first, the order glTexImage2D expects */
+        std::uint8_t *base = reinterpret_cast<std::uint8_t *>(blob.data() + header.payloadOffset);
+        const char   *rows = static_cast<const char *>(surface->pixels);
+        for (std::size_t y = 0; y < height; y++)
+            std::memcpy(base + y * width * 4, rows + (height - 1 - y) * surface->pitch, width * 4);
+
+        for (std::size_t i = 1; i < levels.size(); i++)
+        {
+            const Level &src = levels[i - 1];
+            const Level &dst = levels[i];
+            downsample(base + src.offset, src.width, src.height, base + dst.offset, dst.width, dst.height);
+        }
+
+        return blob;
+    }
+
+    BakedTexture BakedTexture::load(const AssetName &name)
+    {
+        L_TAG("BakedTexture::load");
+        auto start = std::chrono::steady_clock::now();
+
+        const AssetPaths &assetPaths = AssetInventory::getInstance().lookupAssets(AssetType::Texture, name);
+        L_ASSERT(assetPaths.size() == 1, "Found multiple paths for {}", name);
+
+        AssetSpan     source     = AssetInventory::getInstance().openAsset(assetPaths.at(0));
+        std::uint64_t sourceHash = hashSource(source.data(), source.size());
+
+#if defined(CONFIG_CORE_TEXTURE_CACHE)
+        const fs::path path = cachePath(name);
+        if (fs::exists(path))
+        {
+            try
+            {
+                BakedTexture cached(name, core::utils::MappedFile(path.string()));
+                if (cached.sourceHash() == sourceHash)
+                {
+                    L_DEBUG("Texture {} mapped from cache in {:.3f} ms", name, elapsedMs(start));
+                    return cached;
+                }
+                L_DEBUG("Texture {} changed, baking again", name);
+            }
+            catch (const std::exception &e)
+            {
+                L_WARN("Ignoring texture cache entry of {}: {}", name, e.what());
+            }
+        }
+#endif
+
+        std::vector<char> blob = bake(Texture(name), sourceHash);
+        L_DEBUG("Texture {} baked in {:.3f} ms", name, elapsedMs(start));
+
+#if defined(CONFIG_CORE_TEXTURE_CACHE)
+        if (writeCache(path, blob)) return BakedTexture(name, core::utils::MappedFile(path.string()));
+#endif
+        return BakedTexture(name, std::move(blob));
+    }
+} // namespace core::assets
@@ -19,6 +19,7 @@ namespace core::assets
           m_vertices(vertices),
           m_indices(indices)
     {
+        computeBounds();
     }
 
     Mesh::Mesh(const AssetName &name)
@@ -32,6 +33,8 @@ namespace core::assets
             this->m_hasBitangents = it->second->m_hasBitangents;
             this->m_vertices      = it->second->m_vertices;
             this->m_indices       = it->second->m_indices;
+            this->m_bounds        = it->second->m_bounds;
+            return;
         }
 
         L_THROW_RUNTIME("Mesh(AssetName) only supports defaults");
@@ -42,5 +45,8 @@ namespace core::assets
     bool               Mesh::hasBitangents() const noexcept { return this->m_hasBitangents; }
     const std::vector<Vertex>   &Mesh::getVertices() const noexcept { return m_vertices; }
     const std::vector<uint32_t> &Mesh::getIndices() const noexcept { return m_indices; }
+    const MeshBounds            &Mesh::getBounds() const noexcept { return m_bounds; }
+
+    void Mesh::computeBounds() noexcept { m_bounds = MeshBounds::fromVertices(m_vertices.data(), m_vertices.size()); }
 
 } // namespace core::assets
\ No newline at end of file
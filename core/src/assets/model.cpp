@@ -142,6 +142,8 @@ namespace core::assets
             }
         }
 
+        meshObject.computeBounds();
+
         // Move meshobject
         m_meshes.push_back(std::move(meshObject));
 
@@ -46,19 +46,9 @@ namespace core::assets
 
         std::string metaFilepath = resolveMetafileFunc(name);
 
-        // verify that the file exists
-        if (!std::filesystem::exists(metaFilepath))
-        {
-            L_THROW_RUNTIME("Could not find sprite sheet json: {}", metaFilepath);
-        }
-
-        // parse json file
-        auto fileParserFunc = [](const AssetName &name) {
-            std::ifstream f(name);
-            return json::parse(f);
-        };
         // load and parse metafile
-        json jsonData = fileParserFunc(metaFilepath);
+        AssetSpan metafile = AssetInventory::getInstance().openAsset(metaFilepath);
+        json      jsonData = json::parse(metafile.begin(), metafile.end());
 
         // Parse metadata
         L_TRACE("Parsing spritesheet for {}", metaFilepath);
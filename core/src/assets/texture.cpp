@@ -5,15 +5,14 @@
 
 #include <SDL_image.h>
 
+#include <cstring>
+
 namespace core::assets
 {
-    static SDL_Surface *load_file(const AssetName &name)
+    /** Creates a 32-bit surface with RGBA byte order */
+    static SDL_Surface *create_surface(const AssetName &name, int width, int height)
     {
-        L_TAG("Texture::load_file(name)");
-
-        SDL_Surface *source = IMG_Load(name.c_str());
-        if (source == NULL) L_THROW_RUNTIME("Could not load texture file {}", name);
-        SDL_Rect imageFrame = {0, 0, source->w, source->h};
+        L_TAG("Texture::create_surface(name)");
 
 #if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
         constexpr uint32_t redMask   = 0xff000000;
@@ -27,10 +26,22 @@ namespace core::assets
         constexpr uint32_t alphaMask = 0xff000000;
 #endif
 
-        SDL_Surface *surface =
-            SDL_CreateRGBSurface(0, imageFrame.w, imageFrame.h, 32, redMask, greenMask, blueMask, alphaMask);
+        SDL_Surface *surface = SDL_CreateRGBSurface(0, width, height, 32, redMask, greenMask, blueMask, alphaMask);
         if (surface == NULL) L_THROW_RUNTIME("Could not create RGB Surface {}", name);
 
+        return surface;
+    }
+
+    static SDL_Surface *load_file(const AssetName &name)
+    {
+        L_TAG("Texture::load_file(name)");
+
+        AssetSpan    asset  = AssetInventory::getInstance().openAsset(name);
+        SDL_Surface *source = IMG_Load_RW(SDL_RWFromConstMem(asset.data(), static_cast<int>(asset.size())), 1);
+        if (source == NULL) L_THROW_RUNTIME("Could not load texture file {}", name);
+        SDL_Rect imageFrame = {0, 0, source->w, source->h};
+
+        SDL_Surface *surface = create_surface(name, imageFrame.w, imageFrame.h);
         SDL_BlitSurface(source, &imageFrame, surface, &imageFrame);
         SDL_FreeSurface(source);
 
@@ -62,6 +73,22 @@ namespace core::assets
         L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
     }
 
+    Texture::Texture(const AssetName &name, std::size_t width, std::size_t height, const void *pixels)
+        : m_internal(std::make_unique<Internal>())
+    {
+        L_TAG("Texture::Texture(&name, width, height, pixels)");
+
+        SDL_Surface *surface = create_surface(name, static_cast<int>(width), static_cast<int>(height));
+        const char  *source  = static_cast<const char *>(pixels);
+        for (std::size_t row = 0; row < height; row++)
+            std::memcpy(static_cast<char *>(surface->pixels) + row * surface->pitch, source + row * width * 4, width * 4);
+
+        this->m_internal->m_name    = name;
+        this->m_internal->m_surface = surface;
+
+        L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
+    }
+
     Texture::~Texture()
     {
         L_TAG("Texture::~Texture");
@@ -77,6 +104,8 @@ namespace core::assets
     {
         return this->m_internal->m_surface->h * this->m_internal->m_surface->pitch;
     }
+    std::size_t Texture::width() const noexcept { return this->m_internal->m_surface->w; }
+    std::size_t Texture::height() const noexcept { return this->m_internal->m_surface->h; }
     const Texture::Internal &Texture::getInternal() const noexcept
     {
         return *(this->m_internal.get());
@@ -206,8 +206,13 @@ namespace core::audio
         auto &assetPath = AssetInventory::getInstance().lookupAssets(AssetType::Audio, assetName);
         L_ASSERT(assetPath.size() == 1, "Found multiple asset paths for: {}", assetName);
 
-        // Open audio stream
-        UniqueSoundSample sample(Sound_NewSampleFromFile(assetPath[0].c_str(), &m_decodeInfo, 131136));
+        // Open audio stream, decoders pick the format from the extension
+        AssetSpan         asset = AssetInventory::getInstance().openAsset(assetPath[0]);
+        std::string       ext   = assetPath[0].substr(assetPath[0].find_last_of('.') + 1);
+        UniqueSoundSample sample(Sound_NewSample(SDL_RWFromConstMem(asset.data(), static_cast<int>(asset.size())),
+                                                 ext.c_str(),
+                                                 &m_decodeInfo,
+                                                 131136));
         if (!sample) L_THROW_RUNTIME("Failed to open audio file");
 
         // Decode audio stream
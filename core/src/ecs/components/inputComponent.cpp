@@ -4,7 +4,34 @@
 #include <core/utils/logging.hpp>
 
 InputComponent::InputComponent() {}
-InputComponent::~InputComponent() = default;
+
+InputComponent::~InputComponent()
+{
+    if (!m_listeners.empty()) InputManager::getInstance().unsubscribe(this);
+}
+
+InputComponent::InputComponent(InputComponent &&o) : Component(std::move(o))
+{
+    *this = std::move(o);
+}
+
+InputComponent &InputComponent::operator=(InputComponent &&o)
+{
+    if (this == &o) return *this;
+
+    InputManager &inputManager = InputManager::getInstance();
+    if (!m_listeners.empty()) inputManager.unsubscribe(this);
+    if (!o.m_listeners.empty()) inputManager.unsubscribe(&o);
+
+    Component::operator=(std::move(o));
+    m_listeners = std::move(o.m_listeners);
+    o.m_listeners.clear();
+
+    /** map nodes moved with the container, but the owner address changed */
+    for (auto &[event, listener] : m_listeners)
+        inputManager.subscribe(this, event, &listener);
+    return *this;
+}
 
 void InputComponent::init() {
 
@@ -13,7 +40,9 @@ void InputComponent::init() {
 void InputComponent::setListener(const InputEventType event, const Listener &listener)
 {
     L_TAG("InputComponent::setListener");
-    this->m_listeners.emplace(event, listener);
+    auto [it, inserted] = this->m_listeners.insert_or_assign(event, listener);
+    /** node addresses are stable, a replaced listener keeps its subscription */
+    if (inserted) InputManager::getInstance().subscribe(this, event, &it->second);
 
     L_TRACE("{}: listener set for {}", static_cast<void*>(this), to_string(event));
-}
\ No newline at end of file
+}
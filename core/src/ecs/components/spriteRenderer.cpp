@@ -4,6 +4,7 @@
 #include <core/utils/logging.hpp>
 #include <core/assets/shader.hpp>
 #include <core/graphics/asset-manager.hpp>
+#include <core/graphics/spriteAtlas.hpp>
 
 #include <mutex>
 
@@ -42,9 +43,19 @@ SpriteRenderer::SpriteRenderer(AssetID meshID, AssetID textureID, AssetID pipeli
 void SpriteRenderer::loadSprite(const AssetName &sprite)
 {
     AssetManager &assetManager = *Game::assetManager();
-    AssetID       textureID    = assetManager.loadAsset(AssetType::Texture, sprite);
+    AssetID       textureID    = assetManager.loadTextureAsync(sprite);
 
     m_textureID = textureID;
+    m_sprite    = sprite;
+}
+void SpriteRenderer::loadSprite(const SpriteAtlas &atlas, const AssetName &sprite)
+{
+    SpriteAtlas::Region region;
+    if (!atlas.find(sprite, region)) return loadSprite(sprite);
+
+    m_textureID = region.texture;
+    m_uvRect    = region.uvRect;
+    m_sprite    = sprite;
 }
 void SpriteRenderer::loadSpriteSheet(const AssetName &sprite)
 {
@@ -52,8 +63,9 @@ void SpriteRenderer::loadSpriteSheet(const AssetName &sprite)
 
     // load spritesheet metadata
     spriteSheet = ::loadSpriteSheet(sprite);
+    m_sprite.clear();
 
-    m_textureID      = assetManager.loadAsset(AssetType::Texture, spriteSheet->getTextureName());
+    m_textureID      = assetManager.loadTextureAsync(spriteSheet->getTextureName());
     usingSpriteSheet = true;
     activeFrameNumber      = 0;
 }
@@ -0,0 +1,45 @@
+#include <core/event.hpp>
+#include <core/utils/logging.hpp>
+#include <core/utils/profiler.hpp>
+
+EventManager::EventManager() : m_ownerThread(std::this_thread::get_id()) {}
+EventManager::~EventManager() = default;
+
+void EventManager::init()
+{
+    L_TAG("EventManager::init");
+    m_ownerThread = std::this_thread::get_id();
+}
+
+void EventManager::unsubscribe(EventHandlerID id)
+{
+    L_TAG("EventManager::unsubscribe");
+    for (auto &[type, channel] : m_channels)
+        if (channel->unsubscribe(id)) return;
+    L_WARN("No handler with id({})", id);
+}
+
+void EventManager::drainDeferred()
+{
+    L_TAG("EventManager::drainDeferred");
+
+    DeferredEvent d;
+    while (m_deferred.try_pop(d))
+        d.append(*this, d.data);
+
+    std::size_t dropped = m_deferredDropped.exchange(0, std::memory_order_relaxed);
+    if (dropped == 0) return;
+    m_droppedTotal += dropped;
+    L_WARN("Dropped {} events posted from other threads, the queue was full", dropped);
+}
+
+void EventManager::dispatch(EventPhase phase)
+{
+    PROFILER_BLOCK("EventManager::dispatch");
+    drainDeferred();
+
+    /** index loop, handlers may create channels for new event types */
+    auto &channels = m_phaseChannels[static_cast<std::size_t>(phase)];
+    for (std::size_t i = 0; i < channels.size(); i++)
+        channels[i]->dispatch();
+}
@@ -19,6 +19,8 @@
 
 #include <core/ui/uiManager.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <thread>
 
 /** @todo: replace these with shared ptrs? */
@@ -59,6 +61,13 @@ Game::Game(const std::string &windowTitle, const float &windowWidth, const float
     SDL_GetVersion(&sdlVersion);
     L_INFO("Using SDL2 Version: {}.{}.{}", sdlVersion.major, sdlVersion.minor, sdlVersion.patch);
 
+    /** Render without a display, e.g. on Mesa llvmpipe through EGL surfaceless */
+    if (SDL_getenv("CORE_RENDER_OFFSCREEN"))
+    {
+        L_INFO("CORE_RENDER_OFFSCREEN set, using the offscreen video driver");
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 1);
+    }
+
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0) L_THROW_RUNTIME("Could not initialize SDL2");
 
     L_DEBUG("Initializing AssetInventory");
@@ -96,6 +105,7 @@ Game::Game(const std::string &windowTitle, const float &windowWidth, const float
 
 Game::~Game()
 {
+    g_inputManager->clean();
     delete g_entityManager;
     delete g_componentManager;
     delete g_eventManager;
@@ -117,12 +127,13 @@ void Game::init()
 void Game::startGameLoop()
 {
     L_TAG("Game::startGameLoop");
-    bool isRunning = true;
+    /** atomic, the event watch runs on whichever thread pumps events */
+    std::atomic<bool> isRunning{true};
 
     /** Watch incoming events for exit triggers */
     SDL_AddEventWatch(
         [](void *data, SDL_Event *e) -> int {
-            bool *isRunning = static_cast<bool *>(data);
+            std::atomic<bool> *isRunning = static_cast<std::atomic<bool> *>(data);
             if (e->type == SDL_QUIT)
                 *isRunning = false;
             else if (e->type == SDL_WINDOWEVENT && e->window.event == SDL_WINDOWEVENT_CLOSE)
@@ -145,10 +156,14 @@ void Game::startGameLoop()
              * Managers grab relevant SDL_events from queue here
              */
             PROFILER_BLOCK("Manager::preupdate");
+            /** pump before input grabs its events so they are not a frame late */
+#if !defined(CONFIG_CORE_INPUT_THREAD_PUMP)
+            SDL_PumpEvents();
+#endif
             g_inputManager->preUpdate();
             g_entityManager->preUpdate();
+            g_eventManager->dispatch(EventPhase::PreUpdate);
         }
-        SDL_PumpEvents();
 
         /** Manager Updates */
         {
@@ -156,18 +171,24 @@ void Game::startGameLoop()
             time_ms delta = g_time->scaledDeltaTime<time_ms>();
             g_inputManager->update(delta);
             g_entityManager->update(delta);
+            g_eventManager->dispatch(EventPhase::Update);
         }
 
         {
             PROFILER_BLOCK("Manager::postUpdate");
             g_entityManager->postUpdate();
             g_inputManager->postUpdate();
+            g_eventManager->dispatch(EventPhase::PostUpdate);
         }
 
         /** Render */
         {
             PROFILER_BLOCK("FrameRender");
             g_renderer->renderBegin();
+            {
+                PROFILER_BLOCK("Input::lateLatch");
+                g_inputManager->lateLatch();
+            }
             /**
              * Call render function from Renderer
              * This doesn't feel good tho, maybe rework?
@@ -175,7 +196,9 @@ void Game::startGameLoop()
              */
             g_renderer->render();
             g_renderer->renderEnd();
+            g_inputManager->frameSubmitted(g_renderer->presentation());
         }
+        g_eventManager->dispatch(EventPhase::PostRender);
 
         /** Refresh manager objects */
         {
@@ -194,7 +217,17 @@ void Game::startGameLoop()
             PROFILER_BLOCK("FrameSleep");
             auto s = m_targetDelta - g_time->unscaledFrameTime();
             PROFILER_VALUE("FRAME_DELAY_US", s.count(), PROFILER_VIN("FRAME_DELAY_US"));
+#if defined(CONFIG_CORE_INPUT_THREAD) && !defined(CONFIG_CORE_INPUT_THREAD_PUMP)
+            /** keep pumping while idle so the input thread timestamps events as they arrive */
+            const auto wakeup = Time::getTime<time_ds>() + s;
+            for (auto now = Time::getTime<time_ds>(); now < wakeup; now = Time::getTime<time_ds>())
+            {
+                SDL_PumpEvents();
+                std::this_thread::sleep_for(std::min<time_ds>(wakeup - now, time_ds(1000)));
+            }
+#else
             std::this_thread::sleep_for(s);
+#endif
             // SDL_Delay(std::chrono::duration_cast<std::chrono::milliseconds>(s).count());
         }
 
@@ -0,0 +1,207 @@
+#include <core/graphics/culling.hpp>
+#include <core/utils/bits.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CULLING_SSE 1
+#endif
+
+MeshBounds MeshBounds::fromVertices(const Vertex *vertices, std::size_t count) noexcept
+{
+    MeshBounds bounds;
+    if (count == 0) return bounds;
+
+    bounds.min = glm::vec3(std::numeric_limits<float>::max());
+    bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+    for (std::size_t i = 0; i < count; i++)
+    {
+        bounds.min = glm::min(bounds.min, vertices[i].v);
+        bounds.max = glm::max(bounds.max, vertices[i].v);
+    }
+
+    /** sphere around the box center, tighter than the half diagonal for most meshes */
+    bounds.center = (bounds.min + bounds.max) * 0.5f;
+    float radius2 = 0.0f;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        glm::vec3 d = vertices[i].v - bounds.center;
+        radius2     = std::max(radius2, glm::dot(d, d));
+    }
+    bounds.radius = std::sqrt(radius2);
+    return bounds;
+}
+
+void MeshBounds::transformSphere(const glm::mat4 &model, glm::vec3 &worldCenter, float &worldRadius) const noexcept
+{
+    worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+
+    float scale2 = std::max({glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                             glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                             glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))});
+    worldRadius  = radius * std::sqrt(scale2);
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4 &m) noexcept
+{
+    /** Gribb/Hartmann, rows of the column-major matrix */
+    const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum f;
+    f.planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+    for (auto &plane : f.planes)
+        plane /= glm::length(glm::vec3(plane));
+    return f;
+}
+
+void CullBatch::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_r.clear();
+}
+
+void CullBatch::reserve(std::size_t count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_z.reserve(count);
+    m_r.reserve(count);
+}
+
+void CullBatch::push(const glm::vec3 &center, float radius)
+{
+    m_x.push_back(center.x);
+    m_y.push_back(center.y);
+    m_z.push_back(center.z);
+    m_r.push_back(radius);
+}
+
+void CullBatch::cull(const glm::mat4 &viewProjection, bool orthographic, std::vector<std::uint32_t> &visible) const
+{
+    visible.clear();
+    if (orthographic)
+        cullOrthographic(viewProjection, visible);
+    else
+        cullFrustum(viewProjection, visible);
+}
+
+void CullBatch::cullFrustum(const glm::mat4 &viewProjection, std::vector<std::uint32_t> &visible) const
+{
+    const Frustum     frustum = Frustum::fromMatrix(viewProjection);
+    const std::size_t count   = size();
+    std::size_t       i       = 0;
+
+#if defined(CULLING_SSE)
+    __m128 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm_set1_ps(frustum.planes[p].x);
+        py[p] = _mm_set1_ps(frustum.planes[p].y);
+        pz[p] = _mm_set1_ps(frustum.planes[p].z);
+        pw[p] = _mm_set1_ps(frustum.planes[p].w);
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x    = _mm_loadu_ps(&m_x[i]);
+        const __m128 y    = _mm_loadu_ps(&m_y[i]);
+        const __m128 z    = _mm_loadu_ps(&m_z[i]);
+        const __m128 negR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&m_r[i]));
+
+        /** inside while the signed distance to every plane is >= -radius */
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], x), _mm_mul_ps(py[p], y)),
+                                  _mm_add_ps(_mm_mul_ps(pz[p], z), pw[p]));
+            inside   = _mm_and_ps(inside, _mm_cmpge_ps(d, negR));
+        }
+
+        std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_ps(inside));
+        for (; mask; mask &= mask - 1)
+            visible.push_back(static_cast<std::uint32_t>(i + core::utils::countr_zero(mask)));
+    }
+#endif
+
+    /** same operation order as the SSE path so both agree on spheres touching a plane */
+    for (; i < count; i++)
+    {
+        bool inside = true;
+        for (const auto &plane : frustum.planes)
+            inside &= (plane.x * m_x[i] + plane.y * m_y[i]) + (plane.z * m_z[i] + plane.w) >= -m_r[i];
+        if (inside) visible.push_back(static_cast<std::uint32_t>(i));
+    }
+}
+
+void CullBatch::cullOrthographic(const glm::mat4 &m, std::vector<std::uint32_t> &visible) const
+{
+    /**
+     * An affine projection maps the view volume to the clip cube with w = 1, so a
+     * sphere is visible when |row_k . c| <= 1 + r * |row_k.xyz| on each axis:
+     * 3 dot products instead of 6 plane tests.
+     */
+    glm::vec4 rows[3];
+    float     extent[3];
+    for (int k = 0; k < 3; k++)
+    {
+        rows[k]   = glm::vec4(m[0][k], m[1][k], m[2][k], m[3][k]);
+        extent[k] = glm::length(glm::vec3(rows[k]));
+    }
+
+    const std::size_t count = size();
+    std::size_t       i     = 0;
+
+#if defined(CULLING_SSE)
+    const __m128 one     = _mm_set1_ps(1.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128       rx[3], ry[3], rz[3], rw[3], re[3];
+    for (int k = 0; k < 3; k++)
+    {
+        rx[k] = _mm_set1_ps(rows[k].x);
+        ry[k] = _mm_set1_ps(rows[k].y);
+        rz[k] = _mm_set1_ps(rows[k].z);
+        rw[k] = _mm_set1_ps(rows[k].w);
+        re[k] = _mm_set1_ps(extent[k]);
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(&m_x[i]);
+        const __m128 y = _mm_loadu_ps(&m_y[i]);
+        const __m128 z = _mm_loadu_ps(&m_z[i]);
+        const __m128 r = _mm_loadu_ps(&m_r[i]);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int k = 0; k < 3; k++)
+        {
+            __m128 c = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx[k], x), _mm_mul_ps(ry[k], y)),
+                                  _mm_add_ps(_mm_mul_ps(rz[k], z), rw[k]));
+            __m128 limit = _mm_add_ps(one, _mm_mul_ps(r, re[k]));
+            inside       = _mm_and_ps(inside, _mm_cmple_ps(_mm_and_ps(c, absMask), limit));
+        }
+
+        std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_ps(inside));
+        for (; mask; mask &= mask - 1)
+            visible.push_back(static_cast<std::uint32_t>(i + core::utils::countr_zero(mask)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        bool inside = true;
+        for (int k = 0; k < 3; k++)
+        {
+            float c = (rows[k].x * m_x[i] + rows[k].y * m_y[i]) + (rows[k].z * m_z[i] + rows[k].w);
+            inside &= std::fabs(c) <= 1.0f + m_r[i] * extent[k];
+        }
+        if (inside) visible.push_back(static_cast<std::uint32_t>(i));
+    }
+}
@@ -0,0 +1,136 @@
+#include <core/graphics/framePacket.hpp>
+
+#include <core/ecs/componentManager.hpp>
+#include <core/ecs/components.hpp>
+#include <core/ui/uiManager.hpp>
+#include <core/utils/profiler.hpp>
+
+void FramePacket::clear()
+{
+    cameras.clear();
+    meshes.clear();
+    sprites.clear();
+    texts.clear();
+}
+
+void FramePacket::extract(std::uint64_t frameNumber)
+{
+    PROFILER_BLOCK("FramePacket::extract");
+    ComponentManager &componentManager = ComponentManager::getInstance();
+
+    clear();
+    frame = frameNumber;
+
+    for (auto &camera : componentManager.getComponents<CameraComponent>())
+    {
+        cameras.push_back({camera->getViewMatrix(),
+                           camera->getProjectionMatrix(),
+                           camera->getProjection() == CameraComponent::Projection::Orthographic,
+                           camera->getRenderMask()});
+    }
+
+    for (auto &meshR : componentManager.getComponents<MeshRenderer>())
+    {
+        if (meshR->m_renderMask.none()) continue;
+        meshes.push_back({meshR->getModelMatrix(),
+                          meshR->getPipelineID(),
+                          meshR->getTextureID(),
+                          meshR->getMeshID(),
+                          meshR->getRenderLayer(),
+                          meshR->m_renderMask});
+    }
+
+    for (auto &sprite : componentManager.getComponents<SpriteRenderer>())
+    {
+        if (sprite->m_renderMask.none()) continue;
+        sprites.push_back({sprite->getModelMatrix(),
+                           sprite->getUVRect(),
+                           sprite->getColor(),
+                           sprite->getPipelineID(),
+                           sprite->getTextureID(),
+                           sprite->getRenderLayer(),
+                           sprite->m_renderMask});
+    }
+
+    /** unchanged batches hand out the mesh of the previous frame */
+    for (auto &entry : UIManager::getInstance().getTextBatches())
+    {
+        auto mesh = entry.batch->build();
+        if (mesh->quads() == 0) continue;
+        texts.push_back({std::move(mesh), entry.pipeline, RenderMask(RenderMaskBits::TEXT)});
+    }
+}
+
+const std::vector<std::size_t> &FrameCulling::cull(const FramePacket::Camera &camera, RendererStats &stats)
+{
+    m_spheres.cull(camera.projection * camera.view, camera.orthographic, m_visible);
+    stats.visible += m_visible.size();
+    stats.culled += m_spheres.size() - m_visible.size();
+
+    m_indices.clear();
+    for (auto index : m_visible)
+        m_indices.push_back(m_candidates[index]);
+    return m_indices;
+}
+
+const std::vector<std::size_t> &FrameCulling::sprites(const FramePacket::Camera              &camera,
+                                                      const std::vector<FramePacket::Sprite> &sprites,
+                                                      RendererStats                          &stats)
+{
+    m_spheres.clear();
+    m_candidates.clear();
+    for (std::size_t i = 0; i < sprites.size(); i++)
+    {
+        auto &sprite = sprites[i];
+        if (!isVisibleTo(camera, sprite.renderMask)) continue;
+
+        /** sprites are unit quads spanning [0, 1] in model space */
+        const glm::mat4 &model  = sprite.model;
+        glm::vec3        axisX  = glm::vec3(model[0]);
+        glm::vec3        axisY  = glm::vec3(model[1]);
+        glm::vec3        center = glm::vec3(model * glm::vec4(0.5f, 0.5f, 0.0f, 1.0f));
+        float radius = 0.5f * glm::sqrt(glm::max(glm::dot(axisX + axisY, axisX + axisY), glm::dot(axisX - axisY, axisX - axisY)));
+
+        m_spheres.push(center, radius);
+        m_candidates.push_back(i);
+    }
+    return cull(camera, stats);
+}
+
+const std::vector<std::size_t> &FrameCulling::meshes(const AssetManager                   &am,
+                                                     const FramePacket::Camera            &camera,
+                                                     const std::vector<FramePacket::Mesh> &meshes,
+                                                     RendererStats                        &stats)
+{
+    m_spheres.clear();
+    m_candidates.clear();
+    for (std::size_t i = 0; i < meshes.size(); i++)
+    {
+        auto &meshR = meshes[i];
+        if (!isVisibleTo(camera, meshR.renderMask)) continue;
+
+        glm::vec3 center;
+        float     radius;
+        am.getMeshBounds(meshR.mesh).transformSphere(meshR.model, center, radius);
+        m_spheres.push(center, radius);
+        m_candidates.push_back(i);
+    }
+    return cull(camera, stats);
+}
+
+void queueMeshes(RenderQueue                          &queue,
+                 const FramePacket::Camera            &camera,
+                 const std::vector<FramePacket::Mesh> &meshes,
+                 const std::vector<std::size_t>       &indices)
+{
+    queue.clear();
+    for (auto index : indices)
+    {
+        auto &meshR = meshes[index];
+        /** view space looks down -z */
+        float viewDepth = -(camera.view * meshR.model[3]).z;
+
+        queue.push({meshR.pipeline, meshR.texture, meshR.mesh, meshR.model}, meshR.layer, viewDepth);
+    }
+    queue.sort();
+}
@@ -0,0 +1,70 @@
+#include <core/graphics/renderQueue.hpp>
+
+#include <array>
+#include <cstring>
+
+std::uint32_t RenderKey::quantizeDepth(float viewDepth) noexcept
+{
+    if (!(viewDepth > 0.0f)) return 0; /** behind the camera or NaN */
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &viewDepth, sizeof(bits));
+    return bits >> (32 - depthBits);
+}
+
+RenderQueue::RenderQueue()  = default;
+RenderQueue::~RenderQueue() = default;
+
+void RenderQueue::clear()
+{
+    m_commands.clear();
+    m_entries.clear();
+}
+
+void RenderQueue::push(const DrawCommand &command, std::uint8_t layer, float viewDepth)
+{
+    std::uint64_t key = RenderKey::make(layer,
+                                        command.pipeline,
+                                        command.texture,
+                                        command.mesh,
+                                        RenderKey::quantizeDepth(viewDepth));
+    m_entries.push_back({key, static_cast<std::uint32_t>(m_commands.size())});
+    m_commands.push_back(command);
+}
+
+void RenderQueue::sort()
+{
+    const std::size_t count = m_entries.size();
+    if (count < 2) return;
+
+    /** one histogram per key byte, built in a single pass */
+    std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+    for (const auto &entry : m_entries)
+        for (unsigned pass = 0; pass < 8; pass++)
+            histograms[pass][(entry.key >> (pass * 8)) & 0xff]++;
+
+    m_scratch.resize(count);
+    Entry *src = m_entries.data();
+    Entry *dst = m_scratch.data();
+
+    for (unsigned pass = 0; pass < 8; pass++)
+    {
+        auto &histogram = histograms[pass];
+        /** every key has the same byte here, the pass would not move anything */
+        if (histogram[(src[0].key >> (pass * 8)) & 0xff] == count) continue;
+
+        std::uint32_t offset = 0;
+        for (auto &bucket : histogram)
+        {
+            std::uint32_t n = bucket;
+            bucket          = offset;
+            offset += n;
+        }
+
+        for (std::size_t i = 0; i < count; i++)
+            dst[histogram[(src[i].key >> (pass * 8)) & 0xff]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != m_entries.data()) m_entries.swap(m_scratch);
+}
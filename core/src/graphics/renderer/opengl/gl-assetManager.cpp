@@ -1,22 +1,41 @@
 #include <core/graphics/renderer/opengl/gl-assetManager.hpp>
+#include <core/graphics/renderer/opengl/gl-textureStreamer.hpp>
 #include <utils/logging.hpp>
 
+#include <cstdint>
+#include <deque>
 #include <unordered_map>
 #include <mutex>
 
 struct OpenGLAssetManager::Internal
 {
+    /** deque so loads never move cached assets, the renderer keeps references across a frame */
     template <typename T>
-    using AssetCache = std::vector<std::pair<std::string, T>>;
+    using AssetCache = std::deque<std::pair<std::string, T>>;
 
     /** @todo: improve mutex & thread-safe impl */
-    /** @todo: probably better to replace this with vector? but need to ensure index-value should not change ever */
     AssetCache<OpenGLMesh>     t_meshCache;
     AssetCache<OpenGLPipeline> shaderCache;
     AssetCache<OpenGLTexture>  t_textureCache;
     std::mutex                 mutex;
 
-    Internal()
+    /** pipeline -> instanced variant, -1 if there is none. Filled when the pipeline is loaded */
+    std::unordered_map<AssetID, AssetID> instancedPipelines;
+
+    Executor executor;
+
+    /** background loads of loadTextureAsync, only touched inside execute */
+    OpenGLTextureStreamer streamer;
+
+    void execute(const std::function<void()> &load)
+    {
+        if (executor)
+            executor(load);
+        else
+            load();
+    }
+
+    Internal() : streamer(static_cast<std::size_t>(CONFIG_CORE_TEXTURE_UPLOAD_BUDGET) * 1024)
     {
         L_TAG("OpenGLAssetManager::Internal");
         L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
@@ -49,12 +68,11 @@ struct OpenGLAssetManager::Internal
     {
         L_TAG("OpenGLAssetManager::loadPipeline");
         std::lock_guard<std::mutex> l(this->mutex);
-        const std::string          &name      = shader.name();
-        auto                       &cache     = this->shaderCache;
-        auto                        insertPos = cache.end();
-        AssetID                     id        = cache.size();
+        const std::string          &name  = shader.name();
+        auto                       &cache = this->shaderCache;
+        AssetID                     id    = cache.size();
 
-        cache.insert(insertPos, std::make_pair(name, OpenGLPipeline(shader)));
+        cache.emplace_back(name, OpenGLPipeline(shader));
         L_DEBUG("Pipeline created {}: {}", id, name);
 
         return id;
@@ -72,18 +90,61 @@ struct OpenGLAssetManager::Internal
             L_THROW_RUNTIME("Cache empty for AssetID: {}", id);
     }
 
+    /** Checks if the instanced variant of @p pipeline was looked up already */
+    bool isResolved(AssetID pipeline)
+    {
+        std::lock_guard<std::mutex> l(this->mutex);
+        return this->instancedPipelines.count(pipeline) != 0;
+    }
+
+    /**
+     * Loads the "<name>_instanced" variant of @p pipeline if there is one, so the
+     * renderer never has to load a pipeline while it draws
+     */
+    void resolveInstanced(AssetID pipeline)
+    {
+        L_TAG("OpenGLAssetManager::resolveInstanced");
+        static const std::string suffix = "_instanced";
+
+        std::string name;
+        {
+            std::lock_guard<std::mutex> l(this->mutex);
+            if (this->instancedPipelines.count(pipeline)) return;
+            name = this->shaderCache.at(pipeline).first;
+        }
+
+        AssetID instanced = -1;
+        bool    isVariant = name.size() > suffix.size()
+                         && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+        if (!isVariant && OpenGLPipeline::supportsInstancing()
+            && AssetInventory::getInstance().hasAsset(AssetType::Pipeline, name + suffix))
+        {
+            if (!this->findCache(name + suffix, this->shaderCache, instanced))
+                instanced = this->loadPipeline(core::assets::Shader(name + suffix));
+        }
+
+        L_DEBUG("Instanced variant of pipeline {}: {}", pipeline, instanced);
+        std::lock_guard<std::mutex> l(this->mutex);
+        this->instancedPipelines.emplace(pipeline, instanced);
+    }
+
     AssetID loadMesh(const core::assets::Mesh &mesh)
     {
         L_TAG("OpenGLAssetManager::loadMesh");
         std::lock_guard<std::mutex> l(this->mutex);
-        const std::string          &name      = mesh.name();
-        auto                       &cache     = this->t_meshCache;
-        auto                        insertPos = cache.end();
-        AssetID                     id        = cache.size();
+        const std::string          &name  = mesh.name();
+        auto                       &cache = this->t_meshCache;
+        AssetID                     id    = cache.size();
 
-        cache.insert(insertPos, std::make_pair(name, OpenGLMesh(mesh)));
+        cache.emplace_back(name, OpenGLMesh(mesh));
         L_DEBUG("Mesh created {}: {}", id, name);
 
+        /** create the vertex arrays up front for the pipelines already loaded */
+        const OpenGLMesh &glMesh = cache.back().second;
+        glMesh.getVertexArray(glMesh.getLayoutMask());
+        for (auto &pipeline : this->shaderCache)
+            glMesh.getVertexArray(pipeline.second.getAttributeMask());
+
         return id;
     }
 
@@ -99,16 +160,16 @@ struct OpenGLAssetManager::Internal
             L_THROW_RUNTIME("Cache empty for AssetID: {}", id);
     }
 
-    AssetID loadTexture(const core::assets::Texture &texture)
+    template <typename T>
+    AssetID loadTexture(const T &texture)
     {
         L_TAG("OpenGLAssetManager::loadTexture");
         std::lock_guard<std::mutex> l(this->mutex);
-        const std::string          &name      = texture.name();
-        auto                       &cache     = this->t_textureCache;
-        auto                        insertPos = cache.end();
-        AssetID                     id        = cache.size();
+        const std::string          &name  = texture.name();
+        auto                       &cache = this->t_textureCache;
+        AssetID                     id    = cache.size();
 
-        cache.insert(insertPos, std::make_pair(name, OpenGLTexture(texture)));
+        cache.emplace_back(name, OpenGLTexture(texture));
         L_DEBUG("Texture created {}: {}", id, name);
 
         return id;
@@ -129,34 +190,60 @@ struct OpenGLAssetManager::Internal
 
 AssetID OpenGLAssetManager::loadAsset(const AssetType &type, const AssetName &name)
 {
-    AssetID id = std::numeric_limits<std::size_t>::max();
+    Internal &internal = *this->m_internal;
+    AssetID   id       = std::numeric_limits<std::size_t>::max();
+
+    /** cached assets are found on the calling thread, only loads go through the executor */
     switch (type)
     {
     case AssetType::Mesh:
-        if (!this->m_internal->findCache(name, this->m_internal->t_meshCache, id))
-            id = this->loadMesh(core::assets::Mesh(name));
+        if (internal.findCache(name, internal.t_meshCache, id)) return id;
         break;
     case AssetType::Pipeline:
-        if (!this->m_internal->findCache(name, this->m_internal->shaderCache, id))
-            id = this->loadPipeline(core::assets::Shader("opengl/" + name));
+        if (internal.findCache("opengl/" + name, internal.shaderCache, id) && internal.isResolved(id)) return id;
         break;
     case AssetType::Texture:
-        if (!this->m_internal->findCache(name, this->m_internal->t_textureCache, id))
-            id = this->loadTexture(core::assets::Texture(name));
+        if (internal.findCache(name, internal.t_textureCache, id)) return id;
         break;
     default:
-        break;
+        return id;
     }
+
+    /** looked up again, another thread may have loaded it in the meantime */
+    internal.execute([&]() {
+        switch (type)
+        {
+        case AssetType::Mesh:
+            if (!internal.findCache(name, internal.t_meshCache, id))
+                id = this->loadMesh(core::assets::Mesh(name));
+            break;
+        case AssetType::Pipeline:
+            /** pipelines are cached with the shader name, which includes the opengl/ prefix */
+            if (!internal.findCache("opengl/" + name, internal.shaderCache, id))
+                id = internal.loadPipeline(core::assets::Shader("opengl/" + name));
+            internal.resolveInstanced(id);
+            break;
+        case AssetType::Texture:
+            if (!internal.findCache(name, internal.t_textureCache, id))
+                id = internal.loadTexture(core::assets::BakedTexture::load(name));
+            break;
+        default:
+            break;
+        }
+    });
     return id;
 }
 
 AssetID OpenGLAssetManager::loadMesh(const core::assets::Mesh &mesh)
 {
     L_TAG("OpenGLAssetManager::loadMesh");
-    AssetID id;
+    Internal &internal = *this->m_internal;
+    AssetID   id;
 
-    if (!this->m_internal->findCache(mesh.name(), this->m_internal->t_meshCache, id))
-        id = this->m_internal->loadMesh(mesh);
+    if (internal.findCache(mesh.name(), internal.t_meshCache, id)) return id;
+    internal.execute([&]() {
+        if (!internal.findCache(mesh.name(), internal.t_meshCache, id)) id = internal.loadMesh(mesh);
+    });
 
     return id;
 }
@@ -164,21 +251,74 @@ AssetID OpenGLAssetManager::loadMesh(const core::assets::Mesh &mesh)
 AssetID OpenGLAssetManager::loadTexture(const core::assets::Texture &texture)
 {
     L_TAG("OpenGLAssetManager::loadTexture");
-    AssetID id;
+    Internal &internal = *this->m_internal;
+    AssetID   id;
 
-    if (!this->m_internal->findCache(texture.name(), this->m_internal->t_textureCache, id))
-        id = this->m_internal->loadTexture(texture);
+    if (internal.findCache(texture.name(), internal.t_textureCache, id)) return id;
+    internal.execute([&]() {
+        if (!internal.findCache(texture.name(), internal.t_textureCache, id)) id = internal.loadTexture(texture);
+    });
 
     return id;
 }
 
+AssetID OpenGLAssetManager::loadTextureAsync(const AssetName &name)
+{
+    L_TAG("OpenGLAssetManager::loadTextureAsync");
+    Internal &internal = *this->m_internal;
+    AssetID   id;
+
+    if (internal.findCache(name, internal.t_textureCache, id)) return id;
+
+    /** missing assets fail here like a synchronous load, decode errors only get logged */
+    if (!AssetInventory::getInstance().hasAsset(AssetType::Texture, name))
+        L_THROW_RUNTIME("Could not find texture {}", name);
+
+    internal.execute([&]() {
+        if (internal.findCache(name, internal.t_textureCache, id)) return;
+
+        /** transparent until the image is swapped in, sprites just show up once loaded */
+        static const std::uint8_t placeholder[4] = {0, 0, 0, 0};
+        id = internal.loadTexture(core::assets::Texture(name, 1, 1, placeholder));
+        internal.streamer.request(internal.getTexture(id).getTextureID(), name);
+    });
+
+    return id;
+}
+
+void OpenGLAssetManager::updateTexture(AssetID id, const core::assets::Texture &texture)
+{
+    L_TAG("OpenGLAssetManager::updateTexture");
+
+    this->m_internal->execute([&]() {
+        OpenGLTexture &glTexture = this->m_internal->getTexture(id);
+        this->m_internal->streamer.cancel(glTexture.getTextureID());
+        glTexture.update(texture);
+        L_DEBUG("Texture updated {}: {}", id, texture.name());
+    });
+}
+
+void OpenGLAssetManager::updateTextureRegion(AssetID id, const core::assets::Texture &region, std::size_t x, std::size_t y)
+{
+    L_TAG("OpenGLAssetManager::updateTextureRegion");
+
+    this->m_internal->execute([&]() {
+        this->m_internal->getTexture(id).update(region, x, y);
+        L_TRACE("Texture {} region updated at ({}, {}): {}", id, x, y, region.name());
+    });
+}
+
 AssetID OpenGLAssetManager::loadPipeline(const core::assets::Shader &shader)
 {
     L_TAG("OpenGLAssetManager::loadPipeline");
-    AssetID id;
+    Internal &internal = *this->m_internal;
+    AssetID   id;
 
-    if (!this->m_internal->findCache(shader.name(), this->m_internal->shaderCache, id))
-        id = this->m_internal->loadPipeline(shader);
+    if (internal.findCache(shader.name(), internal.shaderCache, id) && internal.isResolved(id)) return id;
+    internal.execute([&]() {
+        if (!internal.findCache(shader.name(), internal.shaderCache, id)) id = internal.loadPipeline(shader);
+        internal.resolveInstanced(id);
+    });
 
     return id;
 }
@@ -189,6 +329,8 @@ OpenGLMesh &OpenGLAssetManager::getMesh(AssetID id) const
     return this->m_internal->getMesh(id);
 }
 
+const MeshBounds &OpenGLAssetManager::getMeshBounds(AssetID id) const { return getMesh(id).getBounds(); }
+
 OpenGLPipeline &OpenGLAssetManager::getPipeline(AssetID id) const
 {
     L_TAG("OpenGLAssetManager::getPipeline");
@@ -201,6 +343,18 @@ OpenGLTexture &OpenGLAssetManager::getTexture(AssetID id) const
     return this->m_internal->getTexture(id);
 }
 
+AssetID OpenGLAssetManager::getInstancedPipeline(AssetID pipeline) const
+{
+    std::lock_guard<std::mutex> l(this->m_internal->mutex);
+
+    auto it = this->m_internal->instancedPipelines.find(pipeline);
+    return it != this->m_internal->instancedPipelines.end() ? it->second : -1;
+}
+
+void OpenGLAssetManager::streamTextures(RendererStats &stats) { this->m_internal->streamer.update(stats); }
+
+void OpenGLAssetManager::setExecutor(Executor executor) { this->m_internal->executor = std::move(executor); }
+
 OpenGLAssetManager::OpenGLAssetManager() : m_internal(std::make_unique<Internal>()) {}
 OpenGLAssetManager::OpenGLAssetManager(OpenGLAssetManager &&o)            = default;
 OpenGLAssetManager &OpenGLAssetManager::operator=(OpenGLAssetManager &&o) = default;
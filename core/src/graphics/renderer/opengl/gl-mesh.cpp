@@ -1,4 +1,5 @@
 #include <core/graphics/renderer/opengl/gl-mesh.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
 
 #include <utils/logging.hpp>
 
@@ -37,7 +38,7 @@ static GLuint createVertexBuffer(const core::assets::Mesh &mesh)
     {
         PROFILER_BLOCK("OpenGLMesh::createVertexBuffer::glBufferData");
         glGenBuffers(1, &bufferId);
-        glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+        OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, bufferId);
         glBufferData(GL_ARRAY_BUFFER, bufferSize, bufferDataPtr, GL_STATIC_DRAW);
     }
 
@@ -51,7 +52,7 @@ static GLuint createIndiceBuffer(const core::assets::Mesh &mesh)
 
     GLuint bufferId;
     glGenBuffers(1, &bufferId);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
+    OpenGLStateCache::current().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER,
                  mesh.getIndices().size() * sizeof(uint32_t),
                  mesh.getIndices().data(),
@@ -65,6 +66,9 @@ static OpenGLMesh::VertexInfo createGLMesh(const core::assets::Mesh &mesh)
 {
     L_TAG("OpenGLMesh::createGLMesh(&mesh)");
 
+    /** binding the indice buffer would otherwise change whichever vertex array is bound */
+    if (OpenGLMesh::supportsVertexArrays()) OpenGLStateCache::current().bindVertexArray(0);
+
     OpenGLMesh::VertexInfo vertexInfo;
     vertexInfo.vertexBufferID   = ::createVertexBuffer(mesh);
     vertexInfo.indiceBufferID   = ::createIndiceBuffer(mesh);
@@ -81,45 +85,92 @@ static OpenGLMesh::VertexInfo createGLMesh(const core::assets::Mesh &mesh)
     /** @todo: remove tangents, bitangents from stride if mesh does not have them */
     /** @todo support for vertex buffer with no normals */
 
+    /** attribute pointers are recorded in vertex arrays, see OpenGLMesh::getVertexArray */
+    return vertexInfo;
+}
+
+OpenGLMesh::OpenGLMesh(const core::assets::Mesh &mesh) : m_vertexInfo(::createGLMesh(mesh)), m_bounds(mesh.getBounds())
+{
+    L_TAG("OpenGLMesh::Internal");
+    L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
+}
+
+OpenGLMesh::OpenGLMesh()                          = default;
+OpenGLMesh::OpenGLMesh(OpenGLMesh &&o)            = default;
+OpenGLMesh &OpenGLMesh::operator=(OpenGLMesh &&o) = default;
+
+OpenGLMesh::~OpenGLMesh()
+{
+    for (auto &vertexArray : m_vertexArrays)
+        OpenGLStateCache::current().deleteVertexArray(vertexArray.second);
+}
+
+void OpenGLMesh::setupAttributes(std::uint32_t attributeMask) const
+{
+    const VertexInfo &info = m_vertexInfo;
+    const std::uint32_t mask = attributeMask & getLayoutMask();
+
+    OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, info.vertexBufferID);
+    OpenGLStateCache::current().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, info.indiceBufferID);
+
     /** Configure and pass geometry vertices */
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexInfo.stride, reinterpret_cast<const void *>(vertexInfo.offsetPosition));
+    if (mask & (1u << 0))
+    {
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, info.stride, reinterpret_cast<const void *>(info.offsetPosition));
+    }
 
     /** Configure and pass vertex normals */
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, vertexInfo.stride, reinterpret_cast<const void *>(vertexInfo.offsetNormals));
+    if (mask & (1u << 1))
+    {
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, info.stride, reinterpret_cast<const void *>(info.offsetNormals));
+    }
 
     /** Configure and pass uv coordinates */
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, vertexInfo.stride, reinterpret_cast<const void *>(vertexInfo.offsetTexCoords));
+    if (mask & (1u << 2))
+    {
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, info.stride, reinterpret_cast<const void *>(info.offsetTexCoords));
+    }
 
-    if(vertexInfo.hasTangents)
+    /** Configure and pass tangents */
+    if (mask & (1u << 3))
     {
-        /** Configure and pass tangents */
         glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, vertexInfo.stride, reinterpret_cast<const void *>(vertexInfo.offsetTangents));
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, info.stride, reinterpret_cast<const void *>(info.offsetTangents));
     }
 
-    if(vertexInfo.hasBitangents)
+    /** Configure and pass bitangents, a_bt is bound to location 5 */
+    if (mask & (1u << 5))
     {
-        /** Configure and pass bitangents */
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, vertexInfo.stride, reinterpret_cast<const void *>(vertexInfo.offsetBitangents));
+        glEnableVertexAttribArray(5);
+        glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, info.stride, reinterpret_cast<const void *>(info.offsetBitangents));
     }
-
-    return vertexInfo;
 }
 
-OpenGLMesh::OpenGLMesh(const core::assets::Mesh &mesh) : m_vertexInfo(::createGLMesh(mesh))
+GLuint OpenGLMesh::getVertexArray(std::uint32_t attributeMask) const
 {
-    L_TAG("OpenGLMesh::Internal");
-    L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
+    L_TAG("OpenGLMesh::getVertexArray");
+    if (!supportsVertexArrays()) return 0;
+
+    /** attributes the mesh doesn't have can't be enabled, those pipelines share a vertex array */
+    const std::uint32_t mask = attributeMask & getLayoutMask();
+    for (auto &vertexArray : m_vertexArrays)
+        if (vertexArray.first == mask) return vertexArray.second;
+
+    GLuint vertexArray;
+    glGenVertexArrays(1, &vertexArray);
+    OpenGLStateCache::current().bindVertexArray(vertexArray);
+    setupAttributes(mask);
+    OpenGLStateCache::current().bindVertexArray(0);
+
+    m_vertexArrays.emplace_back(mask, vertexArray);
+    L_TRACE("Vertex array {} created for mesh buffer {}, attributes 0x{:X}", vertexArray, m_vertexInfo.vertexBufferID, mask);
+    return vertexArray;
 }
 
-OpenGLMesh::OpenGLMesh()                          = default;
-OpenGLMesh::OpenGLMesh(OpenGLMesh &&o)            = default;
-OpenGLMesh &OpenGLMesh::operator=(OpenGLMesh &&o) = default;
-OpenGLMesh::~OpenGLMesh()                         = default;
+bool OpenGLMesh::supportsVertexArrays() { return GLEW_VERSION_3_0 || GLEW_ARB_vertex_array_object; }
 
 const GLuint                 &OpenGLMesh::getVertexBufferID() const noexcept { return m_vertexInfo.vertexBufferID; }
 const GLuint                 &OpenGLMesh::getIndiceBufferID() const noexcept { return m_vertexInfo.indiceBufferID; }
@@ -128,4 +179,13 @@ const GLsizei                &OpenGLMesh::getStride() const noexcept { return m_
 const GLsizei                &OpenGLMesh::getOffsetPosition() const noexcept { return m_vertexInfo.offsetPosition; }
 const GLsizei                &OpenGLMesh::getOffsetNormals() const noexcept { return m_vertexInfo.offsetNormals; }
 const GLsizei                &OpenGLMesh::getOffsetTexCoords() const noexcept { return m_vertexInfo.offsetTexCoords; }
-const OpenGLMesh::VertexInfo &OpenGLMesh::getVertexInfo() const noexcept { return m_vertexInfo; }
\ No newline at end of file
+const OpenGLMesh::VertexInfo &OpenGLMesh::getVertexInfo() const noexcept { return m_vertexInfo; }
+const MeshBounds             &OpenGLMesh::getBounds() const noexcept { return m_bounds; }
+
+std::uint32_t OpenGLMesh::getLayoutMask() const noexcept
+{
+    std::uint32_t mask = (1u << 0) | (1u << 1) | (1u << 2);
+    if (m_vertexInfo.hasTangents) mask |= (1u << 3);
+    if (m_vertexInfo.hasBitangents) mask |= (1u << 5);
+    return mask;
+}
\ No newline at end of file
@@ -1,19 +1,23 @@
 #include <core/graphics/renderer/opengl/gl-pipeline.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
 #include <assets/utils.hpp>
 #include <utils/logging.hpp>
 
+#include <algorithm>
 #include <vector>
 
 struct UniformConfig
 {
-    GLint  index;
-    GLint  size;
-    GLenum type;
+    OpenGLPipeline::UniformHandle handle;
+    GLint                         index; /** uniform location */
+    GLint                         size;
+    GLenum                        type;
 };
 
 struct AttributeConfig
 {
     GLint  index;
+    GLint  location;
     GLint  size;
     GLenum type;
 };
@@ -24,7 +28,7 @@ static GLuint compileShader(const GLenum shaderType, const std::string &shaderSo
 
     GLuint shaderId = glCreateShader(shaderType);
 
-    std::vector<char> shaderSourceData = core::assets::utils::loadBinaryFile(shaderSource);
+    AssetSpan shaderSourceData = core::assets::utils::loadBinaryFile(shaderSource);
 
     const char *shaderData         = shaderSourceData.data();
     GLint       shaderSourceLength = shaderSourceData.size();
@@ -95,6 +99,8 @@ static GLuint createPipelineProgram(const core::assets::Shader &shader)
     glBindAttribLocation(shaderProgramId, 2, "a_vt"); // texture coordinates
     glBindAttribLocation(shaderProgramId, 3, "a_t");  // tangents
     glBindAttribLocation(shaderProgramId, 5, "a_bt"); // bitangents
+    glBindAttribLocation(shaderProgramId, 6, "a_c");  // vertex color
+    glBindAttribLocation(shaderProgramId, 8, "a_model"); // per-instance model matrix (8-11)
 
     /** Link and check result */
     GLint res;
@@ -142,6 +148,8 @@ static GLuint createPipelineProgram(const std::vector<OpenGLPipeline::ShaderStag
     glBindAttribLocation(shaderProgramId, 2, "a_vt"); // texture coordinates
     glBindAttribLocation(shaderProgramId, 3, "a_t");  // tangents
     glBindAttribLocation(shaderProgramId, 5, "a_bt"); // bitangents
+    glBindAttribLocation(shaderProgramId, 6, "a_c");  // vertex color
+    glBindAttribLocation(shaderProgramId, 8, "a_model"); // per-instance model matrix (8-11)
 
     /** Link and check result */
     GLint res;
@@ -167,10 +175,11 @@ static GLuint createPipelineProgram(const std::vector<OpenGLPipeline::ShaderStag
     return shaderProgramId;
 }
 
-std::unordered_map<std::string, UniformConfig> getProgramUniforms(GLuint shaderProgramID)
+/** Resolves the active uniforms into a table sorted by handle */
+std::vector<UniformConfig> getProgramUniforms(GLuint shaderProgramID)
 {
     L_TAG("OpenGLPipeline::getProgramUniforms(programID)");
-    std::unordered_map<std::string, UniformConfig> uniformMap;
+    std::vector<UniformConfig> uniformTable;
 
     constexpr GLsizei uniformNameSize = 32;
     GLchar            name[uniformNameSize];
@@ -186,9 +195,26 @@ std::unordered_map<std::string, UniformConfig> getProgramUniforms(GLuint shaderP
         glGetActiveUniform(shaderProgramID, i, uniformNameSize, &nameLength, &size, &type, name);
         L_TRACE("Uniform: {}: {}; Type: 0x{:X}; Size: {}", i, name, type, size);
 
-        uniformMap[std::string(name)] = UniformConfig{.index = i, .size = size, .type = type};
+        /** arrays are reported as "name[0]", address them by the plain name */
+        std::string_view uniformName(name, nameLength);
+        if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]")
+            uniformName.remove_suffix(3);
+
+        /** the active uniform index is not the location */
+        uniformTable.push_back(UniformConfig{.handle = OpenGLPipeline::uniformHandle(uniformName),
+                                             .index  = glGetUniformLocation(shaderProgramID, name),
+                                             .size   = size,
+                                             .type   = type});
     }
-    return std::move(uniformMap);
+
+    std::sort(uniformTable.begin(), uniformTable.end(), [](const UniformConfig &a, const UniformConfig &b) {
+        return a.handle < b.handle;
+    });
+    for (std::size_t i = 1; i < uniformTable.size(); i++)
+        L_ASSERT(uniformTable[i - 1].handle != uniformTable[i].handle,
+                 "Pipeline {}: uniform handle collision",
+                 shaderProgramID);
+    return uniformTable;
 }
 
 std::unordered_map<std::string, AttributeConfig> getProgramAttributes(GLuint shaderProgramID)
@@ -210,35 +236,51 @@ std::unordered_map<std::string, AttributeConfig> getProgramAttributes(GLuint sha
         glGetActiveAttrib(shaderProgramID, i, attributeNameSize, &nameLength, &size, &type, name);
         L_TRACE("Attribute: {}: {}; Type: 0x{:X}; Size: {}", i, name, type, size);
 
-        attributeMap[std::string(name)] = AttributeConfig{.index = i, .size = size, .type = type};
+        attributeMap[std::string(name)] = AttributeConfig{.index    = i,
+                                                          .location = glGetAttribLocation(shaderProgramID, name),
+                                                          .size     = size,
+                                                          .type     = type};
     }
     return std::move(attributeMap);
 }
 
+/** Mask of the per-vertex attribute locations read by the program, instance attributes excluded */
+static std::uint32_t getAttributeMask(const std::unordered_map<std::string, AttributeConfig> &attributes)
+{
+    std::uint32_t mask = 0;
+    for (auto &attribute : attributes)
+        if (attribute.second.location >= 0 && attribute.second.location < 8) mask |= 1u << attribute.second.location;
+    return mask;
+}
+
 struct OpenGLPipeline::Internal
 {
     const std::string                                      pipelineName;
     const GLuint                                           shaderProgramId;
     const GLint                                            su_mvp;
+    const GLint                                            su_vp;
     const GLint                                            sa_vertices;
     const GLint                                            sa_vertexNormals;
     const GLint                                            sa_textureVertice;
     const GLint                                            sa_tangents;
     const GLint                                            sa_bitangents;
-    const std::unordered_map<std::string, UniformConfig>   uniforms;
+    const std::vector<UniformConfig>                       uniforms; /** sorted by handle */
     const std::unordered_map<std::string, AttributeConfig> attributes;
+    const std::uint32_t                                    attributeMask;
 
     Internal(const std::string &name, const std::vector<ShaderStage> &shaderStages)
         : pipelineName(name),
           shaderProgramId(::createPipelineProgram(shaderStages)),
           su_mvp(glGetUniformLocation(shaderProgramId, "u_mvp")),
+          su_vp(glGetUniformLocation(shaderProgramId, "u_vp")),
           sa_vertices(glGetAttribLocation(shaderProgramId, "a_v")),
           sa_vertexNormals(glGetAttribLocation(shaderProgramId, "a_vn")),
           sa_textureVertice(glGetAttribLocation(shaderProgramId, "a_vt")),
           sa_tangents(glGetAttribLocation(shaderProgramId, "a_t")),
           sa_bitangents(glGetAttribLocation(shaderProgramId, "a_bt")),
           uniforms(::getProgramUniforms(shaderProgramId)),
-          attributes(::getProgramAttributes(shaderProgramId))
+          attributes(::getProgramAttributes(shaderProgramId)),
+          attributeMask(::getAttributeMask(attributes))
     {
         L_TAG("OpenGLPipeline::Internal");
         L_DEBUG("Pipeline \"{}\" created with {} shaders", pipelineName, shaderStages.size());
@@ -249,19 +291,29 @@ struct OpenGLPipeline::Internal
         : pipelineName(shader.name()),
           shaderProgramId(::createPipelineProgram(shader)),
           su_mvp(glGetUniformLocation(shaderProgramId, "u_mvp")),
+          su_vp(glGetUniformLocation(shaderProgramId, "u_vp")),
           sa_vertices(glGetAttribLocation(shaderProgramId, "a_v")),
           sa_vertexNormals(glGetAttribLocation(shaderProgramId, "a_vn")),
           sa_textureVertice(glGetAttribLocation(shaderProgramId, "a_vt")),
           sa_tangents(glGetAttribLocation(shaderProgramId, "a_t")),
           sa_bitangents(glGetAttribLocation(shaderProgramId, "a_bt")),
           uniforms(::getProgramUniforms(shaderProgramId)),
-          attributes(::getProgramAttributes(shaderProgramId))
+          attributes(::getProgramAttributes(shaderProgramId)),
+          attributeMask(::getAttributeMask(attributes))
     {
         L_TAG("OpenGLPipeline::Internal");
         L_DEBUG("Pipeline \"{}\" created with {} shaders", pipelineName, shader.stageCount());
         L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
     }
 
+    const UniformConfig *findUniform(UniformHandle handle) const
+    {
+        auto it = std::lower_bound(uniforms.begin(), uniforms.end(), handle, [](const UniformConfig &u, UniformHandle h) {
+            return u.handle < h;
+        });
+        return (it != uniforms.end() && it->handle == handle) ? &*it : nullptr;
+    }
+
     void setUniform(const UniformConfig &uniform,
                     void                *data,
                     std::size_t          dataLength,
@@ -336,165 +388,113 @@ struct OpenGLPipeline::Internal
         L_TRACE("Internal resources freed ({})", static_cast<void *>(this));
     }
 
+    /** Binds the vertex array of @p mesh, or configures the attributes without one */
+    void bindMesh(const OpenGLMesh &mesh)
+    {
+        GLuint vertexArray = mesh.getVertexArray(attributeMask);
+        if (vertexArray)
+            OpenGLStateCache::current().bindVertexArray(vertexArray);
+        else
+            mesh.setupAttributes(attributeMask);
+    }
+
+    /** Restores the default attribute state after @ref bindMesh */
+    void unbindMesh(const OpenGLMesh &mesh)
+    {
+        if (OpenGLMesh::supportsVertexArrays())
+        {
+            OpenGLStateCache::current().bindVertexArray(0);
+            return;
+        }
+        for (GLuint location = 0; location < 8; location++)
+            if (mesh.getLayoutMask() & (1u << location)) glDisableVertexAttribArray(location);
+    }
+
     void render(const OpenGLMesh &mesh, const glm::mat4 &mvp)
     {
         L_TAG("OpenGLPipeline::render(OpenGLMesh)");
 
-        GLsizei stride = mesh.getStride();
-
         /** Render in wireframe */
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        OpenGLStateCache::current().polygonMode(GL_LINE);
 
         /** Use pipeline program */
-        glUseProgram(shaderProgramId);
+        OpenGLStateCache::current().useProgram(shaderProgramId);
 
         /** Pass mvp to shader program */
         glUniformMatrix4fv(su_mvp, 1, GL_FALSE, &mvp[0][0]);
 
-        /** Bind buffers and default texture */
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.getVertexBufferID());
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.getIndiceBufferID());
-        // glBindTexture(GL_TEXTURE_2D, 0);
-
-        /** Configure and pass geometry vertices */
-        GLsizei offsetV = mesh.getOffsetPosition();
-        glEnableVertexAttribArray(sa_vertices);
-        glVertexAttribPointer(sa_vertices,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              stride,
-                              reinterpret_cast<const void *>(offsetV));
-
-        /** Configure and pass vertex normals */
-        GLsizei offsetVN = mesh.getOffsetNormals();
-        glEnableVertexAttribArray(sa_vertexNormals);
-        glVertexAttribPointer(sa_vertexNormals,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              stride,
-                              reinterpret_cast<const void *>(offsetVN));
-
-        /** Configure and pass uv coordinates */
-        GLsizei offsetVT = mesh.getOffsetTexCoords();
-        glEnableVertexAttribArray(sa_textureVertice);
-        glVertexAttribPointer(sa_textureVertice,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              stride,
-                              reinterpret_cast<const void *>(offsetVT));
-
         /** Render mesh with wireframe */
+        bindMesh(mesh);
         glDrawElements(GL_TRIANGLES,
                        mesh.getIndiceCount(),
                        GL_UNSIGNED_INT,
                        reinterpret_cast<const GLvoid *>(0));
-
-        glDisableVertexAttribArray(sa_vertices);
-        glDisableVertexAttribArray(sa_vertexNormals);
-        glDisableVertexAttribArray(sa_textureVertice);
+        unbindMesh(mesh);
     }
 
     void render(const OpenGLMesh &mesh, const OpenGLTexture &texture, const glm::mat4 &mvp)
     {
         L_TAG("OpenGLPipeline::render(OpenGLMesh, OpenGLTexture)");
 
-        GLsizei stride    = mesh.getStride();
-        GLsizei offsetV   = mesh.getOffsetPosition();
-        GLsizei offsetVN  = mesh.getOffsetNormals();
-        GLsizei offsetVT  = mesh.getOffsetTexCoords();
-        GLuint  textureID = texture.getTextureID();
-
-        /** Render in wireframe */
-        // glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
         /** Use pipeline program */
-        glUseProgram(shaderProgramId);
+        OpenGLStateCache::current().useProgram(shaderProgramId);
 
         /** Pass mvp to shader program */
         glUniformMatrix4fv(su_mvp, 1, GL_FALSE, &mvp[0][0]);
+        OpenGLStateCache::current().bindTexture(GL_TEXTURE_2D, texture.getTextureID());
 
-        /** Bind buffers and default texture */
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.getVertexBufferID());
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.getIndiceBufferID());
-        glBindTexture(GL_TEXTURE_2D, textureID);
-
-        /** Configure and pass geometry vertices */
-        glEnableVertexAttribArray(sa_vertices);
-        glVertexAttribPointer(sa_vertices,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              stride,
-                              reinterpret_cast<const void *>(offsetV));
-
-        /** Configure and pass vertex normals */
-        glEnableVertexAttribArray(sa_vertexNormals);
-        glVertexAttribPointer(sa_vertexNormals,
-                              3,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              stride,
-                              reinterpret_cast<const void *>(offsetVN));
-
-        /** Configure and pass uv coordinates */
-        glEnableVertexAttribArray(sa_textureVertice);
-        glVertexAttribPointer(sa_textureVertice,
-                              2,
-                              GL_FLOAT,
-                              GL_FALSE,
-                              stride,
-                              reinterpret_cast<const void *>(offsetVT));
-
-        /** Render mesh with wireframe */
+        bindMesh(mesh);
         glDrawElements(GL_TRIANGLES,
                        mesh.getIndiceCount(),
                        GL_UNSIGNED_INT,
                        reinterpret_cast<const GLvoid *>(0));
-
-        glDisableVertexAttribArray(sa_vertices);
-        glDisableVertexAttribArray(sa_vertexNormals);
-        glDisableVertexAttribArray(sa_textureVertice);
+        unbindMesh(mesh);
     }
 
     void render(RenderInfo &renderInfo)
     {
         L_TAG("OpenGLPipeline::render(&renderInfo)");
 
-        glUseProgram(shaderProgramId);
+        OpenGLStateCache::current().useProgram(shaderProgramId);
 
         // Bind textures to each texture unit
         // glBindTextures(0, renderInfo.textures.size(), renderInfo.textures.data());
-        glBindTexture(GL_TEXTURE_2D, renderInfo.textures[0]);
+        if (!renderInfo.textures.empty()) OpenGLStateCache::current().bindTexture(GL_TEXTURE_2D, renderInfo.textures[0]);
         // Bind buffers
         for (auto &buffer : renderInfo.buffers)
-            glBindBuffer(buffer.first, buffer.second);
+            OpenGLStateCache::current().bindBuffer(buffer.first, buffer.second);
+
+        // Configure vertex attributes from the bound array buffer
+        for (auto &attribute : renderInfo.attributes)
+        {
+            glEnableVertexAttribArray(attribute.index);
+            glVertexAttribPointer(attribute.index,
+                                  attribute.size,
+                                  attribute.type,
+                                  attribute.normalized,
+                                  attribute.stride,
+                                  reinterpret_cast<const void *>(attribute.offset));
+        }
 
         for (auto &uniform : renderInfo.uniforms)
         {
-            /** check first if pipeline has uniform with matching name
-             * @todo: maybe change string names with compile time hashes
-             */
-            auto uniformConfig = uniforms.find(uniform.first);
-            if (uniformConfig == uniforms.end()) continue;
-            // L_THROW_LOGIC("Pipeline {} does not have uniform named {}", shaderProgramId, uniform.first);
+            /** skip uniforms the pipeline doesn't use */
+            const UniformConfig *uniformConfig = findUniform(uniform.handle);
+            if (uniformConfig == nullptr) continue;
 
             /** Sanity check that the expected type matches */
-            L_ASSERT(uniformConfig->second.type == uniform.second.type,
-                     "ShaderUniformType does not match given uniform type");
+            L_ASSERT(uniformConfig->type == uniform.type, "ShaderUniformType does not match given uniform type");
             /** Use helper function for setting uniform */
-            setUniform(uniformConfig->second,
-                       uniform.second.data,
-                       uniform.second.dataSize,
-                       uniform.second.matrixTransponse);
+            setUniform(*uniformConfig, uniform.data, uniform.dataSize, uniform.matrixTransponse);
         }
 
         glDrawElements(renderInfo.drawInfo.drawMode,
                        renderInfo.drawInfo.indiceCount,
                        renderInfo.drawInfo.indiceType,
                        static_cast<GLvoid *>(renderInfo.drawInfo.indiceLocation));
+
+        for (auto &attribute : renderInfo.attributes)
+            glDisableVertexAttribArray(attribute.index);
     }
 };
 
@@ -528,6 +528,66 @@ void OpenGLPipeline::render(const OpenGLMesh    &mesh,
 
 void OpenGLPipeline::render(RenderInfo &renderInfo) const { m_internal->render(renderInfo); }
 
+bool OpenGLPipeline::hasUniform(UniformHandle handle) const { return m_internal->findUniform(handle) != nullptr; }
+
+void OpenGLPipeline::bind() const { OpenGLStateCache::current().useProgram(m_internal->shaderProgramId); }
+
+void OpenGLPipeline::bindMesh(const OpenGLMesh &mesh) const { m_internal->bindMesh(mesh); }
+
+void OpenGLPipeline::unbindMesh(const OpenGLMesh &mesh) const { m_internal->unbindMesh(mesh); }
+
+std::uint32_t OpenGLPipeline::getAttributeMask() const noexcept { return m_internal->attributeMask; }
+
+void OpenGLPipeline::bindTexture(const OpenGLTexture &texture) const
+{
+    OpenGLStateCache::current().bindTexture(GL_TEXTURE_2D, texture.getTextureID());
+}
+
+void OpenGLPipeline::draw(const OpenGLMesh &mesh, const glm::mat4 &mvp) const
+{
+    glUniformMatrix4fv(m_internal->su_mvp, 1, GL_FALSE, &mvp[0][0]);
+    glDrawElements(GL_TRIANGLES, mesh.getIndiceCount(), GL_UNSIGNED_INT, reinterpret_cast<const GLvoid *>(0));
+}
+
+void OpenGLPipeline::drawInstanced(const OpenGLMesh &mesh,
+                                   GLuint            instanceBuffer,
+                                   std::size_t       offset,
+                                   GLsizei           count,
+                                   const glm::mat4  &viewProjection) const
+{
+    constexpr GLuint modelLocation = 8;
+
+    glUniformMatrix4fv(m_internal->su_vp, 1, GL_FALSE, &viewProjection[0][0]);
+
+    /** mat4 attribute takes 4 locations, one column each, advanced once per instance */
+    OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (GLuint c = 0; c < 4; c++)
+    {
+        glEnableVertexAttribArray(modelLocation + c);
+        glVertexAttribPointer(modelLocation + c,
+                              4,
+                              GL_FLOAT,
+                              GL_FALSE,
+                              sizeof(glm::mat4),
+                              reinterpret_cast<const void *>(offset + c * sizeof(glm::vec4)));
+        glVertexAttribDivisor(modelLocation + c, 1);
+    }
+
+    glDrawElementsInstanced(GL_TRIANGLES,
+                            mesh.getIndiceCount(),
+                            GL_UNSIGNED_INT,
+                            reinterpret_cast<const GLvoid *>(0),
+                            count);
+
+    for (GLuint c = 0; c < 4; c++)
+    {
+        glVertexAttribDivisor(modelLocation + c, 0);
+        glDisableVertexAttribArray(modelLocation + c);
+    }
+}
+
+bool OpenGLPipeline::supportsInstancing() { return GLEW_VERSION_3_3; }
+
 GLenum OpenGLPipeline::shaderTypeFromName(const std::string &name)
 {
     L_TAG("OpenGLPipeline::shaderTypeFromName");
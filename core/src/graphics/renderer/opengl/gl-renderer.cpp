@@ -2,10 +2,29 @@
 #include <core/graphics/renderer/opengl/gl-renderer.hpp>
 #include <core/graphics/renderer/opengl/gl-wrapper.hpp>
 #include <core/graphics/renderer/opengl/gl-assetManager.hpp>
+#include <core/graphics/renderer/opengl/gl-spriteBatcher.hpp>
+#include <core/graphics/renderer/opengl/gl-ringBuffer.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
+#include <core/graphics/renderQueue.hpp>
+#include <core/graphics/culling.hpp>
+#include <core/graphics/framePacket.hpp>
+#include <core/utils/profiler.hpp>
+#include <core/utils/hash.hpp>
 
 #include <SDL.h>
 #include <SDL_video.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <utils/logging.hpp>
 
 static void initGL()
@@ -21,6 +40,10 @@ static void initGL()
 
     /** Initialize glew */
     GLenum gres = glewInit();
+#if defined(GLEW_ERROR_NO_GLX_DISPLAY)
+    /** EGL contexts (offscreen video driver) have no GLX display, the entry points still load */
+    if (gres == GLEW_ERROR_NO_GLX_DISPLAY) gres = GLEW_OK;
+#endif
     if (gres != GLEW_OK)
     {
         L_THROW_RUNTIME("Failed to initialize glew");
@@ -62,17 +85,8 @@ SDL_GLContext createContext(SDL_Window *window)
              "Error initializing Modelview Matrix: {}",
              reinterpret_cast<const char *>(glewGetErrorString(error)));
 
-    // Enable Alpha blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Enable Depth testing (clear first) with LEQUAL function test
+    // Blending, depth testing and face culling are enabled through the state cache, see initState
     glClearDepth(1.0f);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
-
-    // Enable face culling, defaults to GL_BACK (back-facing faces)
-    glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
 
     // Set viewport size
@@ -82,32 +96,417 @@ SDL_GLContext createContext(SDL_Window *window)
     return context;
 }
 
+/** Initial bytes per frame of the stream buffer, it grows to the largest frame seen */
+static constexpr std::size_t streamBufferSize = 1 << 20;
+
+/** Default render state, set through the cache so it starts out known */
+static void initState(OpenGLStateCache &state)
+{
+    // Enable Alpha blending
+    state.setEnabled(GL_BLEND, true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Enable Depth testing with LEQUAL function test
+    state.setEnabled(GL_DEPTH_TEST, true);
+    state.depthFunc(GL_LEQUAL);
+    state.depthMask(GL_TRUE);
+
+    // Enable face culling, defaults to GL_BACK (back-facing faces)
+    state.setEnabled(GL_CULL_FACE, true);
+
+    state.polygonMode(GL_FILL);
+    state.activeTexture(0);
+}
+
+static float elapsedMs(time_us since) { return (Time::getTime<time_us>() - since).count() / 1000.0f; }
+
+static void render(OpenGLAssetManager                     &am,
+                   OpenGLSpriteBatcher                    &batcher,
+                   OpenGLRingBuffer                       &stream,
+                   FrameCulling                           &culling,
+                   RendererStats                          &stats,
+                   const FramePacket::Camera              &camera,
+                   const std::vector<FramePacket::Sprite> &sprites)
+{
+    const std::vector<std::size_t> &visible = culling.sprites(camera, sprites, stats);
+    if (visible.empty()) return;
+
+    for (auto index : visible)
+    {
+        auto &sprite = sprites[index];
+        batcher.submit(sprite.layer, sprite.pipeline, sprite.texture, sprite.model, sprite.uvRect, sprite.color);
+    }
+
+    batcher.flush(am, stream, camera.projection * camera.view, stats);
+}
+
+static void render(OpenGLAssetManager                   &am,
+                   OpenGLSpriteBatcher                  &batcher,
+                   RendererStats                        &stats,
+                   const FramePacket::Camera            &camera,
+                   const std::vector<FramePacket::Text> &texts)
+{
+    /** the packet index picks the buffer, unchanged batches keep their upload */
+    for (std::size_t i = 0; i < texts.size(); i++)
+    {
+        auto &text = texts[i];
+        if (!isVisibleTo(camera, text.renderMask)) continue;
+        batcher.drawText(am, i, text.pipeline, *text.mesh, camera.projection * camera.view, stats);
+    }
+}
+
+/** Replays the render queue on OpenGL, see RenderQueue::submit */
+struct OpenGLQueueBackend
+{
+    OpenGLAssetManager   &am;
+    OpenGLRingBuffer     &stream;
+    const glm::mat4       viewProjection;
+
+    AssetID               pipelineID    = -1;
+    const OpenGLPipeline *pipeline      = nullptr; /** pipeline of the current draws */
+    const OpenGLPipeline *active        = nullptr; /** program actually bound, may be an instanced variant */
+    const OpenGLMesh     *mesh          = nullptr;
+    std::uint32_t         attributeMask = 0; /** attributes the bound vertex array was chosen for */
+
+    void use(const OpenGLPipeline *p)
+    {
+        if (active == p) return;
+        p->bind();
+        active = p;
+    }
+
+    void bindPipeline(const DrawCommand &cmd)
+    {
+        pipelineID = cmd.pipeline;
+        pipeline   = &am.getPipeline(cmd.pipeline);
+        use(pipeline);
+
+        /** the queue keeps the mesh bound across pipelines, its vertex array depends on the attributes read */
+        if (mesh && pipeline->getAttributeMask() != attributeMask) bindMesh(mesh);
+    }
+    void bindTexture(const DrawCommand &cmd) { pipeline->bindTexture(am.getTexture(cmd.texture)); }
+    void bindMesh(const DrawCommand &cmd) { bindMesh(&am.getMesh(cmd.mesh)); }
+    void bindMesh(const OpenGLMesh *m)
+    {
+        mesh          = m;
+        attributeMask = pipeline->getAttributeMask();
+        pipeline->bindMesh(*mesh);
+    }
+    void draw(const DrawCommand &cmd)
+    {
+        use(pipeline);
+        pipeline->draw(*mesh, viewProjection * cmd.model);
+    }
+    bool drawInstanced(const DrawCommand *const *commands, std::size_t count)
+    {
+        AssetID instancedID = am.getInstancedPipeline(pipelineID);
+        if (instancedID < 0)
+        {
+            for (std::size_t i = 0; i < count; i++)
+                draw(*commands[i]);
+            return false;
+        }
+
+        /** room for every draw was reserved before submitting */
+        OpenGLRingBuffer::Allocation range = stream.allocate(count * sizeof(glm::mat4));
+        glm::mat4                   *models = static_cast<glm::mat4 *>(range.data);
+        for (std::size_t i = 0; i < count; i++)
+            models[i] = commands[i]->model;
+        stream.flush();
+
+        const OpenGLPipeline &instanced = am.getPipeline(instancedID);
+        use(&instanced);
+        instanced.drawInstanced(*mesh, range.buffer, range.offset, static_cast<GLsizei>(count), viewProjection);
+        return true;
+    }
+};
+
+static void render(OpenGLAssetManager                   &am,
+                   RenderQueue                          &queue,
+                   OpenGLRingBuffer                     &stream,
+                   FrameCulling                         &culling,
+                   RendererStats                        &stats,
+                   const FramePacket::Camera            &camera,
+                   const std::vector<FramePacket::Mesh> &meshes)
+{
+    queueMeshes(queue, camera, meshes, culling.meshes(am, camera, meshes, stats));
+    if (queue.size() == 0) return;
+
+    /** worst case every draw is instanced, matrices keep the default alignment */
+    stream.reserve(queue.size() * sizeof(glm::mat4));
+
+    OpenGLQueueBackend backend{am, stream, camera.projection * camera.view};
+    queue.submit(backend, stats);
+
+    /** leave attribute state as the per-component render paths expect it */
+    if (backend.mesh) backend.pipeline->unbindMesh(*backend.mesh);
+}
+
+/**
+ * GL objects of the renderer, only used from the thread the context is current
+ * on. Draws frame packets without touching any component.
+ */
+struct OpenGLDevice
+{
+    SDL_Window *const   m_window;
+    OpenGLStateCache    m_stateCache; /** must outlive every GL object owner below */
+    OpenGLAssetManager  m_assetManager;
+    AssetID             m_defaultPipeline;
+    OpenGLSpriteBatcher m_spriteBatcher;
+    RenderQueue         m_renderQueue;
+    OpenGLRingBuffer    m_streamBuffer; /** per-frame sprite vertices and instance matrices */
+    FrameCulling        m_culling;
+    std::vector<char>   m_capture; /** pixels read back for frame checksums */
+
+    OpenGLDevice(SDL_Window *window)
+        : m_window(window),
+          m_stateCache(),
+          m_assetManager(),
+          m_defaultPipeline(m_assetManager.loadAsset(AssetType::Pipeline, "default")),
+          m_spriteBatcher(),
+          m_renderQueue(),
+          m_streamBuffer(streamBufferSize),
+          m_culling()
+    {
+        ::initState(m_stateCache);
+    }
+
+    /** Hashes the RGBA8 pixels of the back buffer */
+    std::uint64_t checksum()
+    {
+        PROFILER_BLOCK("OpenGLDevice::checksum");
+        int width, height;
+        SDL_GL_GetDrawableSize(m_window, &width, &height);
+        m_capture.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadBuffer(GL_BACK);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, m_capture.data());
+        return core::utils::hash_fnv1a(std::string_view(m_capture.data(), m_capture.size()));
+    }
+
+    /**
+     * Draws and presents @p packet, fills @p stats and the device side of @p timings.
+     * The frame is read back and hashed into @p checksum if it isn't null, outside
+     * of the submit time.
+     */
+    void renderFrame(const FramePacket &packet, RendererStats &stats, RenderTimings &timings, std::uint64_t *checksum)
+    {
+        PROFILER_BLOCK("OpenGLDevice::renderFrame");
+        time_us start = Time::getTime<time_us>();
+
+        stats.reset();
+        m_stateCache.resetCounters();
+        m_streamBuffer.beginFrame();
+        m_assetManager.streamTextures(stats);
+
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        /** @todo: fix depth rendering for multiple cameras */
+        for (auto &camera : packet.cameras)
+        {
+            ::render(m_assetManager, m_spriteBatcher, m_streamBuffer, m_culling, stats, camera, packet.sprites);
+            ::render(m_assetManager, m_renderQueue, m_streamBuffer, m_culling, stats, camera, packet.meshes);
+            ::render(m_assetManager, m_spriteBatcher, stats, camera, packet.texts);
+        }
+
+        stats.stateChanges        = m_stateCache.counters().issued;
+        stats.stateChangesSkipped = m_stateCache.counters().skipped;
+        m_streamBuffer.endFrame();
+        timings.submitMs = elapsedMs(start);
+
+        if (checksum) *checksum = this->checksum();
+
+        start = Time::getTime<time_us>();
+        SDL_GL_SwapWindow(m_window);
+        timings.presentMs = elapsedMs(start);
+    }
+};
+
+/**
+ * Frame packets are double buffered: the game loop extracts into
+ * m_packets[m_submitted % 2] while the device renders m_packets[m_completed % 2].
+ * Without a render thread the packet is rendered inline in renderEnd.
+ */
 struct OpenGLRenderer::Internal
 {
-    SDL_Window *const  m_window;
-    SDL_GLContext      m_context;
-    OpenGLAssetManager m_assetManager;
-    AssetID            m_defaultPipeline;
+    SDL_Window *const             m_window;
+    SDL_GLContext                 m_context;
+    FramePresentation            &m_presentation; /** published after each swap */
+    std::unique_ptr<OpenGLDevice> m_device;
+    FramePacket                   m_packets[2];
+    std::uint64_t                 m_submitted      = 0; /** packets handed to the device */
+    std::uint64_t                 m_completed      = 0; /** packets presented */
+    std::size_t                   m_framesInFlight = 1;
+    RendererStats                 m_frameStats;   /** stats of the last presented frame */
+    RenderTimings                 m_frameTimings; /** device timings of the last presented frame */
+    bool                          m_capture       = false;
+    std::uint64_t                 m_frameChecksum = 0; /** checksum of the last presented frame */
+    std::uint64_t                 m_checksum      = 0; /** m_frameChecksum as seen by the game loop */
+    /** (frame number, checksum) of frames presented since takeFrameChecksums, guarded by m_mutex */
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_checksums;
+
+    /** render thread state, guarded by m_mutex */
+    bool                                   m_threaded = false;
+    std::thread                            m_thread;
+    std::thread::id                        m_threadId;
+    std::mutex                             m_mutex;
+    std::condition_variable                m_cv;
+    std::deque<std::packaged_task<void()>> m_tasks;
+    bool                                   m_ready = false;
+    bool                                   m_stop  = false;
+    std::exception_ptr                     m_error;
 
     Internal(SDL_Window        *window,
+             FramePresentation &presentation,
              const std::string &windowTitle,
              const int          windowWidth,
              const int          windowHeight)
         : m_window(window),
           m_context(::createContext(window)),
-          m_assetManager(),
-          m_defaultPipeline(m_assetManager.loadAsset(AssetType::Pipeline, "default"))
+          m_presentation(presentation)
     {
         L_TAG("OpenGLRenderer::Internal");
         L_DEBUG("SDL VideoDriver: {}", SDL_GetCurrentVideoDriver());
+
+#if defined(CONFIG_CORE_RENDER_THREAD)
+        m_threaded       = true;
+        m_framesInFlight = CONFIG_CORE_RENDER_FRAMES_IN_FLIGHT;
+
+        /** the context can only be current on one thread, hand it over */
+        SDL_GL_MakeCurrent(m_window, nullptr);
+        m_thread = std::thread(&Internal::run, this);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_ready; });
+        if (m_error)
+        {
+            lock.unlock();
+            m_thread.join();
+            std::rethrow_exception(m_error);
+        }
+        L_DEBUG("Render thread started ({} frames in flight)", m_framesInFlight);
+#else
+        m_device = std::make_unique<OpenGLDevice>(m_window);
+#endif
         L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
     }
 
     ~Internal()
     {
         L_TAG("OpenGLRenderer::~Internal");
+        if (m_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
         L_TRACE("Internal resources freed ({})", static_cast<void *>(this));
     }
+
+    /** Rethrows an error raised on the render thread, m_mutex must be held */
+    void rethrow()
+    {
+        if (!m_error) return;
+        std::exception_ptr error = m_error;
+        m_error                  = nullptr;
+        std::rethrow_exception(error);
+    }
+
+    /**
+     * Executor of the asset manager, runs @p load on the render thread and waits
+     * for it. Throws once the render thread stopped, the load would never run.
+     */
+    void execute(const std::function<void()> &load)
+    {
+        L_TAG("OpenGLRenderer::execute");
+        if (std::this_thread::get_id() == m_threadId) return load();
+
+        std::packaged_task<void()> task(load);
+        std::future<void>          done = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) L_THROW_RUNTIME("Render thread stopped, can't load assets");
+            m_tasks.push_back(std::move(task));
+        }
+        m_cv.notify_all();
+        done.get();
+    }
+
+    void run()
+    {
+        L_TAG("OpenGLRenderer::run");
+        m_threadId = std::this_thread::get_id();
+        SDL_GL_MakeCurrent(m_window, m_context);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        try
+        {
+            m_device = std::make_unique<OpenGLDevice>(m_window);
+            m_device->m_assetManager.setExecutor([this](const std::function<void()> &load) { execute(load); });
+        }
+        catch (...)
+        {
+            m_error = std::current_exception();
+            m_stop  = true;
+        }
+        m_ready = true;
+        m_cv.notify_all();
+
+        for (;;)
+        {
+            m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty() || m_completed < m_submitted; });
+
+            while (!m_tasks.empty())
+            {
+                std::packaged_task<void()> task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+                lock.unlock();
+                task();
+                lock.lock();
+            }
+
+            if (m_completed < m_submitted && m_device)
+            {
+                const FramePacket &packet   = m_packets[m_completed % 2];
+                RendererStats      stats;
+                RenderTimings      timings;
+                std::uint64_t      checksum = 0;
+                const bool         capture  = m_capture;
+                lock.unlock();
+                try
+                {
+                    m_device->renderFrame(packet, stats, timings, capture ? &checksum : nullptr);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    if (!m_error) m_error = std::current_exception();
+                    lock.unlock();
+                }
+                m_presentation.presented(Time::getTime<time_us>());
+                lock.lock();
+                if (capture) m_checksums.emplace_back(packet.frame, checksum);
+                m_completed++;
+                m_frameStats    = stats;
+                m_frameTimings  = timings;
+                m_frameChecksum = checksum;
+                m_cv.notify_all();
+                continue;
+            }
+
+            if (m_stop) break;
+        }
+        lock.unlock();
+
+        /** GL objects have to be freed with the context current */
+        m_device.reset();
+        SDL_GL_MakeCurrent(m_window, nullptr);
+    }
 };
 
 OpenGLRenderer::OpenGLRenderer(SDL_Window        *window,
@@ -115,8 +514,9 @@ OpenGLRenderer::OpenGLRenderer(SDL_Window        *window,
                                const int          windowWidth,
                                const int          windowHeight)
     : Renderer("OpenGL"),
-      m_internal(std::make_unique<Internal>(window, windowTitle, windowWidth, windowHeight))
+      m_internal(std::make_unique<Internal>(window, framePresentation(), windowTitle, windowWidth, windowHeight))
 {
+    m_timings.framesInFlight = m_internal->m_framesInFlight;
 }
 
 OpenGLRenderer::OpenGLRenderer(OpenGLRenderer &&o)            = default;
@@ -133,105 +533,95 @@ void OpenGLRenderer::refresh() {}
 
 bool OpenGLRenderer::renderBegin()
 {
-    // SDL_GL_MakeCurrent(m_internal->window, m_internal->context);
-
-    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
+    Internal &internal = *m_internal;
+    if (!internal.m_threaded) return true;
+
+    /** backpressure, the packet about to be extracted must not be in use by the render thread */
+    time_us                      start = Time::getTime<time_us>();
+    std::unique_lock<std::mutex> lock(internal.m_mutex);
+    internal.m_cv.wait(lock, [&internal]() {
+        return internal.m_stop || internal.m_submitted - internal.m_completed < internal.m_framesInFlight;
+    });
+    internal.rethrow();
+
+    m_stats                  = internal.m_frameStats;
+    m_timings.submitMs       = internal.m_frameTimings.submitMs;
+    m_timings.presentMs      = internal.m_frameTimings.presentMs;
+    m_timings.framesInFlight = internal.m_framesInFlight;
+    m_timings.waitMs         = elapsedMs(start);
+    internal.m_checksum      = internal.m_frameChecksum;
     return true;
 }
 
-#include <core/ecs/componentManager.hpp>
-#include <core/ecs/components.hpp>
-#include <core/ecs/entity.hpp>
-#include <glm/gtx/transform.hpp>
-#include <core/game.hpp>
-
-static void render(OpenGLAssetManager                  &am,
-                   std::shared_ptr<CameraComponent>    &camera,
-                   const ComponentList<SpriteRenderer> &components)
-{
-    glm::mat4 projectionMatrix = camera->getProjectionMatrix();
-    glm::mat4 viewMatrix       = camera->getViewMatrix();
-
-    for (auto &sprite : components)
-    {
-        // if &'ed masks does not match renderComponents' mask, skip
-        if (sprite->m_renderMask.none()
-            || (sprite->m_renderMask & camera->getRenderMask()) != sprite->m_renderMask)
-            continue;
-
-        OpenGLMesh     &mesh     = am.getMesh(sprite->getMeshID());
-        OpenGLTexture  &texture  = am.getTexture(sprite->getTextureID());
-        OpenGLPipeline &pipeline = am.getPipeline(sprite->getPipelineID());
-
-        glm::mat4 modelMatrix = sprite->getModelMatrix();
-        glm::mat4 mvp         = projectionMatrix * viewMatrix * modelMatrix;
-
-        glm::vec4 tile(0.0f, 0.0f, 0.2f, 0.5f);
-
-        OpenGLPipeline::RenderInfo renderInfo;
-        renderInfo.textures = {texture.getTextureID()};
-        renderInfo.buffers  = {
-            {GL_ARRAY_BUFFER,         mesh.getVertexBufferID()},
-            {GL_ELEMENT_ARRAY_BUFFER, mesh.getIndiceBufferID()}
-        };
-        renderInfo.uniforms = {
-            {"u_mvp",  {GL_FLOAT_MAT4, sizeof(mvp), GL_FALSE, static_cast<void *>(&mvp[0][0])}},
-            {"u_tile", {GL_FLOAT_VEC4, sizeof(tile), GL_FALSE, static_cast<void *>(&tile)}    }
-        };
-        renderInfo.drawInfo = {.instanced      = false,
-                               .drawMode       = GL_TRIANGLES,
-                               .indiceCount    = static_cast<GLsizei>(mesh.getIndiceCount()),
-                               .indiceType     = GL_UNSIGNED_INT,
-                               .indiceLocation = static_cast<void *>(0)};
-
-        pipeline.render(renderInfo);
-    }
+void OpenGLRenderer::render()
+{
+    L_TAG("OpenGLRenderer::render");
+    Internal &internal = *m_internal;
+
+    time_us start = Time::getTime<time_us>();
+    internal.m_packets[internal.m_submitted % 2].extract(internal.m_submitted);
+    m_timings.extractMs = elapsedMs(start);
 }
 
-static void render(OpenGLAssetManager                &am,
-                   std::shared_ptr<CameraComponent>  &camera,
-                   const ComponentList<MeshRenderer> &components)
+void OpenGLRenderer::renderEnd()
 {
-    glm::mat4 projectionMatrix = camera->getProjectionMatrix();
-    glm::mat4 viewMatrix       = camera->getViewMatrix();
-
-    for (auto &meshR : components)
+    Internal &internal = *m_internal;
+    if (!internal.m_threaded)
     {
-        // if &'ed masks does not match renderComponents' mask, skip
-        if (meshR->m_renderMask.none()
-            || (meshR->m_renderMask & camera->getRenderMask()) != meshR->m_renderMask)
-            continue;
+        const FramePacket &packet = internal.m_packets[internal.m_submitted % 2];
+        internal.m_checksum       = 0;
+        internal.m_device->renderFrame(packet, m_stats, m_timings, internal.m_capture ? &internal.m_checksum : nullptr);
+        framePresentation().submitted();
+        framePresentation().presented(Time::getTime<time_us>());
+        if (internal.m_capture) internal.m_checksums.emplace_back(packet.frame, internal.m_checksum);
+        internal.m_submitted++;
+        internal.m_completed++;
+        return;
+    }
 
-        OpenGLMesh     &mesh     = am.getMesh(meshR->getMeshID());
-        OpenGLTexture  &texture  = am.getTexture(meshR->getTextureID());
-        OpenGLPipeline &pipeline = am.getPipeline(meshR->getPipelineID());
+    {
+        std::lock_guard<std::mutex> lock(internal.m_mutex);
+        internal.m_submitted++;
+    }
+    framePresentation().submitted();
+    internal.m_cv.notify_all();
+}
 
-        glm::mat4 modelMatrix = meshR->getModelMatrix();
-        glm::mat4 mvp         = projectionMatrix * viewMatrix * modelMatrix;
+AssetManager &OpenGLRenderer::getAssetManager() { return m_internal->m_device->m_assetManager; }
 
-        pipeline.render(mesh, texture, mvp);
+void OpenGLRenderer::setFramesInFlight(std::size_t frames)
+{
+    Internal &internal = *m_internal;
+    {
+        std::lock_guard<std::mutex> lock(internal.m_mutex);
+        internal.m_framesInFlight = std::min<std::size_t>(std::max<std::size_t>(frames, 1), 2);
+        m_timings.framesInFlight  = internal.m_framesInFlight;
     }
+    internal.m_cv.notify_all();
 }
 
-void OpenGLRenderer::render()
+void OpenGLRenderer::setFrameCapture(bool enabled)
 {
-    L_TAG("OpenGLRenderer::render");
+    std::lock_guard<std::mutex> lock(m_internal->m_mutex);
+    m_internal->m_capture = enabled;
+}
 
-    /** @todo: this needs reworking, better rendering management for other types */
-    ComponentManager   &componentManager = ComponentManager::getInstance();
-    OpenGLAssetManager &am = dynamic_cast<OpenGLAssetManager &>(this->getAssetManager());
+std::uint64_t OpenGLRenderer::frameChecksum() const { return m_internal->m_checksum; }
 
-    /** @todo: fix depth rendering for multiple cameras */
-    for (auto camera : componentManager.getComponents<CameraComponent>())
-    {
-        ::render(am, camera, componentManager.getComponents<SpriteRenderer>());
-        ::render(am, camera, componentManager.getComponents<MeshRenderer>());
-    }
+std::vector<std::pair<std::uint64_t, std::uint64_t>> OpenGLRenderer::takeFrameChecksums()
+{
+    std::lock_guard<std::mutex> lock(m_internal->m_mutex);
+    return std::exchange(m_internal->m_checksums, {});
 }
 
-void OpenGLRenderer::renderEnd() { SDL_GL_SwapWindow(m_internal->m_window); }
+void OpenGLRenderer::finish()
+{
+    Internal &internal = *m_internal;
+    if (!internal.m_threaded) return;
+
+    std::unique_lock<std::mutex> lock(internal.m_mutex);
+    internal.m_cv.wait(lock, [&internal]() { return internal.m_stop || internal.m_completed == internal.m_submitted; });
+    internal.rethrow();
+}
 
-AssetManager   &OpenGLRenderer::getAssetManager() { return m_internal->m_assetManager; }
-SDL_WindowFlags OpenGLRenderer::getWindowFlags() { return SDL_WINDOW_OPENGL; }
\ No newline at end of file
+SDL_WindowFlags OpenGLRenderer::getWindowFlags() { return SDL_WINDOW_OPENGL; }
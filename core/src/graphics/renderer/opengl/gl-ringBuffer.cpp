@@ -0,0 +1,160 @@
+#include <core/graphics/renderer/opengl/gl-ringBuffer.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
+
+#include <utils/logging.hpp>
+
+OpenGLRingBuffer::OpenGLRingBuffer(std::size_t frameSize)
+    : m_persistent(GLEW_VERSION_4_4 || (GLEW_ARB_buffer_storage && GLEW_ARB_sync)),
+      m_ring(frameSize, m_persistent ? frameCount : 1)
+{
+    L_TAG("OpenGLRingBuffer::OpenGLRingBuffer");
+
+    create();
+    L_DEBUG("Ring buffer {}: {} bytes per frame, {}",
+            m_buffer,
+            m_ring.frameSize(),
+            m_persistent ? "persistent mapping" : "orphaning fallback");
+}
+
+OpenGLRingBuffer::~OpenGLRingBuffer()
+{
+    for (auto &fence : m_fences)
+        if (fence) glDeleteSync(fence);
+    retire();
+    OpenGLStateCache &state = OpenGLStateCache::current();
+    for (auto &retired : m_retired)
+    {
+        state.bindBuffer(GL_ARRAY_BUFFER, retired.first);
+        if (retired.second) glUnmapBuffer(GL_ARRAY_BUFFER);
+        state.deleteBuffer(retired.first);
+    }
+}
+
+void OpenGLRingBuffer::create()
+{
+    L_TAG("OpenGLRingBuffer::create");
+
+    glGenBuffers(1, &m_buffer);
+    OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    if (m_persistent)
+    {
+        const GLsizeiptr total = static_cast<GLsizeiptr>(m_ring.bufferSize());
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, total, nullptr, flags);
+        m_mapped = static_cast<char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags));
+        L_ASSERT(m_mapped != nullptr, "Failed to map ring buffer {} ({} bytes)", m_buffer, total);
+
+        /** fences of the previous storage don't guard the new one */
+        for (auto &fence : m_fences)
+        {
+            if (fence) glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    else
+    {
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_ring.frameSize()), nullptr, GL_STREAM_DRAW);
+        m_staging.resize(m_ring.frameSize());
+    }
+}
+
+void OpenGLRingBuffer::retire()
+{
+    /** draws already issued keep using the storage, GL frees it once they complete */
+    if (m_buffer) m_retired.emplace_back(m_buffer, m_mapped != nullptr);
+    m_buffer = 0;
+    m_mapped = nullptr;
+}
+
+void OpenGLRingBuffer::beginFrame()
+{
+    L_TAG("OpenGLRingBuffer::beginFrame");
+
+    const std::size_t region = m_ring.nextRegion();
+    m_flushed                = 0;
+
+    if (!m_persistent)
+    {
+        /** orphan, the driver hands out fresh storage if the old one is in use */
+        OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_ring.frameSize()), nullptr, GL_STREAM_DRAW);
+        return;
+    }
+
+    GLsync &fence = m_fences[region];
+    if (!fence) return;
+
+    GLenum result;
+    while ((result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000)) == GL_TIMEOUT_EXPIRED)
+        ;
+    L_ASSERT(result != GL_WAIT_FAILED, "Ring buffer {}: fence wait failed", m_buffer);
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void OpenGLRingBuffer::endFrame()
+{
+    if (m_persistent) m_fences[m_ring.region()] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    OpenGLStateCache &state = OpenGLStateCache::current();
+    for (auto &retired : m_retired)
+    {
+        state.bindBuffer(GL_ARRAY_BUFFER, retired.first);
+        if (retired.second) glUnmapBuffer(GL_ARRAY_BUFFER);
+        state.deleteBuffer(retired.first);
+    }
+    m_retired.clear();
+}
+
+void OpenGLRingBuffer::reserve(std::size_t bytes)
+{
+    L_TAG("OpenGLRingBuffer::reserve");
+
+    if (m_ring.fits(bytes)) return;
+
+    flush();
+    retire();
+    m_ring.grow(bytes);
+    create();
+    m_flushed = 0;
+    L_DEBUG("Ring buffer grown to {} bytes per frame", m_ring.frameSize());
+}
+
+OpenGLRingBuffer::Allocation OpenGLRingBuffer::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::size_t begin;
+    if (!m_ring.allocate(bytes, alignment, begin)) return Allocation();
+
+    if (m_persistent)
+    {
+        const std::size_t region = m_ring.regionOffset();
+        return Allocation{m_mapped + region + begin, m_buffer, region + begin, bytes};
+    }
+    return Allocation{m_staging.data() + begin, m_buffer, begin, bytes};
+}
+
+void OpenGLRingBuffer::flush()
+{
+    /** coherent mappings are visible to commands issued after the write */
+    if (m_persistent) return;
+
+    const std::size_t head = m_ring.head();
+    if (head <= m_flushed) return;
+
+    OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    static_cast<GLintptr>(m_flushed),
+                    static_cast<GLsizeiptr>(head - m_flushed),
+                    m_staging.data() + m_flushed);
+    m_flushed = head;
+}
+
+std::size_t OpenGLRingBuffer::uniformAlignment()
+{
+    if (!GLEW_VERSION_3_1) return RingAllocator::regionAlignment;
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    return alignment > 0 ? static_cast<std::size_t>(alignment) : RingAllocator::regionAlignment;
+}
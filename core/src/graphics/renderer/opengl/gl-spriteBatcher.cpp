@@ -0,0 +1,187 @@
+#include <core/graphics/renderer/opengl/gl-spriteBatcher.hpp>
+#include <core/graphics/renderer/opengl/gl-assetManager.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
+
+#include <utils/logging.hpp>
+
+#include <algorithm>
+
+/** Initial capacity, the indice buffer grows to the largest batch seen */
+static constexpr std::size_t initialQuadCapacity = 1024;
+
+static constexpr OpenGLPipeline::UniformHandle u_mvp = OpenGLPipeline::uniformHandle("u_mvp");
+
+static_assert(sizeof(core::ui::TextBatch::Vertex) == sizeof(OpenGLSpriteBatcher::Vertex)
+                  && offsetof(core::ui::TextBatch::Vertex, uv) == offsetof(OpenGLSpriteBatcher::Vertex, uv)
+                  && offsetof(core::ui::TextBatch::Vertex, color) == offsetof(OpenGLSpriteBatcher::Vertex, color),
+              "Text is drawn with the sprite vertex layout");
+
+OpenGLSpriteBatcher::OpenGLSpriteBatcher()
+{
+    L_TAG("OpenGLSpriteBatcher::OpenGLSpriteBatcher");
+
+    glGenBuffers(1, &m_indiceBuffer);
+    reserveIndices(initialQuadCapacity);
+    L_TRACE("Sprite batcher created with indice buffer {}", m_indiceBuffer);
+}
+
+OpenGLSpriteBatcher::~OpenGLSpriteBatcher()
+{
+    OpenGLStateCache::current().deleteBuffer(m_indiceBuffer);
+    for (auto &text : m_textBuffers)
+        if (text.buffer) OpenGLStateCache::current().deleteBuffer(text.buffer);
+}
+
+void OpenGLSpriteBatcher::reserveIndices(std::size_t quadCount)
+{
+    L_TAG("OpenGLSpriteBatcher::reserveIndices");
+    if (quadCount <= m_quadCapacity) return;
+
+    std::size_t capacity = std::max(quadCount, m_quadCapacity * 2);
+
+    /** indices never change, the quad pattern is written once per growth */
+    std::vector<std::uint32_t> indices(capacity * 6);
+    for (std::uint32_t q = 0; q < capacity; q++)
+    {
+        const std::uint32_t v = q * 4;
+        std::uint32_t      *i = &indices[q * 6];
+        i[0] = v + 0, i[1] = v + 1, i[2] = v + 2;
+        i[3] = v + 2, i[4] = v + 3, i[5] = v + 0;
+    }
+    OpenGLStateCache::current().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indiceBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint32_t), indices.data(), GL_STATIC_DRAW);
+
+    m_quadCapacity = capacity;
+    L_DEBUG("Sprite batch capacity: {} sprites", m_quadCapacity);
+}
+
+void OpenGLSpriteBatcher::submit(std::uint8_t     layer,
+                                 AssetID          pipeline,
+                                 AssetID          texture,
+                                 const glm::mat4 &model,
+                                 const glm::vec4 &uvRect,
+                                 const glm::vec4 &color)
+{
+    m_batch.submit(layer, pipeline, texture, model, uvRect, color);
+}
+
+void OpenGLSpriteBatcher::flush(OpenGLAssetManager &am,
+                                OpenGLRingBuffer   &stream,
+                                const glm::mat4    &viewProjection,
+                                RendererStats      &stats)
+{
+    L_TAG("OpenGLSpriteBatcher::flush");
+    if (m_batch.empty()) return;
+
+    const std::size_t spriteCount = m_batch.size();
+    m_batch.sort();
+
+    /** vertices are written straight into this frame's region of the ring buffer */
+    const std::size_t bytes = spriteCount * 4 * sizeof(Vertex);
+    reserveIndices(spriteCount);
+    stream.reserve(bytes);
+    OpenGLRingBuffer::Allocation range = stream.allocate(bytes);
+    L_ASSERT(range, "Ring buffer has no room for {} sprites", spriteCount);
+
+    Vertex *vertices = static_cast<Vertex *>(range.data);
+    for (std::size_t i = 0; i < spriteCount; i++)
+    {
+        const SpriteBatch::Sprite &s = m_batch.sorted(i);
+        Vertex                    *v = &vertices[i * 4];
+        v[0]            = {s.origin, {s.uvRect.x, s.uvRect.y}, s.color};
+        v[1]            = {s.origin + s.axisX, {s.uvRect.z, s.uvRect.y}, s.color};
+        v[2]            = {s.origin + s.axisX + s.axisY, {s.uvRect.z, s.uvRect.w}, s.color};
+        v[3]            = {s.origin + s.axisY, {s.uvRect.x, s.uvRect.w}, s.color};
+    }
+
+    stream.flush();
+    stats.streamedBytes += bytes;
+
+    glm::mat4                  mvp = viewProjection;
+    OpenGLPipeline::RenderInfo renderInfo;
+    renderInfo.buffers = {
+        {GL_ARRAY_BUFFER,         range.buffer  },
+        {GL_ELEMENT_ARRAY_BUFFER, m_indiceBuffer}
+    };
+    renderInfo.uniforms = {
+        {u_mvp, GL_FLOAT_MAT4, sizeof(mvp), GL_FALSE, static_cast<void *>(&mvp[0][0])}
+    };
+    renderInfo.attributes = {
+        {0, 3, GL_FLOAT,         GL_FALSE, sizeof(Vertex), range.offset + offsetof(Vertex, position)},
+        {2, 2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), range.offset + offsetof(Vertex, uv)      },
+        {6, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Vertex), range.offset + offsetof(Vertex, color)   }
+    };
+
+    for (const SpriteBatch::Run &run : m_batch.runs())
+    {
+        renderInfo.textures = {am.getTexture(run.texture).getTextureID()};
+        renderInfo.drawInfo = {.instanced      = false,
+                               .drawMode       = GL_TRIANGLES,
+                               .indiceCount    = static_cast<GLsizei>(run.count * 6),
+                               .indiceType     = GL_UNSIGNED_INT,
+                               .indiceLocation = reinterpret_cast<void *>(run.begin * 6 * sizeof(std::uint32_t))};
+        am.getPipeline(run.pipeline).render(renderInfo);
+
+        stats.drawCalls++;
+        stats.spriteBatches++;
+    }
+    stats.spriteCount += spriteCount;
+    m_batch.clear();
+}
+
+void OpenGLSpriteBatcher::drawText(OpenGLAssetManager              &am,
+                                   std::size_t                      slot,
+                                   AssetID                          pipeline,
+                                   const core::ui::TextBatch::Mesh &mesh,
+                                   const glm::mat4                 &viewProjection,
+                                   RendererStats                   &stats)
+{
+    L_TAG("OpenGLSpriteBatcher::drawText");
+    const std::size_t quadCount = mesh.quads();
+    if (quadCount == 0) return;
+
+    if (slot >= m_textBuffers.size()) m_textBuffers.resize(slot + 1);
+    TextBuffer &text = m_textBuffers[slot];
+
+    /** static text keeps its vertices on the GPU, only rebuilt meshes are uploaded */
+    if (text.version != mesh.version)
+    {
+        const std::size_t bytes = mesh.vertices.size() * sizeof(Vertex);
+        if (!text.buffer) glGenBuffers(1, &text.buffer);
+        OpenGLStateCache::current().bindBuffer(GL_ARRAY_BUFFER, text.buffer);
+        glBufferData(GL_ARRAY_BUFFER, bytes, mesh.vertices.data(), GL_STATIC_DRAW);
+        text.version = mesh.version;
+        stats.streamedBytes += bytes;
+        L_TRACE("Uploaded {} glyphs to text buffer {}", quadCount, text.buffer);
+    }
+    reserveIndices(quadCount);
+
+    glm::mat4                  mvp = viewProjection;
+    OpenGLPipeline::RenderInfo renderInfo;
+    renderInfo.buffers = {
+        {GL_ARRAY_BUFFER,         text.buffer   },
+        {GL_ELEMENT_ARRAY_BUFFER, m_indiceBuffer}
+    };
+    renderInfo.uniforms = {
+        {u_mvp, GL_FLOAT_MAT4, sizeof(mvp), GL_FALSE, static_cast<void *>(&mvp[0][0])}
+    };
+    renderInfo.attributes = {
+        {0, 3, GL_FLOAT,         GL_FALSE, sizeof(Vertex), offsetof(Vertex, position)},
+        {2, 2, GL_FLOAT,         GL_FALSE, sizeof(Vertex), offsetof(Vertex, uv)      },
+        {6, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(Vertex), offsetof(Vertex, color)   }
+    };
+
+    const OpenGLPipeline &textPipeline = am.getPipeline(pipeline);
+    for (const core::ui::TextBatch::Run &run : mesh.runs)
+    {
+        renderInfo.textures = {am.getTexture(run.texture).getTextureID()};
+        renderInfo.drawInfo = {.instanced      = false,
+                               .drawMode       = GL_TRIANGLES,
+                               .indiceCount    = static_cast<GLsizei>(run.count * 6),
+                               .indiceType     = GL_UNSIGNED_INT,
+                               .indiceLocation = reinterpret_cast<void *>(run.first * 6 * sizeof(std::uint32_t))};
+        textPipeline.render(renderInfo);
+        stats.drawCalls++;
+    }
+    stats.textQuads += quadCount;
+}
@@ -0,0 +1,192 @@
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
+
+#include <utils/logging.hpp>
+
+static OpenGLStateCache *s_current = nullptr;
+
+static int capabilityIndex(GLenum capability)
+{
+    switch (capability)
+    {
+    case GL_BLEND: return 0;
+    case GL_DEPTH_TEST: return 1;
+    case GL_CULL_FACE: return 2;
+    default: return -1;
+    }
+}
+
+static int bufferIndex(GLenum target)
+{
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER: return 0;
+    case GL_ELEMENT_ARRAY_BUFFER: return 1;
+    case GL_UNIFORM_BUFFER: return 2;
+    case GL_PIXEL_UNPACK_BUFFER: return 3;
+    default: return -1;
+    }
+}
+
+OpenGLStateCache::OpenGLStateCache()
+{
+    L_TAG("OpenGLStateCache::OpenGLStateCache");
+    L_ASSERT(s_current == nullptr, "Only one OpenGLStateCache may exist");
+    invalidate();
+    s_current = this;
+}
+
+OpenGLStateCache::~OpenGLStateCache()
+{
+    if (s_current == this) s_current = nullptr;
+}
+
+OpenGLStateCache &OpenGLStateCache::current()
+{
+    L_TAG("OpenGLStateCache::current");
+    L_ASSERT(s_current != nullptr, "No OpenGLStateCache, the renderer must be created first");
+    return *s_current;
+}
+
+void OpenGLStateCache::invalidate()
+{
+    m_program       = unknown;
+    m_vertexArray   = unknown;
+    m_activeTexture = unknown;
+    m_blendSrc      = unknown;
+    m_blendDst      = unknown;
+    m_depthFunc     = unknown;
+    m_depthMask     = unknown;
+    m_polygonMode   = unknown;
+    m_buffers.fill(unknown);
+    m_textures.fill(unknown);
+    m_capabilities.fill(-1);
+}
+
+bool OpenGLStateCache::update(GLuint &cached, GLuint value)
+{
+    if (cached == value)
+    {
+        m_counters.skipped++;
+        return false;
+    }
+    cached = value;
+    m_counters.issued++;
+    return true;
+}
+
+void OpenGLStateCache::useProgram(GLuint program)
+{
+    if (update(m_program, program)) glUseProgram(program);
+}
+
+void OpenGLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    int index = bufferIndex(target);
+    if (index < 0)
+    {
+        m_counters.issued++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (update(m_buffers[index], buffer)) glBindBuffer(target, buffer);
+}
+
+void OpenGLStateCache::bindVertexArray(GLuint vertexArray)
+{
+    if (!update(m_vertexArray, vertexArray)) return;
+    glBindVertexArray(vertexArray);
+    /** the element buffer binding belongs to the vertex array */
+    m_buffers[ElementArrayBuffer] = unknown;
+}
+
+void OpenGLStateCache::activeTexture(GLuint unit)
+{
+    if (update(m_activeTexture, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void OpenGLStateCache::bindTexture(GLenum target, GLuint texture)
+{
+    if (target != GL_TEXTURE_2D || m_activeTexture >= textureUnits)
+    {
+        m_counters.issued++;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (update(m_textures[m_activeTexture], texture)) glBindTexture(target, texture);
+}
+
+void OpenGLStateCache::setEnabled(GLenum capability, bool enabled)
+{
+    int index = capabilityIndex(capability);
+    if (index >= 0 && m_capabilities[index] == static_cast<std::int8_t>(enabled))
+    {
+        m_counters.skipped++;
+        return;
+    }
+    if (index >= 0) m_capabilities[index] = static_cast<std::int8_t>(enabled);
+
+    m_counters.issued++;
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void OpenGLStateCache::blendFunc(GLenum src, GLenum dst)
+{
+    if (m_blendSrc == src && m_blendDst == dst)
+    {
+        m_counters.skipped++;
+        return;
+    }
+    m_blendSrc = src;
+    m_blendDst = dst;
+    m_counters.issued++;
+    glBlendFunc(src, dst);
+}
+
+void OpenGLStateCache::depthFunc(GLenum func)
+{
+    if (update(m_depthFunc, func)) glDepthFunc(func);
+}
+
+void OpenGLStateCache::depthMask(GLboolean mask)
+{
+    if (update(m_depthMask, mask)) glDepthMask(mask);
+}
+
+void OpenGLStateCache::polygonMode(GLenum mode)
+{
+    if (update(m_polygonMode, mode)) glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+/** deleting a bound object resets the binding to 0 */
+void OpenGLStateCache::deleteBuffer(GLuint buffer)
+{
+    for (auto &bound : m_buffers)
+        if (bound == buffer) bound = 0;
+    glDeleteBuffers(1, &buffer);
+}
+
+void OpenGLStateCache::deleteVertexArray(GLuint vertexArray)
+{
+    if (m_vertexArray == vertexArray)
+    {
+        m_vertexArray                 = 0;
+        m_buffers[ElementArrayBuffer] = unknown;
+    }
+    glDeleteVertexArrays(1, &vertexArray);
+}
+
+void OpenGLStateCache::deleteTexture(GLuint texture)
+{
+    for (auto &bound : m_textures)
+        if (bound == texture) bound = 0;
+    glDeleteTextures(1, &texture);
+}
+
+void OpenGLStateCache::deleteProgram(GLuint program)
+{
+    /** a bound program stays in use until another one is bound */
+    glDeleteProgram(program);
+}
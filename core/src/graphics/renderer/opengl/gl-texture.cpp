@@ -1,71 +1,43 @@
 #include <core/graphics/renderer/opengl/gl-texture.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
 
 #include <assets/texture_p.hpp>
 #include <utils/logging.hpp>
 
 #include "SDL2/SDL_opengl.h"
 
+#include <cstring>
 #include <vector>
 
-/**
- * @brief Flips the surface vertically. Needed for OpenGL use
- * 
- * @param surface surface to flip
- */
-static void flipv_surface(SDL_Surface *surface) noexcept {
-    L_TAG("createTexture");
-
-    // Lock surface if needed
-    if (SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
-
-    char *pixels = reinterpret_cast<char*>(surface->pixels);
-    int pitch = surface->pitch; // row size
-    int rows = surface->h;
-    char *rowBuffer = new char[pitch]; // row buffer
-
-    /** basically each loop we swap the equivalent row from top and bottom
-     *  first row becomes the last row, ... till we reach the middle
-     * 
-     */
-    for(int i = 0; i < rows / 2; i++){
-        char *r1 = pixels + (i * pitch); // top row
-        char *r2 = pixels + ((rows - i - 1) * pitch); // bottom row
-
-        memcpy(rowBuffer, r1, pitch);
-        memcpy(r1, r2, pitch);
-        memcpy(r2, rowBuffer, pitch);
-    }
-
-    // Unlock surface if needed
-    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+static void uploadTexture(GLuint textureId, const core::assets::Texture &texture)
+{
+    std::vector<char> pixels(texture.width() * texture.height() * 4);
+    OpenGLTexture::copyRows(texture, pixels.data());
+    OpenGLTexture::upload(textureId, texture.width(), texture.height(), pixels.data());
 }
 
 static GLuint createTexture(const core::assets::Texture &texture)
 {
     L_TAG("createTexture");
 
-    GLuint       textureId;
-    SDL_Surface *surface = texture.getInternal().m_surface;
+    GLuint textureId;
+    glGenTextures(1, &textureId);
+    uploadTexture(textureId, texture);
+
+    L_DEBUG("GLTexture loaded to {}", textureId);
+
+    return textureId;
+}
 
-    // Flip the texture first before loading
-    flipv_surface(surface);
+static GLuint createTexture(const core::assets::BakedTexture &texture)
+{
+    L_TAG("createTexture");
 
+    GLuint textureId;
     glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D,
-                 0,
-                 GL_RGBA,
-                 static_cast<GLsizei>(surface->w),
-                 static_cast<GLsizei>(surface->h),
-                 0,
-                 GL_RGBA,
-                 GL_UNSIGNED_BYTE,
-                 surface->pixels);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    OpenGLTexture::upload(textureId, texture, texture.payload());
 
-    L_DEBUG("GLTexture loaded to {}", textureId);
+    L_DEBUG("GLTexture loaded to {} ({} levels)", textureId, texture.levels());
 
     return textureId;
 }
@@ -73,8 +45,15 @@ static GLuint createTexture(const core::assets::Texture &texture)
 struct OpenGLTexture::Internal
 {
     const GLuint textureID;
+    std::size_t  height; /** rows are flipped on upload, regions need the image height */
+
+    Internal(const core::assets::Texture &texture) : textureID(createTexture(texture)), height(texture.height())
+    {
+        L_TAG("OpenGLTexture::Internal");
+        L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
+    }
 
-    Internal(const core::assets::Texture &texture) : textureID(createTexture(texture))
+    Internal(const core::assets::BakedTexture &texture) : textureID(createTexture(texture)), height(texture.height())
     {
         L_TAG("OpenGLTexture::Internal");
         L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
@@ -88,10 +67,102 @@ struct OpenGLTexture::Internal
 };
 
 OpenGLTexture::OpenGLTexture(const core::assets::Texture &texture) : m_internal(std::make_unique<Internal>(texture)) {}
+OpenGLTexture::OpenGLTexture(const core::assets::BakedTexture &texture)
+    : m_internal(std::make_unique<Internal>(texture))
+{
+}
 
 OpenGLTexture::OpenGLTexture()                             = default;
 OpenGLTexture::OpenGLTexture(OpenGLTexture &&o)            = default;
 OpenGLTexture &OpenGLTexture::operator=(OpenGLTexture &&o) = default;
 OpenGLTexture::~OpenGLTexture()                            = default;
 
-GLuint OpenGLTexture::getTextureID() const { return m_internal->textureID; }
\ No newline at end of file
+void OpenGLTexture::update(const core::assets::Texture &texture)
+{
+    uploadTexture(m_internal->textureID, texture);
+    m_internal->height = texture.height();
+}
+
+void OpenGLTexture::update(const core::assets::Texture &region, std::size_t x, std::size_t y)
+{
+    L_TAG("OpenGLTexture::update");
+    if (y + region.height() > m_internal->height)
+        L_THROW_RUNTIME("Region rows {}..{} outside of the texture ({} rows)", y, y + region.height(), m_internal->height);
+
+    std::vector<char> pixels(region.width() * region.height() * 4);
+    copyRows(region, pixels.data());
+    upload(m_internal->textureID, x, m_internal->height - y - region.height(), region.width(), region.height(), pixels.data());
+}
+
+GLuint OpenGLTexture::getTextureID() const { return m_internal->textureID; }
+
+void OpenGLTexture::copyRows(const core::assets::Texture &texture, void *target)
+{
+    /** surfaces of textures are never RLE encoded, no locking needed */
+    const SDL_Surface *surface = texture.getInternal().m_surface;
+    const std::size_t  row     = static_cast<std::size_t>(surface->w) * 4;
+    const char        *pixels  = static_cast<const char *>(surface->pixels);
+    char              *out     = static_cast<char *>(target);
+
+    for (int y = surface->h - 1; y >= 0; y--, out += row)
+        std::memcpy(out, pixels + static_cast<std::size_t>(y) * surface->pitch, row);
+}
+
+void OpenGLTexture::upload(GLuint texture, std::size_t width, std::size_t height, const void *pixels)
+{
+    OpenGLStateCache::current().bindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000); /** the default, a baked upload may have lowered it */
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_RGBA,
+                 static_cast<GLsizei>(width),
+                 static_cast<GLsizei>(height),
+                 0,
+                 GL_RGBA,
+                 GL_UNSIGNED_BYTE,
+                 pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+void OpenGLTexture::upload(GLuint      texture,
+                           std::size_t x,
+                           std::size_t y,
+                           std::size_t width,
+                           std::size_t height,
+                           const void *pixels)
+{
+    OpenGLStateCache::current().bindTexture(GL_TEXTURE_2D, texture);
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    0,
+                    static_cast<GLint>(x),
+                    static_cast<GLint>(y),
+                    static_cast<GLsizei>(width),
+                    static_cast<GLsizei>(height),
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+void OpenGLTexture::upload(GLuint texture, const core::assets::BakedTexture &baked, const char *payload)
+{
+    OpenGLStateCache::current().bindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(baked.levels() - 1));
+    for (std::size_t i = 0; i < baked.levels(); i++)
+    {
+        const core::assets::BakedTexture::Level &level = baked.level(i);
+        glTexImage2D(GL_TEXTURE_2D,
+                     static_cast<GLint>(i),
+                     GL_RGBA,
+                     static_cast<GLsizei>(level.width),
+                     static_cast<GLsizei>(level.height),
+                     0,
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     payload + level.offset);
+    }
+}
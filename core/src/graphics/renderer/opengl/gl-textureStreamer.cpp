@@ -0,0 +1,179 @@
+#include <core/graphics/renderer/opengl/gl-textureStreamer.hpp>
+#include <core/graphics/renderer/opengl/gl-texture.hpp>
+#include <core/graphics/renderer/opengl/gl-stateCache.hpp>
+#include <core/graphics/renderer.hpp>
+#include <core/utils/jobs.hpp>
+#include <core/utils/profiler.hpp>
+
+#include <utils/logging.hpp>
+
+#include <chrono>
+#include <cstring>
+
+template <typename T>
+static bool isReady(const std::future<T> &future)
+{
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+OpenGLTextureStreamer::OpenGLTextureStreamer(std::size_t budget)
+    : m_budget(budget),
+      m_pixelBuffers(GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object)
+{
+    L_TAG("OpenGLTextureStreamer::OpenGLTextureStreamer");
+    L_DEBUG("Texture streaming: {} bytes per frame, pixel buffers: {}", m_budget, m_pixelBuffers);
+}
+
+OpenGLTextureStreamer::~OpenGLTextureStreamer()
+{
+    for (Load &load : m_loads)
+        release(load);
+}
+
+void OpenGLTextureStreamer::request(GLuint texture, const AssetName &name)
+{
+    L_TAG("OpenGLTextureStreamer::request");
+
+    Load &load   = m_loads.emplace_back();
+    load.texture = texture;
+    load.name    = name;
+    load.decoded = core::utils::JobPool::getInstance().submit([name]() { return core::assets::BakedTexture::load(name); });
+    L_TRACE("Streaming {} into texture {}", name, texture);
+}
+
+void OpenGLTextureStreamer::cancel(GLuint texture)
+{
+    for (auto it = m_loads.begin(); it != m_loads.end();)
+    {
+        if (it->texture != texture)
+        {
+            ++it;
+            continue;
+        }
+        release(*it);
+        it = m_loads.erase(it);
+    }
+}
+
+void OpenGLTextureStreamer::update(RendererStats &stats)
+{
+    L_TAG("OpenGLTextureStreamer::update");
+    if (m_loads.empty()) return;
+    PROFILER_BLOCK("OpenGLTextureStreamer::update");
+
+    std::size_t uploaded = 0;
+    bool        spent    = false; /** keeps later loads from overtaking one that didn't fit */
+    for (auto it = m_loads.begin(); it != m_loads.end();)
+    {
+        Load &load = *it;
+        if (load.state == Load::State::Decoding && isReady(load.decoded))
+        {
+            try
+            {
+                load.image = load.decoded.get();
+            }
+            catch (const std::exception &e)
+            {
+                L_WARN("Could not stream texture {}: {}", load.name, e.what());
+                it = m_loads.erase(it);
+                continue;
+            }
+            map(load);
+        }
+        if (load.state == Load::State::Copying && isReady(load.copied))
+        {
+            load.copied.get();
+            load.state = Load::State::Ready;
+        }
+        if (load.state != Load::State::Ready)
+        {
+            ++it;
+            continue;
+        }
+
+        std::size_t bytes = load.image.payloadSize();
+        if (spent || (uploaded > 0 && uploaded + bytes > m_budget))
+        {
+            spent = true;
+            ++it;
+            continue;
+        }
+
+        upload(load);
+        uploaded += bytes;
+        stats.texturesStreamed++;
+        stats.textureBytes += bytes;
+        it = m_loads.erase(it);
+    }
+}
+
+void OpenGLTextureStreamer::map(Load &load)
+{
+    OpenGLStateCache &state = OpenGLStateCache::current();
+    std::size_t       bytes = load.image.payloadSize();
+
+    void *target = nullptr;
+    if (m_pixelBuffers)
+    {
+        glGenBuffers(1, &load.buffer);
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, load.buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+        target = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!target)
+        {
+            state.deleteBuffer(load.buffer);
+            load.buffer = 0;
+        }
+    }
+    if (!target)
+    {
+        load.state = Load::State::Ready;
+        return;
+    }
+
+    /** the mapping stays valid off the GL thread until it is unmapped in upload */
+    const char *payload = load.image.payload();
+    load.copied = core::utils::JobPool::getInstance().submit([payload, target, bytes]() {
+        std::memcpy(target, payload, bytes);
+    });
+    load.state = Load::State::Copying;
+}
+
+void OpenGLTextureStreamer::upload(Load &load)
+{
+    L_TAG("OpenGLTextureStreamer::upload");
+    OpenGLStateCache &state = OpenGLStateCache::current();
+
+    if (load.buffer == 0)
+    {
+        OpenGLTexture::upload(load.texture, load.image, load.image.payload());
+    }
+    else
+    {
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, load.buffer);
+        /** the store is lost if the driver dropped it while mapped, keep the placeholder */
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+            OpenGLTexture::upload(load.texture, load.image, nullptr);
+        else
+            L_WARN("Pixel buffer of texture {} was lost", load.name);
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        state.deleteBuffer(load.buffer);
+        load.buffer = 0;
+    }
+
+    L_DEBUG("Texture {} streamed into {} ({}x{})", load.name, load.texture, load.image.width(), load.image.height());
+}
+
+void OpenGLTextureStreamer::release(Load &load)
+{
+    if (load.copied.valid()) load.copied.wait();
+    if (load.buffer == 0) return;
+
+    OpenGLStateCache &state = OpenGLStateCache::current();
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, load.buffer);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    state.deleteBuffer(load.buffer);
+    load.buffer = 0;
+}
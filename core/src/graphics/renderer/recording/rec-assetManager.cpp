@@ -0,0 +1,121 @@
+#include <core/graphics/renderer/recording/rec-assetManager.hpp>
+
+#include <utils/logging.hpp>
+
+/** bounds of a unit cube centered on the origin */
+static MeshBounds unitBounds()
+{
+    MeshBounds bounds;
+    bounds.min    = glm::vec3(-0.5f);
+    bounds.max    = glm::vec3(0.5f);
+    bounds.center = glm::vec3(0.0f);
+    bounds.radius = glm::length(bounds.max);
+    return bounds;
+}
+
+RecordingAssetManager::RecordingAssetManager()  = default;
+RecordingAssetManager::~RecordingAssetManager() = default;
+
+AssetID RecordingAssetManager::find(const Registry &registry, const std::string &name)
+{
+    auto it = registry.ids.find(name);
+    return it != registry.ids.end() ? it->second : -1;
+}
+
+AssetID RecordingAssetManager::add(Registry &registry, const std::string &name)
+{
+    AssetID id = find(registry, name);
+    if (id >= 0) return id;
+
+    id = static_cast<AssetID>(registry.names.size());
+    registry.names.push_back(name);
+    registry.ids.emplace(name, id);
+    return id;
+}
+
+RecordingAssetManager::Registry &RecordingAssetManager::registry(const AssetType &type)
+{
+    L_TAG("RecordingAssetManager::registry");
+    switch (type)
+    {
+    case AssetType::Mesh: return m_meshes;
+    case AssetType::Texture: return m_textures;
+    case AssetType::Pipeline: return m_pipelines;
+    default: L_THROW_RUNTIME("Unsupported asset type: {}", static_cast<int>(type));
+    }
+}
+
+AssetID RecordingAssetManager::loadAsset(const AssetType &type, const AssetName &name)
+{
+    if (type == AssetType::Mesh && find(m_meshes, name) < 0) return addMesh(name, unitBounds());
+    if (type == AssetType::Pipeline) return addPipeline(name);
+    return add(registry(type), name);
+}
+
+AssetID RecordingAssetManager::loadMesh(const core::assets::Mesh &mesh) { return addMesh(mesh.name(), mesh.getBounds()); }
+
+AssetID RecordingAssetManager::loadTexture(const core::assets::Texture &texture) { return add(m_textures, texture.name()); }
+
+AssetID RecordingAssetManager::loadPipeline(const core::assets::Shader &shader) { return addPipeline(shader.name()); }
+
+void RecordingAssetManager::updateTexture(AssetID id, const core::assets::Texture &texture)
+{
+    L_TAG("RecordingAssetManager::updateTexture");
+    if (id < 0 || static_cast<std::size_t>(id) >= m_textures.names.size())
+        L_THROW_RUNTIME("Cache empty for AssetID: {}", id);
+    m_textureBytes += texture.width() * texture.height() * 4;
+}
+
+void RecordingAssetManager::updateTextureRegion(AssetID id, const core::assets::Texture &region, std::size_t, std::size_t)
+{
+    L_TAG("RecordingAssetManager::updateTextureRegion");
+    if (id < 0 || static_cast<std::size_t>(id) >= m_textures.names.size())
+        L_THROW_RUNTIME("Cache empty for AssetID: {}", id);
+    m_textureBytes += region.width() * region.height() * 4;
+}
+
+const MeshBounds &RecordingAssetManager::getMeshBounds(AssetID id) const
+{
+    L_TAG("RecordingAssetManager::getMeshBounds");
+    if (id < 0 || static_cast<std::size_t>(id) >= m_meshBounds.size())
+        L_THROW_RUNTIME("Cache empty for AssetID: {}", id);
+    return m_meshBounds[id];
+}
+
+AssetID RecordingAssetManager::addMesh(const std::string &name, const MeshBounds &bounds)
+{
+    AssetID id = add(m_meshes, name);
+    if (static_cast<std::size_t>(id) >= m_meshBounds.size()) m_meshBounds.resize(id + 1);
+    m_meshBounds[id] = bounds;
+    return id;
+}
+
+const std::string &RecordingAssetManager::getName(const AssetType &type, AssetID id)
+{
+    return registry(type).names.at(id);
+}
+
+AssetID RecordingAssetManager::addPipeline(const std::string &name)
+{
+    static const std::string suffix = "_instanced";
+
+    AssetID id = add(m_pipelines, name);
+    if (m_instancedPipelines.count(id)) return id;
+
+    /** like the OpenGLAssetManager, the variant is loaded with the pipeline and not while drawing */
+    bool isVariant = name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+    m_instancedPipelines.emplace(id, isVariant ? -1 : add(m_pipelines, name + suffix));
+    return id;
+}
+
+AssetID RecordingAssetManager::getInstancedPipeline(AssetID pipeline) const
+{
+    if (!m_instancing) return -1;
+
+    auto it = m_instancedPipelines.find(pipeline);
+    return it != m_instancedPipelines.end() ? it->second : -1;
+}
+
+std::size_t RecordingAssetManager::count(const AssetType &type) { return registry(type).names.size(); }
+
+void RecordingAssetManager::setInstancing(bool enabled) { m_instancing = enabled; }
@@ -0,0 +1,147 @@
+#include <core/graphics/renderer/recording/rec-commandLog.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+void CommandLog::clear()
+{
+    m_commands.clear();
+    m_counts    = {};
+    m_redundant = 0;
+    invalidate();
+}
+
+void CommandLog::invalidate()
+{
+    m_pipeline = -1;
+    m_texture  = -1;
+    m_mesh     = -1;
+}
+
+void CommandLog::record(Op op, std::int64_t id, std::uint32_t count)
+{
+    m_commands.push_back({op, count, id});
+    m_counts[static_cast<std::size_t>(op)]++;
+}
+
+void CommandLog::bind(Op op, std::int64_t &bound, AssetID id)
+{
+    if (bound == id)
+    {
+        m_redundant++;
+        return;
+    }
+    bound = id;
+    record(op, id);
+}
+
+std::size_t CommandLog::drawCalls() const noexcept
+{
+    return count(Op::Draw) + count(Op::DrawInstanced) + count(Op::DrawSprites) + count(Op::DrawText);
+}
+
+std::size_t CommandLog::binds() const noexcept
+{
+    return count(Op::BindPipeline) + count(Op::BindTexture) + count(Op::BindMesh);
+}
+
+std::string CommandLog::checkBudget(const Budget &budget) const
+{
+    std::string report;
+    auto        check = [&report](const char *name, std::size_t value, std::size_t limit) {
+        if (value > limit) report += fmt::format("{}: {} > {}\n", name, value, limit);
+    };
+    check("draw calls", drawCalls(), budget.drawCalls);
+    check("pipeline binds", count(Op::BindPipeline), budget.pipelineBinds);
+    check("texture binds", count(Op::BindTexture), budget.textureBinds);
+    check("mesh binds", count(Op::BindMesh), budget.meshBinds);
+    check("uniform uploads", count(Op::Uniform), budget.uniforms);
+    return report;
+}
+
+/** Frame numbers differ between any two frames, BeginFrame only has to line up */
+static bool sameCommand(const CommandLog::Command &a, const CommandLog::Command &b)
+{
+    if (a.op == CommandLog::Op::BeginFrame) return a.op == b.op;
+    return a == b;
+}
+
+CommandLog::Diff CommandLog::diff(const CommandLog &a, const CommandLog &b)
+{
+    Diff result;
+    for (std::size_t op = 0; op < opCount; op++)
+        result.countDelta[op] = static_cast<std::ptrdiff_t>(b.m_counts[op]) - static_cast<std::ptrdiff_t>(a.m_counts[op]);
+
+    const std::size_t common = std::min(a.size(), b.size());
+    std::size_t       i      = 0;
+    while (i < common && sameCommand(a[i], b[i]))
+        i++;
+    if (i == common && a.size() == b.size()) return result;
+
+    result.firstMismatch = i;
+    result.report        = fmt::format("logs differ at command {} ({} vs {} commands)\n", i, a.size(), b.size());
+
+    /** a few commands of context around the first mismatch */
+    const std::size_t begin = i > 2 ? i - 2 : 0;
+    for (std::size_t j = begin; j < i + 3 && (j < a.size() || j < b.size()); j++)
+    {
+        result.report += fmt::format("  {}{:>5}: {:<24} | {}\n",
+                                     j == i ? '>' : ' ',
+                                     j,
+                                     j < a.size() ? a.toString(j) : "-",
+                                     j < b.size() ? b.toString(j) : "-");
+    }
+    for (std::size_t op = 0; op < opCount; op++)
+    {
+        if (result.countDelta[op])
+            result.report += fmt::format("  {}: {:+}\n", opName(static_cast<Op>(op)), result.countDelta[op]);
+    }
+    return result;
+}
+
+const char *CommandLog::opName(Op op) noexcept
+{
+    switch (op)
+    {
+    case Op::BeginFrame: return "BeginFrame";
+    case Op::Camera: return "Camera";
+    case Op::BindPipeline: return "BindPipeline";
+    case Op::BindTexture: return "BindTexture";
+    case Op::BindMesh: return "BindMesh";
+    case Op::Uniform: return "Uniform";
+    case Op::Draw: return "Draw";
+    case Op::DrawInstanced: return "DrawInstanced";
+    case Op::DrawSprites: return "DrawSprites";
+    case Op::UploadText: return "UploadText";
+    case Op::DrawText: return "DrawText";
+    case Op::Present: return "Present";
+    default: return "Unknown";
+    }
+}
+
+std::string CommandLog::toString(std::size_t i) const
+{
+    const Command &cmd = m_commands[i];
+    switch (cmd.op)
+    {
+    case Op::Present: return opName(cmd.op);
+    case Op::Uniform: return fmt::format("{} {:016x} {}", opName(cmd.op), static_cast<std::uint64_t>(cmd.id), cmd.count);
+    case Op::DrawInstanced:
+    case Op::DrawSprites:
+    case Op::UploadText:
+    case Op::DrawText: return fmt::format("{} {} x{}", opName(cmd.op), cmd.id, cmd.count);
+    default: return fmt::format("{} {}", opName(cmd.op), cmd.id);
+    }
+}
+
+std::string CommandLog::toString() const
+{
+    std::string out;
+    for (std::size_t i = 0; i < m_commands.size(); i++)
+    {
+        out += toString(i);
+        out += '\n';
+    }
+    return out;
+}
@@ -0,0 +1,184 @@
+#include <core/graphics/renderer/recording/rec-renderer.hpp>
+#include <core/graphics/spriteBatch.hpp>
+#include <core/utils/hash.hpp>
+
+/** uniforms the OpenGL pipelines upload per draw, see default.vert, default_instanced.vert and sprite.vert */
+static constexpr std::int64_t u_mvp = static_cast<std::int64_t>(core::utils::hash_fnv1a("u_mvp"));
+static constexpr std::int64_t u_vp  = static_cast<std::int64_t>(core::utils::hash_fnv1a("u_vp"));
+
+/** Records the render queue, mirrors OpenGLQueueBackend */
+struct RecordingQueueBackend
+{
+    RecordingAssetManager &am;
+    CommandLog            &log;
+    AssetID                pipeline = -1;
+
+    void bindPipeline(const DrawCommand &cmd)
+    {
+        pipeline = cmd.pipeline;
+        log.bindPipeline(pipeline);
+    }
+    void bindTexture(const DrawCommand &cmd) { log.bindTexture(cmd.texture); }
+    void bindMesh(const DrawCommand &cmd) { log.bindMesh(cmd.mesh); }
+    void draw(const DrawCommand &cmd)
+    {
+        log.bindPipeline(pipeline);
+        log.record(CommandLog::Op::Uniform, u_mvp, sizeof(glm::mat4));
+        log.record(CommandLog::Op::Draw, cmd.mesh);
+    }
+    bool drawInstanced(const DrawCommand *const *commands, std::size_t count)
+    {
+        AssetID instanced = am.getInstancedPipeline(pipeline);
+        if (instanced < 0)
+        {
+            for (std::size_t i = 0; i < count; i++)
+                draw(*commands[i]);
+            return false;
+        }
+
+        log.bindPipeline(instanced);
+        log.record(CommandLog::Op::Uniform, u_vp, sizeof(glm::mat4));
+        log.record(CommandLog::Op::DrawInstanced, commands[0]->mesh, static_cast<std::uint32_t>(count));
+        return true;
+    }
+};
+
+struct RecordingRenderer::Internal
+{
+    RecordingAssetManager      m_assetManager;
+    CommandLog                 m_log;
+    FramePacket                m_packet;
+    FrameCulling               m_culling;
+    SpriteBatch                m_spriteBatch;
+    RenderQueue                m_renderQueue;
+    std::vector<std::uint64_t> m_textVersions; /** mesh version held by each text buffer */
+    std::uint64_t              m_frame = 0;
+
+    /** Mirrors OpenGLSpriteBatcher::flush, one draw per layer/pipeline/texture run */
+    void recordSprites(const FramePacket::Camera &camera, const std::vector<FramePacket::Sprite> &sprites, RendererStats &stats)
+    {
+        const std::vector<std::size_t> &visible = m_culling.sprites(camera, sprites, stats);
+        if (visible.empty()) return;
+
+        for (auto index : visible)
+        {
+            auto &sprite = sprites[index];
+            m_spriteBatch.submit(sprite.layer, sprite.pipeline, sprite.texture, sprite.model, sprite.uvRect, sprite.color);
+        }
+        m_spriteBatch.sort();
+
+        for (const SpriteBatch::Run &run : m_spriteBatch.runs())
+        {
+            m_log.bindPipeline(run.pipeline);
+            m_log.bindTexture(run.texture);
+            m_log.record(CommandLog::Op::Uniform, u_mvp, sizeof(glm::mat4));
+            m_log.record(CommandLog::Op::DrawSprites, run.texture, static_cast<std::uint32_t>(run.count));
+            stats.drawCalls++;
+            stats.spriteBatches++;
+        }
+        stats.spriteCount += m_spriteBatch.size();
+        m_spriteBatch.clear();
+    }
+
+    /** Mirrors OpenGLSpriteBatcher::drawText, uploads only meshes that changed */
+    void recordTexts(const FramePacket::Camera &camera, const std::vector<FramePacket::Text> &texts, RendererStats &stats)
+    {
+        if (m_textVersions.size() < texts.size()) m_textVersions.resize(texts.size(), 0);
+        for (std::size_t i = 0; i < texts.size(); i++)
+        {
+            auto &text = texts[i];
+            if (!isVisibleTo(camera, text.renderMask)) continue;
+
+            const core::ui::TextBatch::Mesh &mesh = *text.mesh;
+            if (m_textVersions[i] != mesh.version)
+            {
+                m_log.record(CommandLog::Op::UploadText,
+                             static_cast<std::int64_t>(mesh.version),
+                             static_cast<std::uint32_t>(mesh.quads()));
+                m_textVersions[i] = mesh.version;
+                stats.streamedBytes += mesh.vertices.size() * sizeof(core::ui::TextBatch::Vertex);
+            }
+
+            m_log.bindPipeline(text.pipeline);
+            for (const core::ui::TextBatch::Run &run : mesh.runs)
+            {
+                m_log.bindTexture(run.texture);
+                m_log.record(CommandLog::Op::Uniform, u_mvp, sizeof(glm::mat4));
+                m_log.record(CommandLog::Op::DrawText, run.texture, static_cast<std::uint32_t>(run.count));
+                stats.drawCalls++;
+            }
+            stats.textQuads += mesh.quads();
+        }
+    }
+
+    void recordMeshes(const FramePacket::Camera &camera, const std::vector<FramePacket::Mesh> &meshes, RendererStats &stats)
+    {
+        queueMeshes(m_renderQueue, camera, meshes, m_culling.meshes(m_assetManager, camera, meshes, stats));
+        if (m_renderQueue.size() == 0) return;
+
+        RecordingQueueBackend backend{m_assetManager, m_log};
+        m_renderQueue.submit(backend, stats);
+    }
+};
+
+RecordingRenderer::RecordingRenderer() : Renderer("Recording"), m_internal(std::make_unique<Internal>()) {}
+RecordingRenderer::~RecordingRenderer() = default;
+
+void RecordingRenderer::init() {}
+
+void RecordingRenderer::update(const time_ms delta) {}
+
+void RecordingRenderer::clean() {}
+
+void RecordingRenderer::refresh() {}
+
+bool RecordingRenderer::renderBegin()
+{
+    m_stats.reset();
+    m_internal->m_log.clear();
+    m_internal->m_log.record(CommandLog::Op::BeginFrame, static_cast<std::int64_t>(m_internal->m_frame));
+    return true;
+}
+
+void RecordingRenderer::render()
+{
+    m_internal->m_packet.extract(m_internal->m_frame);
+    submit(m_internal->m_packet);
+}
+
+void RecordingRenderer::submit(const FramePacket &packet)
+{
+    Internal &internal = *m_internal;
+    for (std::size_t i = 0; i < packet.cameras.size(); i++)
+    {
+        const FramePacket::Camera &camera = packet.cameras[i];
+        internal.m_log.record(CommandLog::Op::Camera, static_cast<std::int64_t>(i));
+        internal.recordSprites(camera, packet.sprites, m_stats);
+        internal.recordMeshes(camera, packet.meshes, m_stats);
+        internal.recordTexts(camera, packet.texts, m_stats);
+    }
+}
+
+void RecordingRenderer::renderEnd()
+{
+    CommandLog &log = m_internal->m_log;
+    log.record(CommandLog::Op::Present);
+    m_stats.stateChanges        = log.binds();
+    m_stats.stateChangesSkipped = log.redundantBinds();
+    m_internal->m_frame++;
+    framePresentation().submitted();
+    framePresentation().presented(Time::getTime<time_us>());
+}
+
+const CommandLog &RecordingRenderer::renderFrame(const FramePacket &packet)
+{
+    renderBegin();
+    submit(packet);
+    renderEnd();
+    return m_internal->m_log;
+}
+
+const CommandLog &RecordingRenderer::log() const { return m_internal->m_log; }
+
+AssetManager          &RecordingRenderer::getAssetManager() { return m_internal->m_assetManager; }
+RecordingAssetManager &RecordingRenderer::assetManager() { return m_internal->m_assetManager; }
@@ -47,4 +47,9 @@ bool VulkanRenderer::renderBegin() { return m_internal->context.renderBegin(); }
 
 void VulkanRenderer::render() {}
 
-void VulkanRenderer::renderEnd() { m_internal->context.renderEnd(); }
+void VulkanRenderer::renderEnd()
+{
+    m_internal->context.renderEnd();
+    framePresentation().submitted();
+    framePresentation().presented(Time::getTime<time_us>());
+}
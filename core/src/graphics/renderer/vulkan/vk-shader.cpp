@@ -5,17 +5,30 @@
 #include <assets/utils.hpp>
 #include <utils/logging.hpp>
 
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <vector>
 
 vk::UniqueShaderModule createShaderModule(const vk::Device &device, const std::string &filename)
 {
     L_TAG("createShaderModule");
 
     /** @todo exception handling, maybe define a proper exception and throw again */
-    auto bytecode = core::assets::utils::loadBinaryFile(filename);
+    AssetSpan bytecode = core::assets::utils::loadBinaryFile(filename);
+
+    /** SPIR-V words must be aligned, packed assets are only copied when they aren't */
+    std::vector<uint32_t> aligned;
+    const uint32_t       *code = reinterpret_cast<const uint32_t *>(bytecode.data());
+    if (reinterpret_cast<std::uintptr_t>(bytecode.data()) % alignof(uint32_t) != 0)
+    {
+        aligned.resize((bytecode.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        std::memcpy(aligned.data(), bytecode.data(), bytecode.size());
+        code = aligned.data();
+    }
 
     vk::ShaderModuleCreateInfo shaderCreateInfo = {};
-    shaderCreateInfo.setCodeSize(bytecode.size()).setPCode(reinterpret_cast<uint32_t *>(bytecode.data()));
+    shaderCreateInfo.setCodeSize(bytecode.size()).setPCode(code);
 
     return device.createShaderModuleUnique(shaderCreateInfo);
 }
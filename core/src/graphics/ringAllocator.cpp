@@ -0,0 +1,46 @@
+#include <core/graphics/ringAllocator.hpp>
+
+#include <algorithm>
+
+static std::size_t alignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+RingAllocator::RingAllocator(std::size_t frameSize, std::size_t regionCount)
+    : m_frameSize(alignUp(frameSize, regionAlignment)), m_regionCount(std::max<std::size_t>(regionCount, 1))
+{
+}
+
+std::size_t RingAllocator::nextRegion()
+{
+    m_region = (m_region + 1) % m_regionCount;
+    m_head.store(0, std::memory_order_relaxed);
+    return m_region;
+}
+
+bool RingAllocator::fits(std::size_t bytes) const
+{
+    /** worst case the next allocation needs a full region alignment of padding */
+    return head() + bytes + regionAlignment <= m_frameSize;
+}
+
+void RingAllocator::grow(std::size_t bytes)
+{
+    m_frameSize = std::max(m_frameSize * 2, alignUp(bytes + regionAlignment, regionAlignment));
+    m_head.store(0, std::memory_order_relaxed);
+}
+
+bool RingAllocator::allocate(std::size_t bytes, std::size_t alignment, std::size_t &offset)
+{
+    std::size_t at = m_head.load(std::memory_order_relaxed);
+    std::size_t begin;
+    do
+    {
+        begin = alignUp(at, alignment);
+        if (begin + bytes > m_frameSize) return false;
+    } while (!m_head.compare_exchange_weak(at, begin + bytes, std::memory_order_relaxed));
+
+    offset = begin;
+    return true;
+}
@@ -0,0 +1,282 @@
+#include <core/graphics/spriteAtlas.hpp>
+
+#include <core/ecs/componentManager.hpp>
+#include <core/ecs/components/spriteRenderer.hpp>
+#include <core/utils/logging.hpp>
+#include <core/utils/profiler.hpp>
+#include <core/time.hpp>
+
+#include <assets/texture_p.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using core::assets::AtlasPacker;
+
+struct SpriteAtlas::Internal
+{
+    struct Page
+    {
+        std::uint32_t              width  = 0;
+        std::uint32_t              height = 0;
+        std::vector<std::uint32_t> pixels; /** RGBA8, rows from top to bottom */
+    };
+
+    /** Output of a build, published by update */
+    struct Result
+    {
+        std::vector<std::pair<AssetName, AtlasPacker::Placement>> placed;
+        std::vector<std::size_t>                                  dirtyPages;
+    };
+
+    AssetManager &assetManager;
+    Settings      settings;
+    std::string   name; /** prefix of the page texture names, unique per atlas */
+
+    /** owned by the running build, only touched by update once it is done */
+    AtlasPacker       packer;
+    std::vector<Page> pages;
+
+    /** game thread state */
+    std::future<Result>                       job;
+    std::vector<AssetID>                      pageTextures;
+    std::unordered_map<AssetName, Region>     regions;
+    std::unordered_set<AssetName>             known;
+    std::vector<AssetName>                    pending;
+    bool                                      buildRequested = false;
+    mutable std::mutex                        mutex;
+
+    Internal(AssetManager &assetManager, const Settings &settings)
+        : assetManager(assetManager),
+          settings(settings),
+          packer(settings.packer)
+    {
+        static std::atomic<unsigned int> atlasCount{0};
+        name = fmt::format("spriteAtlas{}", atlasCount++);
+
+        L_TAG("SpriteAtlas::Internal");
+        L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
+    }
+
+    ~Internal()
+    {
+        L_TAG("SpriteAtlas::~Internal");
+        if (job.valid()) job.wait();
+        L_TRACE("Internal resources freed ({})", static_cast<void *>(this));
+    }
+
+    /** Copies @p surface into @p page at @p rect, extending the edges by @p border pixels */
+    static void blit(Page &page, const SDL_Surface *surface, const AtlasPacker::Rect &rect, std::uint32_t border)
+    {
+        for (std::uint32_t row = 0; row < rect.h; row++)
+        {
+            const char    *source = static_cast<const char *>(surface->pixels) + row * surface->pitch;
+            std::uint32_t *target = page.pixels.data() + std::size_t(rect.y + row) * page.width + rect.x;
+            std::memcpy(target, source, rect.w * 4);
+            std::fill(target - border, target, target[0]);
+            std::fill(target + rect.w, target + rect.w + border, target[rect.w - 1]);
+        }
+
+        const std::uint32_t *top    = page.pixels.data() + std::size_t(rect.y) * page.width + rect.x - border;
+        const std::uint32_t *bottom = top + std::size_t(rect.h - 1) * page.width;
+        const std::size_t    span   = rect.w + 2 * border;
+        for (std::uint32_t i = 1; i <= border; i++)
+        {
+            std::copy(top, top + span, page.pixels.data() + std::size_t(rect.y - i) * page.width + rect.x - border);
+            std::copy(bottom,
+                      bottom + span,
+                      page.pixels.data() + std::size_t(rect.y + rect.h - 1 + i) * page.width + rect.x - border);
+        }
+    }
+
+    /** Runs on the worker thread */
+    Result pack(std::vector<AssetName> sprites)
+    {
+        L_TAG("SpriteAtlas::pack");
+        PROFILER_BLOCK("SpriteAtlas::pack");
+        const time_us start = Time::getTime<time_us>();
+
+        std::vector<core::assets::Texture> textures;
+        std::vector<AtlasPacker::Rect>     sizes;
+        textures.reserve(sprites.size());
+        for (const AssetName &sprite : sprites)
+        {
+            textures.emplace_back(sprite);
+            sizes.push_back({0,
+                             0,
+                             static_cast<std::uint32_t>(textures.back().width()),
+                             static_cast<std::uint32_t>(textures.back().height())});
+        }
+
+        Result result;
+        auto   placements = packer.pack(sizes);
+        for (std::size_t page = pages.size(); page < packer.pages().size(); page++)
+        {
+            const auto &packed = packer.pages()[page];
+            pages.push_back(Page{packed.width, packed.height, {}});
+            pages.back().pixels.resize(std::size_t(packed.width) * packed.height, 0);
+        }
+
+        const std::uint32_t border = settings.bleed ? settings.packer.padding : 0;
+        for (std::size_t i = 0; i < sprites.size(); i++)
+        {
+            const AtlasPacker::Placement &placement = placements[i];
+            blit(pages[placement.page], textures[i].getInternal().m_surface, placement.rect, border);
+            result.placed.emplace_back(std::move(sprites[i]), placement);
+            result.dirtyPages.push_back(placement.page);
+        }
+        std::sort(result.dirtyPages.begin(), result.dirtyPages.end());
+        result.dirtyPages.erase(std::unique(result.dirtyPages.begin(), result.dirtyPages.end()),
+                                result.dirtyPages.end());
+
+        L_DEBUG("Packed {} sprites into {} pages in {} us",
+                result.placed.size(),
+                result.dirtyPages.size(),
+                (Time::getTime<time_us>() - start).count());
+        return result;
+    }
+
+    void start()
+    {
+        std::vector<AssetName> sprites;
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            sprites.swap(pending);
+            buildRequested = false;
+        }
+        if (sprites.empty()) return;
+        job = std::async(std::launch::async, &Internal::pack, this, std::move(sprites));
+    }
+
+    void publish(Result result)
+    {
+        L_TAG("SpriteAtlas::publish");
+
+        for (std::size_t page : result.dirtyPages)
+        {
+            const Page           &p = pages[page];
+            core::assets::Texture texture(fmt::format("{}/page{}", name, page), p.width, p.height, p.pixels.data());
+            if (page < pageTextures.size())
+                assetManager.updateTexture(pageTextures[page], texture);
+            else
+            {
+                pageTextures.resize(page + 1, -1);
+                pageTextures[page] = assetManager.loadTexture(texture);
+            }
+        }
+
+        std::unordered_map<AssetName, Region> published;
+        for (auto &entry : result.placed)
+        {
+            const AtlasPacker::Placement &placement = entry.second;
+            const Page                   &page      = pages[placement.page];
+            const float                   w         = static_cast<float>(page.width);
+            const float                   h         = static_cast<float>(page.height);
+
+            /** textures are flipped on upload, v grows from the bottom row */
+            Region region;
+            region.texture = pageTextures[placement.page];
+            region.page    = placement.page;
+            region.uvRect  = glm::vec4(placement.rect.x / w,
+                                      1.0f - (placement.rect.y + placement.rect.h) / h,
+                                      (placement.rect.x + placement.rect.w) / w,
+                                      1.0f - placement.rect.y / h);
+            published.emplace(entry.first, region);
+        }
+
+        /** sprites loaded before the build keep their uv rect, mapped into the region */
+        for (auto &sprite : ComponentManager::getInstance().getComponents<SpriteRenderer>())
+        {
+            auto it = published.find(sprite->getSpriteName());
+            if (it == published.end() || sprite->getTextureID() == it->second.texture) continue;
+
+            const glm::vec4 &uv     = sprite->getUVRect();
+            const glm::vec4 &region = it->second.uvRect;
+            const glm::vec2  scale  = glm::vec2(region.z - region.x, region.w - region.y);
+            sprite->setTextureID(it->second.texture);
+            sprite->setUVRect(glm::vec4(region.x + uv.x * scale.x,
+                                        region.y + uv.y * scale.y,
+                                        region.x + uv.z * scale.x,
+                                        region.y + uv.w * scale.y));
+        }
+
+        std::lock_guard<std::mutex> l(mutex);
+        for (auto &entry : published) regions[entry.first] = entry.second;
+    }
+};
+
+SpriteAtlas::SpriteAtlas(AssetManager &assetManager) : SpriteAtlas(assetManager, Settings()) {}
+SpriteAtlas::SpriteAtlas(AssetManager &assetManager, const Settings &settings)
+    : m_internal(std::make_unique<Internal>(assetManager, settings))
+{
+}
+SpriteAtlas::~SpriteAtlas()                             = default;
+SpriteAtlas::SpriteAtlas(SpriteAtlas &&o)            = default;
+SpriteAtlas &SpriteAtlas::operator=(SpriteAtlas &&o) = default;
+
+void SpriteAtlas::add(const AssetName &sprite)
+{
+    std::lock_guard<std::mutex> l(m_internal->mutex);
+    if (m_internal->known.insert(sprite).second) m_internal->pending.push_back(sprite);
+}
+
+void SpriteAtlas::build()
+{
+    if (m_internal->job.valid())
+    {
+        std::lock_guard<std::mutex> l(m_internal->mutex);
+        m_internal->buildRequested = true;
+        return;
+    }
+    m_internal->start();
+}
+
+bool SpriteAtlas::update()
+{
+    L_TAG("SpriteAtlas::update");
+
+    auto &job = m_internal->job;
+    if (!job.valid() || job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+
+    m_internal->publish(job.get());
+
+    bool requested;
+    {
+        std::lock_guard<std::mutex> l(m_internal->mutex);
+        requested = m_internal->buildRequested;
+    }
+    if (requested) m_internal->start();
+    return true;
+}
+
+bool SpriteAtlas::wait()
+{
+    bool published = false;
+    while (m_internal->job.valid())
+    {
+        m_internal->job.wait();
+        published |= update();
+    }
+    return published;
+}
+
+bool SpriteAtlas::busy() const { return m_internal->job.valid(); }
+
+bool SpriteAtlas::find(const AssetName &sprite, Region &region) const
+{
+    std::lock_guard<std::mutex> l(m_internal->mutex);
+    auto                        it = m_internal->regions.find(sprite);
+    if (it == m_internal->regions.end()) return false;
+    region = it->second;
+    return true;
+}
+
+std::size_t SpriteAtlas::pageCount() const { return m_internal->pageTextures.size(); }
@@ -0,0 +1,69 @@
+#include <core/graphics/spriteBatch.hpp>
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+
+/** key fields, most significant first: | layer (8) | pipeline (24) | texture (32) | */
+static constexpr unsigned textureBits   = 32;
+static constexpr unsigned pipelineBits  = 24;
+static constexpr unsigned pipelineShift = textureBits;
+static constexpr unsigned layerShift    = pipelineShift + pipelineBits;
+
+static constexpr std::uint64_t mask(unsigned bits) { return (std::uint64_t(1) << bits) - 1; }
+
+SpriteBatch::SpriteBatch()  = default;
+SpriteBatch::~SpriteBatch() = default;
+
+void SpriteBatch::submit(std::uint8_t     layer,
+                         AssetID          pipeline,
+                         AssetID          texture,
+                         const glm::mat4 &model,
+                         const glm::vec4 &uvRect,
+                         const glm::vec4 &color)
+{
+    Sprite sprite;
+    sprite.key    = (static_cast<std::uint64_t>(layer) << layerShift)
+               | ((static_cast<std::uint64_t>(pipeline) & mask(pipelineBits)) << pipelineShift)
+               | (static_cast<std::uint64_t>(texture) & mask(textureBits));
+    /** unit quad corners only need the translation and the first two basis vectors */
+    sprite.origin = glm::vec3(model[3]);
+    sprite.axisX  = glm::vec3(model[0]);
+    sprite.axisY  = glm::vec3(model[1]);
+    sprite.uvRect = uvRect;
+    sprite.color  = glm::packUnorm4x8(color);
+    m_sprites.push_back(sprite);
+}
+
+void SpriteBatch::sort()
+{
+    const std::size_t spriteCount = m_sprites.size();
+
+    /** sort by key, layer first, the index keeps submission order within a run */
+    m_order.resize(spriteCount);
+    for (std::uint32_t i = 0; i < spriteCount; i++)
+        m_order[i] = {m_sprites[i].key, i};
+    std::sort(m_order.begin(), m_order.end());
+
+    m_runs.clear();
+    for (std::size_t begin = 0; begin < spriteCount;)
+    {
+        const std::uint64_t key = m_order[begin].first;
+        std::size_t         end = begin + 1;
+        while (end < spriteCount && m_order[end].first == key)
+            end++;
+
+        m_runs.push_back({static_cast<AssetID>((key >> pipelineShift) & mask(pipelineBits)),
+                          static_cast<AssetID>(key & mask(textureBits)),
+                          begin,
+                          end - begin});
+        begin = end;
+    }
+}
+
+void SpriteBatch::clear()
+{
+    m_sprites.clear();
+    m_order.clear();
+    m_runs.clear();
+}
@@ -2,6 +2,8 @@
 #include <graphics/window_p.hpp>
 #include <utils/logging.hpp>
 
+#include <string_view>
+
 #if defined(CONFIG_CORE_RENDERER_VULKAN)
 #include <core/graphics/renderer/vulkan/vk-renderer.hpp>
 #endif
@@ -24,12 +26,17 @@ namespace core::graphics
 
         SDL_WindowFlags glFlags = OpenGLRenderer::getWindowFlags();
 
+        /** the offscreen driver renders to an EGL pbuffer, there is nothing to show or resize */
+        const char *driver    = SDL_GetCurrentVideoDriver();
+        const bool  offscreen = driver && std::string_view(driver) == "offscreen";
+        Uint32      flags     = offscreen ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE;
+
         window = SDL_CreateWindow(windowTitle.c_str(),
                                   SDL_WINDOWPOS_CENTERED,
                                   SDL_WINDOWPOS_CENTERED,
                                   windowWidth,
                                   windowHeight,
-                                  SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE | glFlags);
+                                  flags | glFlags);
         if (nullptr == window)
         {
             L_THROW_RUNTIME("Could not create window");
@@ -0,0 +1,196 @@
+#include <core/input/actionMap.hpp>
+#include <core/utils/bits.hpp>
+#include <core/utils/logging.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::uint8_t findName(const std::vector<std::string> &names, std::string_view name)
+    {
+        auto it = std::find(names.begin(), names.end(), name);
+        return it == names.end() ? InvalidAction : static_cast<std::uint8_t>(it - names.begin());
+    }
+} // namespace
+
+ActionMap::ActionMap()  = default;
+ActionMap::~ActionMap() = default;
+
+ActionID ActionMap::addAction(std::string_view name)
+{
+    L_TAG("ActionMap::addAction");
+
+    ActionID id = findAction(name);
+    if (id != InvalidAction) return id;
+    if (m_actionNames.size() >= MaxActions) L_THROW_RUNTIME("Too many actions (max {})", MaxActions);
+
+    m_actionNames.emplace_back(name);
+    return static_cast<ActionID>(m_actionNames.size() - 1);
+}
+
+AxisID ActionMap::addAxis(std::string_view name)
+{
+    L_TAG("ActionMap::addAxis");
+
+    AxisID id = findAxis(name);
+    if (id != InvalidAction) return id;
+    if (m_axisNames.size() >= MaxAxes) L_THROW_RUNTIME("Too many axes (max {})", MaxAxes);
+
+    m_axisNames.emplace_back(name);
+    return static_cast<AxisID>(m_axisNames.size() - 1);
+}
+
+ActionID ActionMap::findAction(std::string_view name) const { return findName(m_actionNames, name); }
+AxisID   ActionMap::findAxis(std::string_view name) const { return findName(m_axisNames, name); }
+
+ActionMap &ActionMap::bindKey(ActionID action, SDL_Scancode key)
+{
+    L_TAG("ActionMap::bindKey");
+    L_ASSERT(action < m_actionNames.size(), "Invalid action id({})", action);
+    L_ASSERT(key > SDL_SCANCODE_UNKNOWN && key < SDL_NUM_SCANCODES, "Invalid scancode({})", static_cast<int>(key));
+
+    m_keyBindings.emplace_back(key, action);
+    m_compiled = false;
+    return *this;
+}
+
+ActionMap &ActionMap::bindMouseButton(ActionID action, std::uint8_t button)
+{
+    L_TAG("ActionMap::bindMouseButton");
+    L_ASSERT(action < m_actionNames.size(), "Invalid action id({})", action);
+    L_ASSERT(button > 0 && button <= m_mouseMasks.size(), "Invalid mouse button({})", button);
+
+    m_mouseBindings.emplace_back(button, action);
+    m_compiled = false;
+    return *this;
+}
+
+ActionMap &ActionMap::bindControllerButton(ActionID action, SDL_GameControllerButton button)
+{
+    L_TAG("ActionMap::bindControllerButton");
+    L_ASSERT(action < m_actionNames.size(), "Invalid action id({})", action);
+    L_ASSERT(button > SDL_CONTROLLER_BUTTON_INVALID && button < SDL_CONTROLLER_BUTTON_MAX,
+             "Invalid controller button({})",
+             static_cast<int>(button));
+
+    m_controllerBindings.emplace_back(button, action);
+    m_compiled = false;
+    return *this;
+}
+
+ActionMap &ActionMap::bindKeyAxis(AxisID axis, SDL_Scancode negative, SDL_Scancode positive, float scale)
+{
+    L_TAG("ActionMap::bindKeyAxis");
+    L_ASSERT(axis < m_axisNames.size(), "Invalid axis id({})", axis);
+
+    m_axisBindings.push_back({axis, AxisSource::KeyPair, negative, positive, scale, 0.0f});
+    m_compiled = false;
+    return *this;
+}
+
+ActionMap &ActionMap::bindMouseAxis(AxisID axis, MouseAxis mouseAxis, float scale)
+{
+    L_TAG("ActionMap::bindMouseAxis");
+    L_ASSERT(axis < m_axisNames.size(), "Invalid axis id({})", axis);
+
+    m_axisBindings.push_back({axis, AxisSource::Mouse, static_cast<int>(mouseAxis), 0, scale, 0.0f});
+    m_compiled = false;
+    return *this;
+}
+
+ActionMap &ActionMap::bindControllerAxis(AxisID axis, SDL_GameControllerAxis controllerAxis, float scale, float deadzone)
+{
+    L_TAG("ActionMap::bindControllerAxis");
+    L_ASSERT(axis < m_axisNames.size(), "Invalid axis id({})", axis);
+    L_ASSERT(controllerAxis > SDL_CONTROLLER_AXIS_INVALID && controllerAxis < SDL_CONTROLLER_AXIS_MAX,
+             "Invalid controller axis({})",
+             static_cast<int>(controllerAxis));
+
+    m_axisBindings.push_back({axis, AxisSource::Controller, controllerAxis, 0, scale, deadzone});
+    m_compiled = false;
+    return *this;
+}
+
+void ActionMap::clearBindings()
+{
+    m_keyBindings.clear();
+    m_mouseBindings.clear();
+    m_controllerBindings.clear();
+    m_axisBindings.clear();
+    m_compiled = false;
+}
+
+void ActionMap::compile()
+{
+    L_TAG("ActionMap::compile");
+
+    m_keyMasks.fill(ActionMask());
+    m_mouseMasks.fill(ActionMask());
+    m_controllerMasks.fill(ActionMask());
+    m_boundKeys.clear();
+    m_usedMouseButtons      = 0;
+    m_usedControllerButtons = 0;
+
+    for (auto &[key, action] : m_keyBindings)
+    {
+        if (m_keyMasks[key].none()) m_boundKeys.push_back(static_cast<std::uint16_t>(key));
+        m_keyMasks[key].set(action);
+    }
+    for (auto &[button, action] : m_mouseBindings)
+    {
+        m_mouseMasks[button - 1].set(action);
+        m_usedMouseButtons |= SDL_BUTTON(button);
+    }
+    for (auto &[button, action] : m_controllerBindings)
+    {
+        m_controllerMasks[button].set(action);
+        m_usedControllerButtons |= 1u << button;
+    }
+    std::sort(m_boundKeys.begin(), m_boundKeys.end());
+
+    m_compiled = true;
+    L_DEBUG("Compiled {} actions, {} axes, {} bound keys", m_actionNames.size(), m_axisNames.size(), m_boundKeys.size());
+}
+
+void ActionMap::evaluate(const InputSample &sample, ActionState &state)
+{
+    if (!m_compiled) compile();
+
+    ActionMask down;
+    if (sample.keys)
+    {
+        for (std::uint16_t key : m_boundKeys)
+            if (key < sample.keyCount && sample.keys[key]) down |= m_keyMasks[key];
+    }
+    for (std::uint32_t buttons = sample.mouseButtons & m_usedMouseButtons; buttons; buttons &= buttons - 1)
+        down |= m_mouseMasks[core::utils::countr_zero(buttons)];
+    for (std::uint32_t buttons = sample.controllerButtons & m_usedControllerButtons; buttons; buttons &= buttons - 1)
+        down |= m_controllerMasks[core::utils::countr_zero(buttons)];
+
+    state.pressed  = down & ~state.down;
+    state.released = state.down & ~down;
+    state.down     = down;
+    state.frame++;
+
+    state.axes.fill(0.0f);
+    for (const auto &b : m_axisBindings)
+    {
+        float value = 0.0f;
+        switch (b.source)
+        {
+        case AxisSource::KeyPair:
+            if (sample.keys)
+                value = static_cast<float>((b.code2 < sample.keyCount && sample.keys[b.code2] ? 1 : 0)
+                                           - (b.code < sample.keyCount && sample.keys[b.code] ? 1 : 0));
+            break;
+        case AxisSource::Mouse: value = sample.mouse[b.code]; break;
+        case AxisSource::Controller:
+            value = sample.controllerAxes[b.code];
+            if (std::fabs(value) < b.deadzone) value = 0.0f;
+            break;
+        }
+        /** several bindings on one axis add up */
+        state.axes[b.axis] += value * b.scale;
+    }
+}
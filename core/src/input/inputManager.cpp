@@ -1,49 +1,78 @@
 #include <core/input/inputManager.hpp>
+#include <core/graphics/renderer.hpp>
 #include <core/utils/logging.hpp>
-#include <core/ecs/componentManager.hpp>
+
+#include "inputSampler.hpp"
+#include "latencyProbe.hpp"
 
 #include <SDL.h>
 
-#include <unordered_map>
-
-const std::unordered_map<SDL_EventType, int> inputEventTypes = {
-    {SDL_KEYDOWN,                  1},
-    {SDL_KEYUP,                    1},
-    {SDL_TEXTEDITING,              1},
-    {SDL_TEXTINPUT,                1},
-    {SDL_KEYMAPCHANGED,            1},
-    {SDL_MOUSEMOTION,              1},
-    {SDL_MOUSEBUTTONDOWN,          1},
-    {SDL_MOUSEBUTTONUP,            1},
-    {SDL_MOUSEWHEEL,               1},
-    {SDL_JOYAXISMOTION,            1},
-    {SDL_JOYBALLMOTION,            1},
-    {SDL_JOYHATMOTION,             1},
-    {SDL_JOYBUTTONDOWN,            1},
-    {SDL_JOYBUTTONUP,              1},
-    {SDL_JOYDEVICEADDED,           1},
-    {SDL_JOYDEVICEREMOVED,         1},
-    {SDL_CONTROLLERAXISMOTION,     1},
-    {SDL_CONTROLLERBUTTONDOWN,     1},
-    {SDL_CONTROLLERBUTTONUP,       1},
-    {SDL_CONTROLLERDEVICEADDED,    1},
-    {SDL_CONTROLLERDEVICEREMOVED,  1},
-    {SDL_CONTROLLERDEVICEREMAPPED, 1},
-    {SDL_FINGERDOWN,               1},
-    {SDL_FINGERUP,                 1},
-    {SDL_FINGERMOTION,             1},
-    {SDL_DOLLARGESTURE,            1},
-    {SDL_DOLLARRECORD,             1},
-    {SDL_MULTIGESTURE,             1},
-    {SDL_CLIPBOARDUPDATE,          1},
-    {SDL_DROPFILE,                 1},
-    {SDL_DROPTEXT,                 1},
-    {SDL_DROPBEGIN,                1},
-    {SDL_DROPCOMPLETE,             1}
-};
-
-InputManager::InputManager()  = default;
-InputManager::~InputManager() = default;
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iterator>
+
+namespace
+{
+    /** Input event types, the position in this list is the event's subscription slot */
+    constexpr SDL_EventType inputEventTypes[] = {
+        SDL_KEYDOWN,
+        SDL_KEYUP,
+        SDL_TEXTEDITING,
+        SDL_TEXTINPUT,
+        SDL_KEYMAPCHANGED,
+        SDL_MOUSEMOTION,
+        SDL_MOUSEBUTTONDOWN,
+        SDL_MOUSEBUTTONUP,
+        SDL_MOUSEWHEEL,
+        SDL_JOYAXISMOTION,
+        SDL_JOYBALLMOTION,
+        SDL_JOYHATMOTION,
+        SDL_JOYBUTTONDOWN,
+        SDL_JOYBUTTONUP,
+        SDL_JOYDEVICEADDED,
+        SDL_JOYDEVICEREMOVED,
+        SDL_CONTROLLERAXISMOTION,
+        SDL_CONTROLLERBUTTONDOWN,
+        SDL_CONTROLLERBUTTONUP,
+        SDL_CONTROLLERDEVICEADDED,
+        SDL_CONTROLLERDEVICEREMOVED,
+        SDL_CONTROLLERDEVICEREMAPPED,
+        SDL_FINGERDOWN,
+        SDL_FINGERUP,
+        SDL_FINGERMOTION,
+        SDL_DOLLARGESTURE,
+        SDL_DOLLARRECORD,
+        SDL_MULTIGESTURE,
+        SDL_CLIPBOARDUPDATE,
+        SDL_DROPFILE,
+        SDL_DROPTEXT,
+        SDL_DROPBEGIN,
+        SDL_DROPCOMPLETE};
+    static_assert(std::size(inputEventTypes) == InputEventTypeCount, "InputEventTypeCount mismatch");
+
+    /** Flat table from SDL event type to subscription slot, -1 for non-input events */
+    constexpr std::size_t inputEventSlotCount = SDL_DROPCOMPLETE + 1;
+    constexpr std::array<int8_t, inputEventSlotCount> buildInputEventSlots()
+    {
+        std::array<int8_t, inputEventSlotCount> slots = {};
+        for (std::size_t i = 0; i < slots.size(); i++)
+            slots[i] = -1;
+        for (std::size_t i = 0; i < InputEventTypeCount; i++)
+            slots[inputEventTypes[i]] = static_cast<int8_t>(i);
+        return slots;
+    }
+    constexpr std::array<int8_t, inputEventSlotCount> inputEventSlots = buildInputEventSlots();
+
+    /** Subscription slot of SDL event @p type, -1 if it's not an input event */
+    inline int inputEventSlot(const Uint32 type)
+    {
+        return type < inputEventSlotCount ? inputEventSlots[type] : -1;
+    }
+} // namespace
+
+InputManager::InputManager() = default;
+InputManager::~InputManager() { clean(); }
 
 InputManager &InputManager::getInstance()
 {
@@ -58,7 +87,27 @@ void InputManager::init()
 
     int numKeys = 0;
     m_keyState  = SDL_GetKeyboardState(&numKeys);
-    m_lastFrameKeyState.reserve(numKeys);
+    m_lastFrameKeyState.assign(m_keyState, m_keyState + numKeys);
+
+    m_inputSample.keys     = m_keyState;
+    m_inputSample.keyCount = numKeys;
+
+#if defined(CONFIG_CORE_INPUT_THREAD)
+#if defined(CONFIG_CORE_INPUT_THREAD_PUMP)
+    constexpr bool pumpEvents = true;
+#else
+    constexpr bool pumpEvents = false;
+#endif
+    m_sampler = std::make_unique<InputSampler>(time_us(1000000 / CONFIG_CORE_INPUT_THREAD_RATE), pumpEvents);
+    m_sampler->start();
+#endif
+
+    /** headless latency measurement, interval in milliseconds */
+    if (const char *probe = std::getenv("CORE_INPUT_LATENCY_PROBE"))
+    {
+        long interval = std::strtol(probe, nullptr, 10);
+        if (interval > 0) startLatencyProbe(time_us(interval * 1000));
+    }
     /** @todo: do we setup event filters here for input events? */
 }
 
@@ -66,20 +115,45 @@ void InputManager::preUpdate()
 {
     L_TAG("InputManager::preUpdate");
 
-    /** @todo: add support for controllers
-     * initialize or cleanup when # of joysticks mismatched
-     */
-
     /** Clear current event queue (hopefully we dont need to reserve since clear doesn't free current memory) */
     m_inputEvents.clear();
+    m_inputEventTimes.clear();
+
+#if defined(CONFIG_CORE_INPUT_THREAD)
+    /** events drained at late-latch time come first */
+    for (const auto &timed : m_latchedEvents)
+    {
+        m_inputEvents.push_back(timed.event);
+        m_inputEventTimes.push_back(timed.timestamp);
+    }
+    m_latchedEvents.clear();
 
+    TimedInputEvent timed;
+    while (m_sampler->pop(timed))
+    {
+        m_inputEvents.push_back(timed.event);
+        m_inputEventTimes.push_back(timed.timestamp);
+    }
+
+    /** the sampler leaves clipboard and drop events in SDL's queue */
+    constexpr int batchSize = 16;
+    SDL_Event     events[batchSize];
+    int           count;
+    while ((count = SDL_PeepEvents(events, batchSize, SDL_GETEVENT, SDL_CLIPBOARDUPDATE, SDL_DROPCOMPLETE)) > 0)
+    {
+        time_us now = Time::getTime<time_us>();
+        for (int i = 0; i < count; i++)
+        {
+            m_inputEvents.push_back(events[i]);
+            m_inputEventTimes.push_back(now);
+        }
+    }
+#else
     SDL_FilterEvents(
         [](void *userdata, SDL_Event *event) -> int {
             std::vector<SDL_Event> *inputEvents = static_cast<std::vector<SDL_Event> *>(userdata);
 
-            /** @todo: should we make the map non-const and push non-filtered event types with 0 value ? */
-            auto it = inputEventTypes.find(static_cast<SDL_EventType>(event->type));
-            if (it != inputEventTypes.end() && it->second)
+            if (inputEventSlot(event->type) >= 0)
             {
                 /** Push filtered input events to our the input event queue */
                 inputEvents->push_back(*event);
@@ -88,7 +162,97 @@ void InputManager::preUpdate()
             return 1;
         },
         &m_inputEvents);
+    m_inputEventTimes.resize(m_inputEvents.size(), Time::getTime<time_us>());
+#endif
+    if (m_probe) filterProbeEvents();
     if (m_inputEvents.size()) L_TRACE_RATE(32, "Queue has {} input events", m_inputEvents.size());
+
+    sampleDevices();
+    m_actionMap.evaluate(m_inputSample, m_actionState);
+}
+
+void InputManager::sampleDevices()
+{
+    /** relative axes only hold this frame's motion */
+    m_inputSample.mouse.fill(0.0f);
+    for (const auto &ev : m_inputEvents)
+    {
+        switch (ev.type)
+        {
+        case SDL_MOUSEMOTION:
+            m_inputSample.mouse[static_cast<int>(MouseAxis::X)] += static_cast<float>(ev.motion.xrel);
+            m_inputSample.mouse[static_cast<int>(MouseAxis::Y)] += static_cast<float>(ev.motion.yrel);
+            break;
+        case SDL_MOUSEWHEEL:
+            m_inputSample.mouse[static_cast<int>(MouseAxis::Wheel)] += static_cast<float>(ev.wheel.y);
+            break;
+        case SDL_CONTROLLERBUTTONDOWN:
+            m_inputSample.controllerButtons |= 1u << ev.cbutton.button;
+            break;
+        case SDL_CONTROLLERBUTTONUP:
+            m_inputSample.controllerButtons &= ~(1u << ev.cbutton.button);
+            break;
+        case SDL_CONTROLLERAXISMOTION:
+            m_inputSample.controllerAxes[ev.caxis.axis] = static_cast<float>(ev.caxis.value) / 32767.0f;
+            break;
+        case SDL_CONTROLLERDEVICEADDED: openController(ev.cdevice.which); break;
+        case SDL_CONTROLLERDEVICEREMOVED: closeController(ev.cdevice.which); break;
+        default: break;
+        }
+    }
+    m_inputSample.mouseButtons = SDL_GetMouseState(nullptr, nullptr);
+}
+
+void InputManager::openController(int deviceIndex)
+{
+    L_TAG("InputManager::openController");
+
+    /** added events are also sent for controllers connected at startup */
+    if (SDL_GameControllerFromInstanceID(SDL_JoystickGetDeviceInstanceID(deviceIndex))) return;
+
+    SDL_GameController *controller = SDL_GameControllerOpen(deviceIndex);
+    if (!controller)
+    {
+        L_WARN("Could not open controller {}: {}", deviceIndex, SDL_GetError());
+        return;
+    }
+    m_controllers.push_back(controller);
+    L_DEBUG("Opened controller {}", SDL_GameControllerName(controller));
+}
+
+void InputManager::closeController(SDL_JoystickID instanceID)
+{
+    L_TAG("InputManager::closeController");
+
+    SDL_GameController *controller = SDL_GameControllerFromInstanceID(instanceID);
+    auto                it         = std::find(m_controllers.begin(), m_controllers.end(), controller);
+    if (!controller || it == m_controllers.end()) return;
+
+    L_DEBUG("Closed controller {}", SDL_GameControllerName(controller));
+    SDL_GameControllerClose(controller);
+    m_controllers.erase(it);
+
+    /** the removed controller won't send release events */
+    m_inputSample.controllerButtons = 0;
+    m_inputSample.controllerAxes.fill(0.0f);
+}
+
+void InputManager::filterProbeEvents()
+{
+    std::size_t out = 0;
+    for (std::size_t e = 0; e < m_inputEvents.size(); e++)
+    {
+        if (InputLatencyProbe::isProbeEvent(m_inputEvents[e]))
+        {
+            m_probe->consume(m_inputEvents[e]);
+            continue;
+        }
+        m_inputEvents[out]     = m_inputEvents[e];
+        m_inputEventTimes[out] = m_inputEventTimes[e];
+        out++;
+    }
+    m_inputEvents.resize(out);
+    m_inputEventTimes.resize(out);
 }
 
 void InputManager::fixedUpdate(const time_ms &delta) {}
@@ -96,17 +260,135 @@ void InputManager::fixedUpdate(const time_ms &delta) {}
 void InputManager::update(const time_ms &delta)
 {
     L_TAG("InputManager::update");
-    /** Feed the current input event queue to input components */
+    m_frameDelta = delta;
+    /** Feed the current input event queue to subscribed input components */
     /** @todo: possible threaded optimization for input events */
-    for (auto &ev : m_inputEvents)
+    for (std::size_t e = 0; e < m_inputEvents.size(); e++)
     {
-        ComponentManager::getInstance().foreach<InputComponent>([&ev](InputComponent &c) -> void {
-            auto f = c.m_listeners.find(static_cast<InputEventType>(ev.type));
-            if (f != c.m_listeners.end()) f->second(static_cast<InputEventType>(ev.type), &ev);
-        });
+        SDL_Event &ev   = m_inputEvents[e];
+        int        slot = inputEventSlot(ev.type);
+        if (slot < 0) continue;
+        m_currentEventTime = m_inputEventTimes[e];
+
+        /** index loop, listeners may add subscriptions */
+        auto &subscribers = m_subscriptions[slot];
+        m_dispatching     = true;
+        for (std::size_t i = 0; i < subscribers.size(); i++)
+        {
+            if (!subscribers[i].component) continue;
+            (*subscribers[i].listener)(static_cast<InputEventType>(ev.type), &ev);
+        }
+        m_dispatching = false;
     }
+
+    /** listeners may have destroyed components, drop their disabled subscriptions */
+    if (m_unsubscribed)
+    {
+        for (auto &subscribers : m_subscriptions)
+            subscribers.erase(std::remove_if(subscribers.begin(),
+                                             subscribers.end(),
+                                             [](const Subscription &s) { return !s.component; }),
+                              subscribers.end());
+        m_unsubscribed = false;
+    }
+}
+
+void InputManager::clean()
+{
+    if (m_probe) stopLatencyProbe();
+    m_sampler.reset();
+    for (SDL_GameController *controller : m_controllers) SDL_GameControllerClose(controller);
+    m_controllers.clear();
+}
+
+void InputManager::lateLatch()
+{
+    L_TAG("InputManager::lateLatch");
+    m_latchedState = m_actionState;
+
+#if defined(CONFIG_CORE_INPUT_LATE_LATCH)
+#if !defined(CONFIG_CORE_INPUT_THREAD_PUMP)
+    SDL_PumpEvents();
+#endif
+
+    if (m_probe)
+    {
+        /** probe events that arrived since preUpdate are consumed by this frame */
+#if defined(CONFIG_CORE_INPUT_THREAD)
+        TimedInputEvent timed;
+        while (m_sampler->pop(timed))
+        {
+            if (InputLatencyProbe::isProbeEvent(timed.event)) m_probe->consume(timed.event);
+            m_latchedEvents.push_back(timed);
+        }
+#else
+        constexpr int batchSize = 64;
+        SDL_Event     events[batchSize];
+        int           count = SDL_PeepEvents(events, batchSize, SDL_PEEKEVENT, SDL_KEYDOWN, SDL_KEYDOWN);
+        for (int i = 0; i < count; i++)
+            if (InputLatencyProbe::isProbeEvent(events[i])) m_probe->consume(events[i]);
+#endif
+    }
+
+    /** keys were refreshed by the pump, relative mouse motion keeps this frame's value */
+    InputSample sample  = m_inputSample;
+    sample.mouseButtons = SDL_GetMouseState(nullptr, nullptr);
+    m_actionMap.evaluate(sample, m_latchedState);
+#endif
+
+    for (std::size_t i = 0; i < m_lateLatchCallbacks.size(); i++)
+        m_lateLatchCallbacks[i].second(m_latchedState, m_frameDelta);
+}
+
+InputManager::LateLatchID InputManager::addLateLatchCallback(LateLatchCallback callback)
+{
+    LateLatchID id = m_nextLateLatchID++;
+    m_lateLatchCallbacks.emplace_back(id, std::move(callback));
+    return id;
+}
+
+void InputManager::removeLateLatchCallback(LateLatchID id)
+{
+    m_lateLatchCallbacks.erase(std::remove_if(m_lateLatchCallbacks.begin(),
+                                              m_lateLatchCallbacks.end(),
+                                              [id](const auto &cb) { return cb.first == id; }),
+                               m_lateLatchCallbacks.end());
+}
+
+void InputManager::frameSubmitted(const FramePresentation &presentation)
+{
+    if (!m_probe) return;
+    m_probe->submitted(presentation.framesSubmitted() - 1);
+    m_probe->presented(presentation);
 }
 
+void InputManager::startLatencyProbe(time_us interval)
+{
+    if (m_probe) return;
+    m_probe = std::make_unique<InputLatencyProbe>(interval);
+    m_probe->start();
+}
+
+InputLatencyReport InputManager::stopLatencyProbe()
+{
+    L_TAG("InputManager::stopLatencyProbe");
+    if (!m_probe) return {};
+
+    m_probe->stop();
+    InputLatencyReport report = m_probe->report();
+    m_probe.reset();
+
+    L_INFO("Input-to-present latency over {} samples: p50 {}us, p90 {}us, p99 {}us, max {}us",
+           report.samples,
+           report.p50.count(),
+           report.p90.count(),
+           report.p99.count(),
+           report.max.count());
+    return report;
+}
+
+InputLatencyReport InputManager::latencyReport() const { return m_probe ? m_probe->report() : InputLatencyReport{}; }
+
 void InputManager::postUpdate()
 {
     L_TAG("InputManager::postUpdate");
@@ -119,4 +401,41 @@ bool InputManager::isPressed(const SDL_Scancode scanCode) { return m_keyState[sc
 bool InputManager::isTapped(const SDL_Scancode scanCode)
 {
     return (!m_lastFrameKeyState[scanCode] && m_keyState[scanCode]);
-}
\ No newline at end of file
+}
+
+bool InputManager::getKeyUp(const SDL_Scancode scanCode)
+{
+    return (m_lastFrameKeyState[scanCode] && !m_keyState[scanCode]);
+}
+
+bool InputManager::getKeyDown(const SDL_Scancode scanCode) { return isTapped(scanCode); }
+
+void InputManager::subscribe(InputComponent                 *component,
+                             const InputEventType            event,
+                             const InputComponent::Listener *listener)
+{
+    L_TAG("InputManager::subscribe");
+
+    int slot = inputEventSlot(static_cast<Uint32>(event));
+    if (slot < 0) L_THROW_LOGIC("{} is not an input event", to_string(event));
+    m_subscriptions[slot].push_back({component, listener});
+}
+
+void InputManager::unsubscribe(InputComponent *component)
+{
+    /** erasing would shift the subscribers update is iterating, disable them instead */
+    if (m_dispatching)
+    {
+        for (auto &subscribers : m_subscriptions)
+            for (auto &s : subscribers)
+                if (s.component == component) s.component = nullptr;
+        m_unsubscribed = true;
+        return;
+    }
+
+    for (auto &subscribers : m_subscriptions)
+        subscribers.erase(std::remove_if(subscribers.begin(),
+                                         subscribers.end(),
+                                         [component](const Subscription &s) { return s.component == component; }),
+                          subscribers.end());
+}
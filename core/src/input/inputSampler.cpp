@@ -0,0 +1,84 @@
+#if defined(CONFIG_CORE_INPUT_THREAD)
+
+#include "inputSampler.hpp"
+
+#include <core/utils/logging.hpp>
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <chrono>
+
+InputSampler::InputSampler(time_us period, bool pumpEvents) : m_period(period), m_pumpEvents(pumpEvents) {}
+
+InputSampler::~InputSampler() { stop(); }
+
+void InputSampler::start()
+{
+    L_TAG("InputSampler::start");
+    if (m_running.exchange(true)) return;
+
+    L_DEBUG("Starting input thread (period: {}us, pump: {})", m_period.count(), m_pumpEvents);
+    m_thread = std::thread(&InputSampler::run, this);
+}
+
+void InputSampler::stop()
+{
+    if (!m_running.exchange(false)) return;
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void InputSampler::calibrate()
+{
+    L_TAG("InputSampler::calibrate");
+
+    /** ticks only have millisecond resolution, wait for the next one to start */
+    const Uint32 start = SDL_GetTicks();
+    Uint32       ticks;
+    while ((ticks = SDL_GetTicks()) == start)
+        std::this_thread::yield();
+
+    m_ticksOffset = Time::getTime<time_us>() - std::chrono::milliseconds(ticks);
+    L_DEBUG("SDL ticks offset: {}us", m_ticksOffset.count());
+}
+
+void InputSampler::run()
+{
+    constexpr int batchSize = 64;
+    SDL_Event     events[batchSize];
+
+    calibrate();
+
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        if (m_pumpEvents) SDL_PumpEvents();
+
+        for (;;)
+        {
+            /** only take what fits in the ring, the rest waits in SDL's queue */
+            int space = static_cast<int>(ringSize - m_ring.was_size());
+            if (space <= 0) break;
+
+            /** keyboard, mouse, joystick, controller and touch events, clipboard and drop
+             * events stay in SDL's queue for the game thread */
+            int count = SDL_PeepEvents(events,
+                                       space < batchSize ? space : batchSize,
+                                       SDL_GETEVENT,
+                                       SDL_KEYDOWN,
+                                       SDL_MULTIGESTURE);
+            if (count <= 0) break;
+
+            /** the time SDL queued the event, never later than now */
+            const time_us now = Time::getTime<time_us>();
+            for (int i = 0; i < count; i++)
+            {
+                time_us queued = m_ticksOffset + std::chrono::milliseconds(events[i].common.timestamp);
+                m_ring.try_push(TimedInputEvent{std::min(queued, now), events[i]});
+            }
+        }
+
+        std::this_thread::sleep_for(m_period);
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <core/input/inputManager.hpp>
+
+#if defined(CONFIG_CORE_INPUT_THREAD)
+
+#include <core/utils/queue.hpp>
+
+#include <atomic>
+#include <thread>
+
+/**
+ * @brief Drains SDL input events on a dedicated thread
+ *
+ * Events keep the time SDL queued them, converted from SDL_GetTicks to the
+ * engine clock, and are pushed into an spsc_ring consumed by
+ * InputManager::preUpdate. The time events waited in SDL's queue for the next
+ * poll is part of the measured latency. SDL keeps events in its own queue while
+ * the ring is full, so nothing is dropped. Only device events are taken,
+ * clipboard and drop events are left for the game thread.
+ */
+class InputSampler
+{
+public:
+    static constexpr std::size_t ringSize = 1024;
+
+private:
+    core::utils::spsc_ring<TimedInputEvent, ringSize> m_ring;
+    std::atomic<bool>                                 m_running{false};
+    std::thread                                       m_thread;
+    time_us                                           m_period;
+    bool                                              m_pumpEvents;
+    time_us                                           m_ticksOffset{0}; /** engine time at SDL tick 0 */
+
+    /** Measures m_ticksOffset at the start of an SDL tick */
+    void calibrate();
+    void run();
+
+protected:
+public:
+    /**
+     * @param period time between polls
+     * @param pumpEvents call SDL_PumpEvents from the sampling thread
+     */
+    InputSampler(time_us period, bool pumpEvents);
+    ~InputSampler();
+    InputSampler(InputSampler &o)             = delete;
+    InputSampler(InputSampler &&o)            = delete;
+    InputSampler &operator=(InputSampler &o)  = delete;
+    InputSampler &operator=(InputSampler &&o) = delete;
+
+    void start();
+    void stop();
+
+    /** @brief Pops the next sampled event, must only be called from one thread */
+    bool pop(TimedInputEvent &e) { return m_ring.try_pop(e); }
+};
+#else
+/** Input thread disabled, InputManager never creates a sampler */
+class InputSampler
+{
+};
+#endif
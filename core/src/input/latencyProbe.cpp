@@ -0,0 +1,104 @@
+#include "latencyProbe.hpp"
+
+#include <core/graphics/renderer.hpp>
+#include <core/utils/logging.hpp>
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <random>
+
+InputLatencyProbe::InputLatencyProbe(time_us interval) : m_interval(interval)
+{
+    for (auto &slot : m_injected)
+        slot.store(0, std::memory_order_relaxed);
+}
+
+InputLatencyProbe::~InputLatencyProbe() { stop(); }
+
+void InputLatencyProbe::start()
+{
+    L_TAG("InputLatencyProbe::start");
+    if (m_running.exchange(true)) return;
+
+    L_INFO("Starting input latency probe (interval: {}us)", m_interval.count());
+    m_thread = std::thread(&InputLatencyProbe::run, this);
+}
+
+void InputLatencyProbe::stop()
+{
+    if (!m_running.exchange(false)) return;
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void InputLatencyProbe::run()
+{
+    /** jitter the interval so injections don't lock to the frame rate */
+    std::mt19937                          rng(0x1a7e);
+    std::uniform_real_distribution<float> jitter(0.5f, 1.5f);
+    std::uint32_t                         sequence = 0;
+
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_for(time_us(static_cast<time_us::rep>(m_interval.count() * jitter(rng))));
+
+        if (++sequence == 0) ++sequence;
+        m_injected[sequence % slotCount].store(Time::getTime<time_us>().count(), std::memory_order_relaxed);
+
+        SDL_Event ev{};
+        ev.type                = SDL_KEYDOWN;
+        ev.key.timestamp       = SDL_GetTicks();
+        ev.key.state           = SDL_PRESSED;
+        ev.key.keysym.scancode = SDL_SCANCODE_UNKNOWN;
+        ev.key.keysym.sym      = SDLK_UNKNOWN;
+        ev.key.keysym.unused   = sequence;
+        /** SDL's queue lock orders the store above before the consumer reads it */
+        SDL_PushEvent(&ev);
+    }
+}
+
+void InputLatencyProbe::consume(const SDL_Event &ev)
+{
+    std::uint32_t sequence = ev.key.keysym.unused;
+    /** single producer and SDL's fifo, sequences arrive in order */
+    if (static_cast<std::int32_t>(sequence - m_lastSeen) <= 0) return;
+    m_lastSeen = sequence;
+    m_consumed.push_back(sequence);
+}
+
+void InputLatencyProbe::submitted(std::uint64_t frame)
+{
+    for (auto sequence : m_consumed) m_pending.emplace_back(frame, sequence);
+    m_consumed.clear();
+}
+
+void InputLatencyProbe::presented(const FramePresentation &presentation)
+{
+    const std::uint64_t presentedFrames = presentation.framesPresented();
+    while (!m_pending.empty() && m_pending.front().first < presentedFrames)
+    {
+        auto [frame, sequence] = m_pending.front();
+        m_pending.pop_front();
+        if (presentedFrames - frame > FramePresentation::history) continue;
+
+        m_samples.push_back(presentation.presentTime(frame).count()
+                            - m_injected[sequence % slotCount].load(std::memory_order_relaxed));
+    }
+}
+
+InputLatencyReport InputLatencyProbe::report() const
+{
+    InputLatencyReport report;
+    report.samples = m_samples.size();
+    if (m_samples.empty()) return report;
+
+    std::vector<std::int64_t> sorted(m_samples);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](std::size_t p) { return time_us(sorted[(sorted.size() - 1) * p / 100]); };
+
+    report.p50 = percentile(50);
+    report.p90 = percentile(90);
+    report.p99 = percentile(99);
+    report.max = time_us(sorted.back());
+    return report;
+}
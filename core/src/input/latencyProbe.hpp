@@ -0,0 +1,84 @@
+#pragma once
+
+#include <core/input/inputManager.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class FramePresentation; /** Forward declaration to the renderer's presentation counters */
+
+/**
+ * @brief Measures input-to-present latency with synthetic key events
+ *
+ * A helper thread pushes SDL_KEYDOWN events with SDL_SCANCODE_UNKNOWN and a
+ * non-zero sequence number in keysym.unused, which SDL never sets on real
+ * events. InputManager hands every such event to @ref consume the first time it
+ * sees it (late-latch or preUpdate), @ref submitted ties the consumed events to
+ * the number of the frame that was just handed to the renderer, and
+ * @ref presented turns them into samples once the renderer published that frame
+ * as presented, with the time of its buffer swap. With a render thread the swap
+ * happens frames after the submit, so the samples cover the whole pipeline.
+ * Probe events are never dispatched to listeners or the action map.
+ */
+class InputLatencyProbe
+{
+public:
+    /** Injection times are kept in a ring, sequences this far apart share a slot */
+    static constexpr std::size_t slotCount = 4096;
+
+private:
+    std::array<std::atomic<std::int64_t>, slotCount> m_injected; /** injection time (us) by sequence */
+    std::atomic<bool>                                m_running{false};
+    std::thread                                      m_thread;
+    time_us                                          m_interval;
+
+    /** main thread state */
+    std::uint32_t              m_lastSeen = 0;
+    std::vector<std::uint32_t>                          m_consumed; /** seen by the frame being built */
+    std::deque<std::pair<std::uint64_t, std::uint32_t>> m_pending;  /** (frame, sequence) submitted, not presented */
+    std::vector<std::int64_t>                           m_samples;  /** latency of presented events (us) */
+
+    void run();
+
+protected:
+public:
+    explicit InputLatencyProbe(time_us interval);
+    ~InputLatencyProbe();
+    InputLatencyProbe(InputLatencyProbe &o)             = delete;
+    InputLatencyProbe(InputLatencyProbe &&o)            = delete;
+    InputLatencyProbe &operator=(InputLatencyProbe &o)  = delete;
+    InputLatencyProbe &operator=(InputLatencyProbe &&o) = delete;
+
+    void start();
+    void stop();
+
+    /** @brief Checks if @p ev was injected by a probe */
+    static bool isProbeEvent(const SDL_Event &ev)
+    {
+        return ev.type == SDL_KEYDOWN && ev.key.keysym.scancode == SDL_SCANCODE_UNKNOWN && ev.key.keysym.unused != 0;
+    }
+
+    /**
+     * @brief Marks probe event @p ev as consumed by the frame being built.
+     * Events seen again after late-latch are ignored.
+     */
+    void consume(const SDL_Event &ev);
+
+    /** @brief Ties the events consumed since the last call to frame number @p frame */
+    void submitted(std::uint64_t frame);
+
+    /**
+     * @brief Records the latency of the submitted events whose frame was presented.
+     * Frames presented longer than FramePresentation::history frames ago lost
+     * their present time, their events are dropped.
+     */
+    void presented(const FramePresentation &presentation);
+
+    /** @brief Percentiles of the samples recorded so far */
+    InputLatencyReport report() const;
+};
@@ -0,0 +1,73 @@
+#include <ui/label.hpp>
+
+namespace core::ui
+{
+    Label::Label(TextLayout &textLayout, TextBatch &textBatch)
+        : m_textLayout(textLayout),
+          m_textBatch(textBatch),
+          m_handle(textBatch.add())
+    {
+    }
+
+    Label::~Label() { m_textBatch.remove(m_handle); }
+
+    Label &Label::setText(const std::string &text)
+    {
+        if (m_text != text)
+        {
+            m_text  = text;
+            m_shape = true;
+        }
+        return *this;
+    }
+
+    Label &Label::setFont(GlyphCache::FontID font)
+    {
+        m_shape |= m_font != font;
+        m_font = font;
+        return *this;
+    }
+
+    Label &Label::setSize(std::uint32_t size)
+    {
+        m_shape |= m_size != size;
+        m_size = size;
+        return *this;
+    }
+
+    Label &Label::setWrapWidth(float width)
+    {
+        m_shape |= m_wrapWidth != width;
+        m_wrapWidth = width;
+        return *this;
+    }
+
+    Label &Label::setColor(const glm::vec4 &color)
+    {
+        m_placed |= m_color != color;
+        m_color = color;
+        return *this;
+    }
+
+    Label &Label::setModel(const glm::mat4 &model)
+    {
+        m_placed |= m_model != model;
+        m_model = model;
+        return *this;
+    }
+
+    void Label::update()
+    {
+        /** evicted glyphs may have been replaced on their page, the old quads would show them */
+        if (m_layout && !m_textLayout.valid(*m_layout)) m_shape = true;
+        if (!m_shape && !m_placed) return;
+
+        if (m_shape)
+        {
+            m_layout = m_text.empty() ? nullptr : m_textLayout.layout(m_text, m_font, m_size, m_wrapWidth);
+            m_shape  = false;
+        }
+        m_textBatch.set(m_handle, m_layout, m_model, m_color);
+        m_placed = false;
+    }
+} // namespace core::ui
@@ -1,15 +1,23 @@
 #include <ui/text/fontLoader.hpp>
 #include <ui/text/fontLoader_p.hpp>
 #include <assets/font_p.hpp>
+#include <assets/atlasPacker.hpp>
 #include <utils/logging.hpp>
+#include <utils/jobs.hpp>
+#include <utils/profiler.hpp>
 
 #include <SDL_image.h>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <vector>
 
 namespace core::ui
 {
+    /** generateFont bakes all glyphs in one atlas, larger sets go through the GlyphCache */
+    static constexpr std::uint32_t maxAtlasSize = 4096;
+
     static void setGrayscalePalette(SDL_Surface *surface)
     {
         L_TAG("setGrayscalePalette");
@@ -24,19 +32,11 @@ namespace core::ui
         SDL_SetPaletteColors(surface->format->palette, colors, 0, paletteSize);
     }
 
-    static int createAtlasSurface(const std::unique_ptr<core::ui::FontLoader::Internal> &fontLoader)
+    static int createAtlasSurface(const std::unique_ptr<core::ui::FontLoader::Internal> &fontLoader,
+                                  std::size_t                                            atlasWidth,
+                                  std::size_t                                            atlasHeight)
     {
         L_TAG("FontLoader::createAtlasSurface");
-        std::size_t atlasWidth  = 1;
-        std::size_t atlasHeight = 1;
-
-        while (atlasHeight * atlasWidth < fontLoader->m_pixelCount)
-        {
-            if (atlasWidth == atlasHeight)
-                atlasWidth <<= 1;
-            else
-                atlasHeight <<= 1;
-        }
 
         L_TRACE("Allocating atlas surface ({}x{})", atlasWidth, atlasHeight);
         SDL_Surface *textureAtlas =
@@ -56,52 +56,118 @@ namespace core::ui
         return EXIT_SUCCESS;
     }
 
+    /** Renders the glyphs of code points [begin, end) with @p face into their slot of @p glyphs */
+    static int renderGlyphs(FT_Face                                   face,
+                            FT_Render_Mode                            renderMode,
+                            std::size_t                               begin,
+                            std::size_t                               end,
+                            std::size_t                               startIndex,
+                            std::vector<core::ui::FontLoader::Glyph> &glyphs)
+    {
+        L_TAG("FontLoader::renderGlyphs");
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::size_t                  glyphIndex = FT_Get_Char_Index(face, i);
+            core::ui::FontLoader::Glyph &glyphEntry = glyphs.at(i - startIndex);
+
+            if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT))
+            {
+                L_TRACE("Could not load glyph: {}", glyphIndex);
+                return EXIT_FAILURE;
+            }
+
+            auto &glyph = face->glyph;
+            glyphEntry.charCode = i;
+            glyphEntry.advance  = glyph->advance.x >> 6;
+
+            // Outlines without contours (spaces, controls) have nothing to render
+            if (glyph->format == FT_GLYPH_FORMAT_OUTLINE && glyph->outline.n_contours == 0) continue;
+
+            if (FT_Render_Glyph(glyph, renderMode))
+            {
+                L_TRACE("Could not render glyph: {}", glyphIndex);
+                return EXIT_FAILURE;
+            }
+
+            auto &bitmap = glyph->bitmap;
+            glyphEntry.size    = glm::ivec2(bitmap.width, bitmap.rows);
+            glyphEntry.bearing = glm::ivec2(glyph->bitmap_left, glyph->bitmap_top);
+            glyphEntry.pitch   = bitmap.pitch;
+            glyphEntry.bitmap =
+                std::vector<unsigned char>(bitmap.buffer,
+                                           bitmap.buffer + (bitmap.rows * bitmap.pitch));
+        }
+        return EXIT_SUCCESS;
+    }
+
+    static FT_Error openFace(FT_Library library, const AssetSpan &file, FT_Face *face)
+    {
+        return FT_New_Memory_Face(library,
+                                  reinterpret_cast<const FT_Byte *>(file.data()),
+                                  static_cast<FT_Long>(file.size()),
+                                  0,
+                                  face);
+    }
+
     static int buildGlyphs(const std::unique_ptr<core::ui::FontLoader::Internal> &fontLoader,
                            FT_Render_Mode                                         renderMode)
     {
         L_TAG("FontLoader::buildGlyphs");
-        // TODO: support unicode characters
+        PROFILER_BLOCK("FontLoader::buildGlyphs");
         L_ASSERT(fontLoader->m_face != nullptr, "No active face");
 
-        auto &face       = fontLoader->m_face;
         auto  startIndex = fontLoader->m_startIndex;
         auto  endIndex   = fontLoader->m_endIndex;
         auto &glyphs     = fontLoader->m_glyphs;
 
-        // Reserve items for glpyh vector
+        // Each glyph has its own slot, the result doesn't depend on which worker rendered it
         glyphs = std::vector<core::ui::FontLoader::Glyph>(endIndex - startIndex);
 
-        std::size_t destX      = 0;
-        std::size_t destY      = 0;
-        std::size_t pixelCount = 0;
+        // Workers claim batches of code points, batches keep the claims cheap
+        constexpr std::size_t batchSize = 16;
+        auto                 &pool      = core::utils::JobPool::getInstance();
+        const std::size_t     batches   = (endIndex - startIndex + batchSize - 1) / batchSize;
+        const std::size_t     slots     = fontLoader->m_parallel ? std::min(pool.size() + 1, batches) : 1;
 
-        for (std::size_t i = startIndex; i < endIndex; ++i)
-        {
-            std::size_t                  glyphIndex = FT_Get_Char_Index(face, i);
-            core::ui::FontLoader::Glyph &glyphEntry = glyphs.at(i - startIndex);
+        std::atomic<std::size_t> next{startIndex};
+        std::atomic<bool>        failed{false};
+        auto renderSlot = [&](std::size_t slot) {
+            FT_Library library = nullptr;
+            FT_Face    face    = fontLoader->m_face;
 
-            if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT)
-                || FT_Render_Glyph(face->glyph, renderMode))
+            // FreeType faces aren't thread-safe, other slots open their own
+            if (slot != 0)
             {
-                L_TRACE("Could not render glyph: {}", glyphIndex);
-                return EXIT_FAILURE;
+                face = nullptr;
+                if (FT_Init_FreeType(&library) || openFace(library, fontLoader->m_file, &face)
+                    || (fontLoader->m_applySize && fontLoader->m_applySize(face)))
+                    failed = true;
             }
 
-            auto &glyph  = face->glyph;
-            auto &bitmap = face->glyph->bitmap;
+            std::size_t begin;
+            while (!failed && (begin = next.fetch_add(batchSize)) < endIndex)
+            {
+                std::size_t end = std::min(begin + batchSize, endIndex);
+                if (renderGlyphs(face, renderMode, begin, end, startIndex, glyphs)) failed = true;
+            }
 
-            glyphEntry.charCode = i;
-            glyphEntry.size     = glm::ivec2(bitmap.width, bitmap.rows);
-            glyphEntry.bearing  = glm::ivec2(glyph->bitmap_left, glyph->bitmap_top);
-            glyphEntry.advance  = glyph->advance.x >> 6;
-            glyphEntry.pitch    = bitmap.pitch;
-            glyphEntry.bitmap =
-                std::vector<unsigned char>(bitmap.buffer,
-                                           bitmap.buffer + (bitmap.rows * bitmap.pitch));
+            if (slot != 0)
+            {
+                if (face) FT_Done_Face(face);
+                if (library) FT_Done_FreeType(library);
+            }
+        };
 
-            pixelCount += bitmap.pitch * bitmap.rows;
-        }
-        L_TRACE("Built {} glyphs for total of {} pixels", glyphs.size(), pixelCount);
+        if (slots > 1)
+            pool.parallelFor(slots, renderSlot);
+        else
+            renderSlot(0);
+        if (failed) return EXIT_FAILURE;
+
+        std::size_t pixelCount = 0;
+        for (const auto &glyph : glyphs) pixelCount += glyph.bitmap.size();
+        L_TRACE("Built {} glyphs for total of {} pixels on {} threads", glyphs.size(), pixelCount, slots);
 
         fontLoader->m_pixelCount = pixelCount;
         return EXIT_SUCCESS;
@@ -111,51 +177,54 @@ namespace core::ui
     {
         L_TAG("FontLoader::packGlyphs");
 
-        // Create surface
-        L_ASSERT(createAtlasSurface(fontLoader) == EXIT_SUCCESS,
-                 "Could not create surface for atlas");
+        auto &glyphs = fontLoader->m_glyphs;
 
-        auto &glyphs       = fontLoader->m_glyphs;
-        auto &atlasSurface = fontLoader->m_atlasSurface;
+        // Place glyphs with pixels, the atlas is sized to fit them
+        core::assets::AtlasPacker::Settings settings;
+        settings.maxPageSize = maxAtlasSize;
+        settings.padding     = 1;
+        core::assets::AtlasPacker packer(settings);
 
-        std::size_t destX     = 0;
-        std::size_t destY     = 0;
-        std::size_t maxHeight = 0;
+        std::vector<std::size_t>                     packed;
+        std::vector<core::assets::AtlasPacker::Rect> sizes;
+        for (std::size_t i = 0; i < glyphs.size(); ++i)
+        {
+            if (glyphs[i].size.x <= 0 || glyphs[i].size.y <= 0) continue;
+            packed.push_back(i);
+            sizes.push_back({0,
+                             0,
+                             static_cast<std::uint32_t>(glyphs[i].size.x),
+                             static_cast<std::uint32_t>(glyphs[i].size.y)});
+        }
+        auto placements = sizes.empty() ? std::vector<core::assets::AtlasPacker::Placement>() : packer.pack(sizes);
+        if (packer.pages().size() > 1)
+        {
+            L_TRACE("{} glyphs exceed a {}x{} atlas, use the GlyphCache", glyphs.size(), maxAtlasSize, maxAtlasSize);
+            return EXIT_FAILURE;
+        }
 
-        L_TRACE("Packing {} glyphs to surface ({}x{})",
-                glyphs.size(),
-                atlasSurface->w,
-                atlasSurface->h);
+        std::size_t atlasWidth  = packer.pages().empty() ? 1 : packer.pages()[0].width;
+        std::size_t atlasHeight = packer.pages().empty() ? 1 : packer.pages()[0].height;
+        if (createAtlasSurface(fontLoader, atlasWidth, atlasHeight) != EXIT_SUCCESS) return EXIT_FAILURE;
+        auto &atlasSurface = fontLoader->m_atlasSurface;
+
+        L_TRACE("Packing {} glyphs to surface ({}x{})", glyphs.size(), atlasSurface->w, atlasSurface->h);
         if (SDL_MUSTLOCK(atlasSurface)) SDL_LockSurface(atlasSurface);
 
         unsigned char *pixels = static_cast<unsigned char *>(atlasSurface->pixels);
-        for (auto &glyph : glyphs)
+        for (std::size_t i = 0; i < packed.size(); ++i)
         {
-            if (destX + glyph.size.x > atlasSurface->w)
-            {
-                destX = 0;
-                destY += maxHeight;
-                maxHeight = 0;
-            }
-
-            if (destY + glyph.size.y > atlasSurface->h)
-            {
-                // TODO: recreate bigger atlas if this happens
-                L_TRACE("glyph {} exceeds atlasHeight", glyph.charCode);
-                return EXIT_FAILURE;
-            }
+            auto       &glyph = glyphs[packed[i]];
+            const auto &rect  = placements[i].rect;
+            glyph.position    = glm::ivec2(rect.x, rect.y);
 
-            for (std::size_t row = 0; row < glyph.size.y; ++row)
+            for (std::size_t row = 0; row < rect.h; ++row)
             {
                 // This copy expects surface to be index8 and glyph bitmap to be single channel - greyscale
-                std::size_t y = destY + row;
-                memcpy(&pixels[((destY + row) * atlasSurface->w) + destX],
+                memcpy(&pixels[((rect.y + row) * atlasSurface->pitch) + rect.x],
                        &glyph.bitmap[(row * glyph.pitch)],
-                       glyph.size.x);
+                       rect.w);
             }
-
-            destX += glyph.size.x;
-            maxHeight = std::max(maxHeight, static_cast<std::size_t>(glyph.size.y));
         }
 
         if (SDL_MUSTLOCK(atlasSurface)) SDL_UnlockSurface(atlasSurface);
@@ -172,7 +241,7 @@ namespace core::ui
         fontInternal->m_glyphs.reserve(fontLoader->m_glyphs.size());
         std::transform(fontLoader->m_glyphs.begin(),
                        fontLoader->m_glyphs.end(),
-                       fontInternal->m_glyphs.begin(),
+                       std::back_inserter(fontInternal->m_glyphs),
                        [](const auto &in) {
                            return core::assets::Font::Glyph{.charCode = in.charCode,
                                                             .position = in.position,
@@ -223,7 +292,8 @@ namespace core::ui
         FT_Face  face;
         auto    &library = this->m_internal->m_library;
 
-        err = FT_New_Face(library, font.c_str(), 0, &face);
+        AssetSpan file = AssetInventory::getInstance().openAsset(font);
+        err            = openFace(library, file, &face);
         if (err != 0)
         {
             L_THROW_RUNTIME("Could not open font face: {}", err);
@@ -235,6 +305,7 @@ namespace core::ui
             SDL_FreeSurface(this->m_internal->m_atlasSurface);
 
         this->m_internal->m_name         = font;
+        this->m_internal->m_file         = std::move(file);
         this->m_internal->m_face         = face;
         this->m_internal->m_startIndex   = startIndex;
         this->m_internal->m_endIndex     = endIndex;
@@ -253,7 +324,10 @@ namespace core::ui
 
         auto &face = this->m_internal->m_face;
 
-        FT_Error err = FT_Set_Pixel_Sizes(face, width, height);
+        this->m_internal->m_applySize = [width, height](FT_Face target) {
+            return FT_Set_Pixel_Sizes(target, width, height);
+        };
+        FT_Error err = this->m_internal->m_applySize(face);
         if (err != 0)
         {
             L_THROW_RUNTIME("Could not set pixel size");
@@ -271,8 +345,11 @@ namespace core::ui
         L_TAG("FontLoader::setCharSize");
         L_ASSERT(this->m_internal->m_face != nullptr, "No active face");
 
-        auto    &face = this->m_internal->m_face;
-        FT_Error err  = FT_Set_Char_Size(face, charWidth, charHeight, horizontalRes, verticalRes);
+        auto &face = this->m_internal->m_face;
+        this->m_internal->m_applySize = [=](FT_Face target) {
+            return FT_Set_Char_Size(target, charWidth, charHeight, horizontalRes, verticalRes);
+        };
+        FT_Error err = this->m_internal->m_applySize(face);
         if (err != 0)
         {
             L_THROW_RUNTIME("Could not set char size");
@@ -281,6 +358,21 @@ namespace core::ui
         return *this;
     }
 
+    FontLoader &FontLoader::setParallel(bool enable)
+    {
+        this->m_internal->m_parallel = enable;
+        return *this;
+    }
+
+    const std::vector<FontLoader::Glyph> &FontLoader::generateGlyphs()
+    {
+        L_TAG("FontLoader::generateGlyphs");
+
+        if (buildGlyphs(this->m_internal, FT_RENDER_MODE_SDF))
+            L_THROW_RUNTIME("Could not build font glyphs");
+        return this->m_internal->m_glyphs;
+    }
+
     core::assets::Font FontLoader::generateFont()
     {
         // TODO: support unicode characters
@@ -9,12 +9,14 @@
  */
 
 #include <ui/text/fontLoader.hpp>
+#include <assets/asset-inventory.hpp>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 #include <SDL_surface.h>
 
+#include <functional>
 #include <string>
 
 namespace core::ui
@@ -22,15 +24,20 @@ namespace core::ui
     struct FontLoader::Internal
     {
         std::string        m_name;
-        std::size_t        m_startIndex;
-        std::size_t        m_endIndex;
-        FT_Library         m_library;
-        FT_Face            m_face;
+        AssetSpan          m_file; /** faces read the font file in place */
+        std::size_t        m_startIndex = 0;
+        std::size_t        m_endIndex   = 0;
+        FT_Library         m_library    = nullptr;
+        FT_Face            m_face       = nullptr;
+        bool               m_parallel   = true;
+
+        /** Sets the size requested by setPixelSize/setCharSize, reapplied on worker faces */
+        std::function<FT_Error(FT_Face)> m_applySize;
 
         // Loaded data
         std::vector<Glyph> m_glyphs;
-        SDL_Surface       *m_atlasSurface;
-        std::size_t        m_pixelCount;
+        SDL_Surface       *m_atlasSurface = nullptr;
+        std::size_t        m_pixelCount   = 0;
     };
 } // namespace core::ui
 
@@ -0,0 +1,464 @@
+#include <ui/text/glyphCache.hpp>
+#include <assets/asset-inventory.hpp>
+#include <utils/logging.hpp>
+#include <utils/profiler.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core::ui
+{
+    struct GlyphCache::Internal
+    {
+        struct Font
+        {
+            AssetName     name;
+            AssetSpan     file; /** faces read the font file in place */
+            FT_Face       face = nullptr;
+            std::uint32_t size = 0; /** pixel size currently set on the face */
+        };
+
+        struct Slot
+        {
+            std::uint32_t x = 0, w = 0;
+        };
+
+        /** Row of glyphs of similar height, freed slots are reused by later glyphs */
+        struct Shelf
+        {
+            std::uint32_t     y      = 0;
+            std::uint32_t     height = 0;
+            std::uint32_t     cursor = 0; /** start of the space never allocated */
+            std::size_t       glyphs = 0;
+            std::vector<Slot> free;
+        };
+
+        struct Page
+        {
+            AssetID                   texture = -1;
+            std::vector<std::uint8_t> pixels; /** RGBA8, rows from top to bottom */
+            std::vector<Shelf>        shelves;
+            std::uint32_t             top         = 0; /** start of the space without shelves */
+            std::size_t               glyphs      = 0;
+            std::uint32_t             dirtyTop    = 0; /** rows [dirtyTop, dirtyBottom) changed since the upload */
+            std::uint32_t             dirtyBottom = 0;
+
+            bool dirty() const noexcept { return dirtyTop < dirtyBottom; }
+            /** marks the rows of @p shelf for upload */
+            void touch(const Shelf &shelf)
+            {
+                dirtyTop    = dirty() ? std::min(dirtyTop, shelf.y) : shelf.y;
+                dirtyBottom = std::max(dirtyBottom, shelf.y + shelf.height);
+            }
+        };
+
+        struct Entry
+        {
+            Glyph                              glyph;
+            std::size_t                        shelf = 0;
+            Slot                               slot;
+            std::uint64_t                      frame = 0;
+            std::list<std::uint64_t>::iterator lru;
+        };
+
+        AssetManager &assetManager;
+        Settings      settings;
+        std::string   name; /** prefix of the page texture names, unique per cache */
+        std::size_t   maxPages;
+        FT_Library    library = nullptr;
+
+        std::vector<Font>                          fonts;
+        std::vector<Page>                          pages;
+        std::unordered_map<std::uint64_t, Entry>   entries;
+        std::list<std::uint64_t>                   lru; /** most recently used first */
+        std::uint64_t                              frame      = 0;
+        std::uint64_t                              generation = 0;
+        Stats                                      stats;
+
+        Internal(AssetManager &assetManager, const Settings &settings)
+            : assetManager(assetManager),
+              settings(settings)
+        {
+            L_TAG("GlyphCache::Internal");
+
+            static std::atomic<unsigned int> cacheCount{0};
+            name     = fmt::format("glyphCache{}", cacheCount++);
+            maxPages = std::max<std::size_t>(1, settings.memoryBudget / pageBytes());
+
+            if (FT_Init_FreeType(&library)) L_THROW_RUNTIME("Could not initialize FT Library");
+            L_TRACE("Internal resources initialized ({})", static_cast<void *>(this));
+        }
+
+        ~Internal()
+        {
+            L_TAG("GlyphCache::~Internal");
+            for (auto &font : fonts) FT_Done_Face(font.face);
+            if (library) FT_Done_FreeType(library);
+            L_TRACE("Internal resources freed ({})", static_cast<void *>(this));
+        }
+
+        std::size_t pageBytes() const { return std::size_t(settings.pageSize) * settings.pageSize * 4; }
+
+        static std::uint64_t key(FontID font, std::uint32_t size, char32_t codepoint)
+        {
+            return (std::uint64_t(font) << 48) | (std::uint64_t(size & 0xffff) << 32) | codepoint;
+        }
+
+        FT_Face face(FontID font, std::uint32_t size)
+        {
+            L_TAG("GlyphCache::face");
+            if (font >= fonts.size()) L_THROW_RUNTIME("Invalid font: {}", font);
+
+            Font &f = fonts[font];
+            if (f.size != size)
+            {
+                if (FT_Set_Pixel_Sizes(f.face, 0, size)) L_THROW_RUNTIME("Could not set pixel size {}", size);
+                f.size = size;
+            }
+            return f.face;
+        }
+
+        void addPage()
+        {
+            L_TAG("GlyphCache::addPage");
+
+            Page page;
+            page.pixels.resize(pageBytes(), 0);
+            page.texture = assetManager.loadTexture(core::assets::Texture(fmt::format("{}/page{}", name, pages.size()),
+                                                                          settings.pageSize,
+                                                                          settings.pageSize,
+                                                                          page.pixels.data()));
+            pages.push_back(std::move(page));
+            stats.pages = pages.size();
+            stats.bytes = pages.size() * pageBytes();
+            L_DEBUG("Glyph page {} added ({} bytes)", pages.size() - 1, pageBytes());
+        }
+
+        /** Shelf heights are rounded up so glyphs of close sizes share them */
+        static std::uint32_t shelfHeight(std::uint32_t h) { return (h + 3) & ~std::uint32_t(3); }
+
+        bool allocate(Page &page, std::uint32_t w, std::uint32_t h, Entry &entry)
+        {
+            const std::uint32_t pageSize = settings.pageSize;
+
+            /** the tightest shelf with room, a freed slot or its unused tail */
+            Shelf *best = nullptr;
+            for (Shelf &shelf : page.shelves)
+            {
+                if (shelf.height < h || shelf.height > shelfHeight(h) + h / 4) continue;
+                bool room = shelf.cursor + w <= pageSize
+                         || std::any_of(shelf.free.begin(), shelf.free.end(), [&](const Slot &s) { return s.w >= w; });
+                if (room && (!best || shelf.height < best->height)) best = &shelf;
+            }
+            if (!best)
+            {
+                if (page.top + shelfHeight(h) > pageSize) return false;
+                page.shelves.push_back(Shelf{page.top, shelfHeight(h), 0, 0, {}});
+                page.top += shelfHeight(h);
+                best = &page.shelves.back();
+            }
+
+            Slot slot{best->cursor, w};
+            auto freeSlot = std::find_if(best->free.begin(), best->free.end(), [&](const Slot &s) { return s.w >= w; });
+            if (freeSlot != best->free.end())
+            {
+                slot.x = freeSlot->x;
+                if (freeSlot->w > w)
+                    *freeSlot = Slot{freeSlot->x + w, freeSlot->w - w};
+                else
+                    best->free.erase(freeSlot);
+            }
+            else
+                best->cursor += w;
+
+            best->glyphs++;
+            page.glyphs++;
+            entry.shelf = static_cast<std::size_t>(best - page.shelves.data());
+            entry.slot  = slot;
+            return true;
+        }
+
+        void release(const Entry &entry)
+        {
+            Page  &page  = pages[entry.glyph.page];
+            Shelf &shelf = page.shelves[entry.shelf];
+
+            shelf.free.push_back(entry.slot);
+            page.glyphs--;
+            if (--shelf.glyphs == 0)
+            {
+                shelf.cursor = 0;
+                shelf.free.clear();
+            }
+            else
+            {
+                /** give slots at the end back to the tail */
+                for (auto it = shelf.free.begin(); it != shelf.free.end();)
+                {
+                    if (it->x + it->w != shelf.cursor)
+                    {
+                        ++it;
+                        continue;
+                    }
+                    shelf.cursor = it->x;
+                    shelf.free.erase(it);
+                    it = shelf.free.begin();
+                }
+            }
+
+            /** empty shelves at the top give their rows back to the page */
+            while (!page.shelves.empty() && page.shelves.back().glyphs == 0)
+            {
+                page.top = page.shelves.back().y;
+                page.shelves.pop_back();
+            }
+        }
+
+        /** Evicts the least recently used glyph, false if all glyphs are used this frame */
+        bool evict()
+        {
+            if (lru.empty()) return false;
+            auto it = entries.find(lru.back());
+            if (it->second.frame == frame) return false;
+
+            if (it->second.glyph.texture >= 0)
+            {
+                release(it->second);
+                generation++;
+            }
+            lru.pop_back();
+            entries.erase(it);
+            stats.evictions++;
+            stats.glyphs = entries.size();
+            return true;
+        }
+
+        std::size_t place(std::uint32_t w, std::uint32_t h, Entry &entry)
+        {
+            L_TAG("GlyphCache::place");
+            if (w > settings.pageSize || h > settings.pageSize)
+                L_THROW_RUNTIME("Glyph of {}x{} doesn't fit in {} pages", w, h, settings.pageSize);
+
+            while (true)
+            {
+                for (std::size_t page = 0; page < pages.size(); page++)
+                    if (allocate(pages[page], w, h, entry)) return page;
+
+                if (pages.size() < maxPages || !evict())
+                {
+                    if (pages.size() >= maxPages)
+                        L_WARN("Glyphs used this frame exceed the budget of {} bytes", settings.memoryBudget);
+                    addPage();
+                    allocate(pages.back(), w, h, entry);
+                    return pages.size() - 1;
+                }
+            }
+        }
+
+        Glyph rasterize(FontID font, std::uint32_t size, char32_t codepoint, Entry &entry)
+        {
+            L_TAG("GlyphCache::rasterize");
+            PROFILER_BLOCK("GlyphCache::rasterize");
+
+            FT_Face face = this->face(font, size);
+            if (FT_Load_Char(face, codepoint, FT_LOAD_DEFAULT))
+                L_THROW_RUNTIME("Could not load glyph {:#x} of {}",
+                                static_cast<std::uint32_t>(codepoint),
+                                fonts[font].name);
+
+            Glyph glyph;
+            glyph.advance = face->glyph->advance.x / 64.0f;
+            if (FT_Render_Glyph(face->glyph, settings.sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL))
+            {
+                /** outlines without contours like spaces have nothing to render */
+                L_TRACE("Glyph {:#x} has no bitmap", static_cast<std::uint32_t>(codepoint));
+                return glyph;
+            }
+
+            const FT_Bitmap &bitmap = face->glyph->bitmap;
+            glyph.size              = glm::ivec2(bitmap.width, bitmap.rows);
+            glyph.bearing           = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+            if (bitmap.width == 0 || bitmap.rows == 0) return glyph;
+
+            const std::uint32_t padding = settings.padding;
+            const std::uint32_t w       = bitmap.width + 2 * padding;
+            const std::uint32_t h       = bitmap.rows + 2 * padding;
+            const std::size_t   index   = place(w, h, entry);
+            Page               &page    = pages[index];
+            const std::uint32_t x       = entry.slot.x;
+            const std::uint32_t y       = page.shelves[entry.shelf].y;
+
+            /** clears the padding too, the slot may hold an evicted glyph */
+            const std::size_t stride = std::size_t(settings.pageSize) * 4;
+            for (std::uint32_t row = 0; row < h; row++)
+            {
+                std::uint8_t *target = page.pixels.data() + (y + row) * stride + std::size_t(x) * 4;
+                std::memset(target, 0, std::size_t(w) * 4);
+                if (row < padding || row >= padding + bitmap.rows) continue;
+
+                const unsigned char *source = bitmap.buffer + std::ptrdiff_t(row - padding) * bitmap.pitch;
+                target += std::size_t(padding) * 4;
+                for (std::uint32_t column = 0; column < bitmap.width; column++, target += 4)
+                {
+                    target[0] = target[1] = target[2] = 0xff;
+                    target[3]                         = source[column];
+                }
+            }
+            page.touch(page.shelves[entry.shelf]);
+
+            /** pages are flipped on upload, v grows from the bottom row */
+            const float pageSize = static_cast<float>(settings.pageSize);
+            glyph.texture        = page.texture;
+            glyph.page           = index;
+            glyph.uvRect         = glm::vec4((x + padding) / pageSize,
+                                     1.0f - (y + padding + bitmap.rows) / pageSize,
+                                     (x + padding + bitmap.width) / pageSize,
+                                     1.0f - (y + padding) / pageSize);
+            return glyph;
+        }
+    };
+
+    GlyphCache::GlyphCache(AssetManager &assetManager) : GlyphCache(assetManager, Settings()) {}
+    GlyphCache::GlyphCache(AssetManager &assetManager, const Settings &settings)
+        : m_internal(std::make_unique<Internal>(assetManager, settings))
+    {
+    }
+    GlyphCache::~GlyphCache()                            = default;
+    GlyphCache::GlyphCache(GlyphCache &&o)            = default;
+    GlyphCache &GlyphCache::operator=(GlyphCache &&o) = default;
+
+    GlyphCache::FontID GlyphCache::loadFont(const AssetName &name)
+    {
+        L_TAG("GlyphCache::loadFont");
+        auto &fonts = m_internal->fonts;
+
+        for (std::size_t i = 0; i < fonts.size(); i++)
+            if (fonts[i].name == name) return static_cast<FontID>(i);
+
+        const AssetPaths &assetPaths = AssetInventory::getInstance().lookupAssets(AssetType::Fonts, name);
+        L_ASSERT(assetPaths.size() == 1, "Found multiple paths for {}", name);
+
+        return loadFont(name, AssetInventory::getInstance().openAsset(assetPaths.at(0)));
+    }
+
+    GlyphCache::FontID GlyphCache::loadFont(const AssetName &name, AssetSpan file)
+    {
+        L_TAG("GlyphCache::loadFont");
+        auto &fonts = m_internal->fonts;
+
+        for (std::size_t i = 0; i < fonts.size(); i++)
+            if (fonts[i].name == name) return static_cast<FontID>(i);
+
+        FT_Face face;
+        if (FT_New_Memory_Face(m_internal->library,
+                               reinterpret_cast<const FT_Byte *>(file.data()),
+                               static_cast<FT_Long>(file.size()),
+                               0,
+                               &face))
+            L_THROW_RUNTIME("Could not open font face: {}", name);
+        if (FT_Select_Charmap(face, FT_ENCODING_UNICODE)) L_DEBUG("Font {} has no unicode charmap", name);
+
+        fonts.push_back(Internal::Font{name, std::move(file), face, 0});
+        L_DEBUG("Font {} opened as {}", name, fonts.size() - 1);
+        return static_cast<FontID>(fonts.size() - 1);
+    }
+
+    GlyphCache::Glyph GlyphCache::get(FontID font, std::uint32_t size, char32_t codepoint)
+    {
+        auto               &internal = *m_internal;
+        const std::uint64_t key      = Internal::key(font, size, codepoint);
+
+        auto it = internal.entries.find(key);
+        if (it != internal.entries.end())
+        {
+            internal.stats.hits++;
+            it->second.frame = internal.frame;
+            internal.lru.splice(internal.lru.begin(), internal.lru, it->second.lru);
+            return it->second.glyph;
+        }
+
+        Internal::Entry entry;
+        entry.glyph = internal.rasterize(font, size, codepoint, entry);
+        entry.frame = internal.frame;
+        internal.lru.push_front(key);
+        entry.lru = internal.lru.begin();
+        internal.entries.emplace(key, entry);
+
+        internal.stats.misses++;
+        internal.stats.glyphs = internal.entries.size();
+        return entry.glyph;
+    }
+
+    float GlyphCache::kerning(FontID font, std::uint32_t size, char32_t left, char32_t right)
+    {
+        FT_Face face = m_internal->face(font, size);
+        if (!FT_HAS_KERNING(face)) return 0.0f;
+
+        FT_Vector delta;
+        FT_UInt leftIndex  = FT_Get_Char_Index(face, left);
+        FT_UInt rightIndex = FT_Get_Char_Index(face, right);
+        if (FT_Get_Kerning(face, leftIndex, rightIndex, FT_KERNING_DEFAULT, &delta)) return 0.0f;
+        return delta.x / 64.0f;
+    }
+
+    float GlyphCache::lineHeight(FontID font, std::uint32_t size)
+    {
+        return m_internal->face(font, size)->size->metrics.height / 64.0f;
+    }
+
+    void GlyphCache::update()
+    {
+        L_TAG("GlyphCache::update");
+        PROFILER_BLOCK("GlyphCache::update");
+        auto &internal = *m_internal;
+
+        for (std::size_t i = 0; i < internal.pages.size(); i++)
+        {
+            auto &page = internal.pages[i];
+            if (!page.dirty()) continue;
+
+            /** only the rows of the shelves written since the last upload */
+            const std::size_t   stride = std::size_t(internal.settings.pageSize) * 4;
+            const std::uint32_t rows   = page.dirtyBottom - page.dirtyTop;
+            internal.assetManager.updateTextureRegion(page.texture,
+                                                      core::assets::Texture(fmt::format("{}/page{}", internal.name, i),
+                                                                            internal.settings.pageSize,
+                                                                            rows,
+                                                                            page.pixels.data() + page.dirtyTop * stride),
+                                                      0,
+                                                      page.dirtyTop);
+            page.dirtyTop = page.dirtyBottom = 0;
+            internal.stats.uploads++;
+            internal.stats.uploadBytes += rows * stride;
+        }
+        internal.frame++;
+    }
+
+    void GlyphCache::clear()
+    {
+        auto &internal = *m_internal;
+        internal.entries.clear();
+        internal.lru.clear();
+        for (auto &page : internal.pages)
+        {
+            page.shelves.clear();
+            page.top    = 0;
+            page.glyphs = 0;
+        }
+        internal.stats.glyphs = 0;
+        internal.generation++;
+    }
+
+    std::uint64_t GlyphCache::generation() const noexcept { return m_internal->generation; }
+
+    const GlyphCache::Stats    &GlyphCache::stats() const noexcept { return m_internal->stats; }
+    const GlyphCache::Settings &GlyphCache::settings() const noexcept { return m_internal->settings; }
+} // namespace core::ui
@@ -0,0 +1,126 @@
+#include <ui/text/textBatch.hpp>
+#include <utils/logging.hpp>
+#include <utils/profiler.hpp>
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+namespace core::ui
+{
+    /** Versions are shared by all batches so renderers can tell meshes apart by version alone */
+    static std::uint64_t nextVersion()
+    {
+        static std::atomic<std::uint64_t> version{1};
+        return version++;
+    }
+
+    TextBatch::TextBatch()  = default;
+    TextBatch::~TextBatch() = default;
+
+    TextBatch::Handle TextBatch::add()
+    {
+        Handle handle;
+        if (!m_free.empty())
+        {
+            handle = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            handle = static_cast<Handle>(m_texts.size());
+            m_texts.emplace_back();
+        }
+        m_texts[handle].used = true;
+        return handle;
+    }
+
+    void TextBatch::set(Handle                                           handle,
+                        const std::shared_ptr<const TextLayout::Layout> &layout,
+                        const glm::mat4                                 &model,
+                        const glm::vec4                                 &color)
+    {
+        L_TAG("TextBatch::set");
+        L_ASSERT(handle < m_texts.size() && m_texts[handle].used, "Invalid text handle: {}", handle);
+
+        Text &text  = m_texts[handle];
+        text.layout = layout;
+        text.model  = model;
+        text.color  = glm::packUnorm4x8(color);
+        m_dirty     = true;
+    }
+
+    void TextBatch::remove(Handle handle)
+    {
+        L_TAG("TextBatch::remove");
+        L_ASSERT(handle < m_texts.size() && m_texts[handle].used, "Invalid text handle: {}", handle);
+
+        m_texts[handle] = Text();
+        m_free.push_back(handle);
+        m_dirty = true;
+    }
+
+    std::shared_ptr<const TextBatch::Mesh> TextBatch::build()
+    {
+        if (!m_dirty && m_mesh) return m_mesh;
+        PROFILER_BLOCK("TextBatch::build");
+
+        /** count the quads of each page, then turn the counts into the first quad of each run */
+        m_pages.clear();
+        for (const Text &text : m_texts)
+        {
+            if (!text.layout) continue;
+            for (const TextLayout::Quad &quad : text.layout->quads)
+            {
+                auto page = std::find_if(m_pages.begin(), m_pages.end(), [&](auto &p) {
+                    return p.first == quad.texture;
+                });
+                if (page == m_pages.end())
+                    m_pages.emplace_back(quad.texture, 1);
+                else
+                    page->second++;
+            }
+        }
+        std::sort(m_pages.begin(), m_pages.end());
+
+        /** the renderer may still draw the previous mesh, its storage is only reused once released */
+        if (!m_mesh || m_mesh.use_count() > 1) m_mesh = std::make_shared<Mesh>();
+        Mesh &mesh = *m_mesh;
+        mesh.runs.clear();
+
+        std::size_t quads = 0;
+        for (auto &page : m_pages)
+        {
+            mesh.runs.push_back({page.first, quads, page.second});
+            quads += page.second;
+            page.second = mesh.runs.back().first;
+        }
+        mesh.vertices.resize(quads * 4);
+
+        /** texts keep their order within a run */
+        for (const Text &text : m_texts)
+        {
+            if (!text.layout) continue;
+            for (const TextLayout::Quad &quad : text.layout->quads)
+            {
+                auto page = std::lower_bound(m_pages.begin(),
+                                             m_pages.end(),
+                                             quad.texture,
+                                             [](auto &p, AssetID texture) { return p.first < texture; });
+
+                const glm::mat4 &m  = text.model;
+                const glm::vec4 &uv = quad.uvRect;
+                Vertex          *v  = &mesh.vertices[page->second++ * 4];
+                v[0] = {glm::vec3(m * glm::vec4(quad.min.x, quad.min.y, 0.0f, 1.0f)), {uv.x, uv.y}, text.color};
+                v[1] = {glm::vec3(m * glm::vec4(quad.max.x, quad.min.y, 0.0f, 1.0f)), {uv.z, uv.y}, text.color};
+                v[2] = {glm::vec3(m * glm::vec4(quad.max.x, quad.max.y, 0.0f, 1.0f)), {uv.z, uv.w}, text.color};
+                v[3] = {glm::vec3(m * glm::vec4(quad.min.x, quad.max.y, 0.0f, 1.0f)), {uv.x, uv.w}, text.color};
+            }
+        }
+
+        mesh.version = nextVersion();
+        m_dirty      = false;
+        return m_mesh;
+    }
+} // namespace core::ui
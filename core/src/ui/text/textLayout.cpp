@@ -0,0 +1,202 @@
+#include <ui/text/textLayout.hpp>
+#include <utils/hash.hpp>
+#include <utils/profiler.hpp>
+
+#include <algorithm>
+
+namespace core::ui
+{
+    /** Decodes the UTF-8 sequence at @p i and moves past it, invalid sequences give U+FFFD */
+    static char32_t decodeUtf8(const std::string &text, std::size_t &i)
+    {
+        constexpr char32_t replacement = 0xfffd;
+
+        const auto lead = static_cast<unsigned char>(text[i++]);
+        if (lead < 0x80) return lead;
+
+        std::size_t extra;
+        char32_t    codepoint;
+        if ((lead >> 5) == 0x06)
+        {
+            extra     = 1;
+            codepoint = lead & 0x1f;
+        }
+        else if ((lead >> 4) == 0x0e)
+        {
+            extra     = 2;
+            codepoint = lead & 0x0f;
+        }
+        else if ((lead >> 3) == 0x1e)
+        {
+            extra     = 3;
+            codepoint = lead & 0x07;
+        }
+        else
+            return replacement;
+
+        for (; extra > 0; extra--, i++)
+        {
+            if (i >= text.size() || (static_cast<unsigned char>(text[i]) & 0xc0) != 0x80) return replacement;
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i]) & 0x3f);
+        }
+        return codepoint;
+    }
+
+    std::size_t TextLayout::KeyHash::operator()(const Key &key) const
+    {
+        std::size_t hash = 0;
+        core::utils::hash_combine(hash, key.text, key.font, key.size, key.wrapWidth);
+        return hash;
+    }
+
+    TextLayout::TextLayout(GlyphCache &glyphCache) : TextLayout(glyphCache, Settings()) {}
+    TextLayout::TextLayout(GlyphCache &glyphCache, const Settings &settings)
+        : m_glyphCache(glyphCache),
+          m_settings(settings)
+    {
+    }
+    TextLayout::~TextLayout() = default;
+
+    std::shared_ptr<const TextLayout::Layout> TextLayout::shape(const Key &key)
+    {
+        PROFILER_BLOCK("TextLayout::shape");
+
+        auto        layout     = std::make_shared<Layout>();
+        auto       &quads      = layout->quads;
+        const float lineHeight = m_glyphCache.lineHeight(key.font, key.size);
+
+        float       penX     = 0.0f;
+        float       baseline = 0.0f;
+        float       lineEnd  = 0.0f; /** right of the last advance that wasn't a space */
+        char32_t    previous = 0;
+        std::size_t lines    = 1;
+
+        /** last place the line can be broken, the word after the last space */
+        constexpr std::size_t noWord      = static_cast<std::size_t>(-1);
+        std::size_t           wordQuad    = noWord;
+        float                 wordX       = 0.0f;
+        float                 wordLineEnd = 0.0f;
+
+        auto newLine = [&](float width) {
+            layout->size.x = std::max(layout->size.x, width);
+            baseline -= lineHeight;
+            penX     = 0.0f;
+            lineEnd  = 0.0f;
+            previous = 0;
+            wordQuad = noWord;
+            lines++;
+        };
+
+        for (std::size_t i = 0; i < key.text.size();)
+        {
+            const char32_t codepoint = decodeUtf8(key.text, i);
+            if (codepoint == '\n')
+            {
+                newLine(lineEnd);
+                continue;
+            }
+
+            const GlyphCache::Glyph glyph = m_glyphCache.get(key.font, key.size, codepoint);
+            if (previous) penX += m_glyphCache.kerning(key.font, key.size, previous, codepoint);
+
+            if (key.wrapWidth > 0.0f && codepoint != ' ' && penX > 0.0f && penX + glyph.advance > key.wrapWidth)
+            {
+                if (wordQuad != noWord)
+                {
+                    /** move the current word down to its own line */
+                    const std::size_t first = wordQuad;
+                    const float       shift = wordX;
+                    const float       pen   = penX - shift;
+                    const float       end   = lineEnd - shift;
+                    newLine(wordLineEnd);
+                    for (std::size_t q = first; q < quads.size(); q++)
+                    {
+                        quads[q].min += glm::vec2(-shift, -lineHeight);
+                        quads[q].max += glm::vec2(-shift, -lineHeight);
+                    }
+                    penX    = pen;
+                    lineEnd = end;
+                }
+                else
+                {
+                    /** a single word wider than the line is broken where it overflows */
+                    newLine(lineEnd);
+                }
+            }
+
+            if (glyph.texture >= 0)
+            {
+                const glm::vec2 min(penX + glyph.bearing.x, baseline + glyph.bearing.y - glyph.size.y);
+                quads.push_back({glyph.texture, min, min + glm::vec2(glyph.size), glyph.uvRect});
+            }
+            penX += glyph.advance;
+
+            if (codepoint == ' ')
+            {
+                /** spaces don't move lineEnd, the line ends after the previous word */
+                wordQuad    = quads.size();
+                wordX       = penX;
+                wordLineEnd = lineEnd;
+            }
+            else
+                lineEnd = penX;
+            previous = codepoint;
+        }
+
+        layout->size.x     = std::max(layout->size.x, lineEnd);
+        layout->size.y     = lines * lineHeight;
+        layout->lines      = lines;
+        layout->generation = m_glyphCache.generation();
+        return layout;
+    }
+
+    std::shared_ptr<const TextLayout::Layout> TextLayout::layout(const std::string &text,
+                                                                 GlyphCache::FontID font,
+                                                                 std::uint32_t      size,
+                                                                 float              wrapWidth)
+    {
+        Key  key{text, font, size, wrapWidth};
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            Entry &entry = it->second;
+            if (valid(*entry.layout))
+                m_stats.hits++;
+            else
+            {
+                entry.layout = shape(key);
+                m_stats.misses++;
+            }
+            m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+            return entry.layout;
+        }
+
+        auto layout = shape(key);
+        m_stats.misses++;
+
+        while (!m_lru.empty() && m_entries.size() >= std::max<std::size_t>(1, m_settings.maxEntries))
+        {
+            m_entries.erase(m_entries.find(*m_lru.back()));
+            m_lru.pop_back();
+        }
+
+        it = m_entries.emplace(std::move(key), Entry{layout, {}}).first;
+        m_lru.push_front(&it->first);
+        it->second.lru = m_lru.begin();
+
+        m_stats.entries = m_entries.size();
+        return layout;
+    }
+
+    bool TextLayout::valid(const Layout &layout) const noexcept
+    {
+        return layout.generation == m_glyphCache.generation();
+    }
+
+    void TextLayout::clear()
+    {
+        m_entries.clear();
+        m_lru.clear();
+        m_stats.entries = 0;
+    }
+} // namespace core::ui
@@ -3,6 +3,8 @@
 
 #include <SDL_ttf.h>
 
+#include <algorithm>
+
 UIManager::UIManager() = default;
 UIManager::~UIManager() = default;
 
@@ -52,3 +54,17 @@ core::assets::Font UIManager::loadFont(const AssetName &name)
 
     return font;
 }
+
+void UIManager::addTextBatch(core::ui::TextBatch &batch, AssetID pipeline)
+{
+    removeTextBatch(batch);
+    m_textBatches.push_back({&batch, pipeline});
+}
+
+void UIManager::removeTextBatch(core::ui::TextBatch &batch)
+{
+    m_textBatches.erase(std::remove_if(m_textBatches.begin(),
+                                       m_textBatches.end(),
+                                       [&](const TextBatchEntry &entry) { return entry.batch == &batch; }),
+                        m_textBatches.end());
+}
@@ -0,0 +1,137 @@
+#include <core/utils/jobs.hpp>
+#include <core/utils/logging.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+
+namespace core::utils
+{
+    static std::size_t defaultWorkers()
+    {
+#if defined(CONFIG_CORE_JOB_WORKERS) && CONFIG_CORE_JOB_WORKERS > 0
+        return CONFIG_CORE_JOB_WORKERS;
+#else
+        unsigned int threads = std::thread::hardware_concurrency();
+        return threads > 1 ? threads - 1 : 1;
+#endif
+    }
+
+    JobPool::JobPool(std::size_t workers)
+    {
+        L_TAG("JobPool::JobPool");
+
+        if (workers == 0) workers = defaultWorkers();
+        m_workers.reserve(workers);
+        for (std::size_t i = 0; i < workers; i++) m_workers.emplace_back(&JobPool::run, this);
+        L_DEBUG("Job pool started with {} workers", workers);
+    }
+
+    JobPool::~JobPool()
+    {
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto &worker : m_workers) worker.join();
+    }
+
+    JobPool &JobPool::getInstance()
+    {
+        /** Meyers Singleton (another option is std::call_once) */
+        static JobPool instance;
+        return instance;
+    }
+
+    void JobPool::push(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            m_jobs.push_back(std::move(job));
+        }
+        m_cv.notify_one();
+    }
+
+    bool JobPool::runOne()
+    {
+        std::function<void()> job;
+        {
+            std::lock_guard<std::mutex> l(m_mutex);
+            if (m_jobs.empty()) return false;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+        return true;
+    }
+
+    void JobPool::run()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> l(m_mutex);
+                m_cv.wait(l, [this]() { return m_stop || !m_jobs.empty(); });
+                if (m_jobs.empty()) return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    void JobPool::parallelFor(std::size_t count, const std::function<void(std::size_t index)> &job)
+    {
+        if (count == 0) return;
+
+        /** shared by the calls, indices are claimed one at a time */
+        struct State
+        {
+            std::atomic<std::size_t> next{0};
+            std::atomic<std::size_t> done{0};
+            std::exception_ptr       error;
+            std::mutex               mutex;
+            std::condition_variable  cv;
+        };
+        auto state = std::make_shared<State>();
+
+        auto work = [state, count, &job]() {
+            std::size_t index;
+            while ((index = state->next.fetch_add(1)) < count)
+            {
+                try
+                {
+                    job(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> l(state->mutex);
+                    if (!state->error) state->error = std::current_exception();
+                }
+                if (state->done.fetch_add(1) + 1 == count)
+                {
+                    std::lock_guard<std::mutex> l(state->mutex);
+                    state->cv.notify_all();
+                }
+            }
+        };
+
+        /** helpers that start after all indices are claimed return right away */
+        const std::size_t helpers = std::min(count - 1, m_workers.size());
+        for (std::size_t i = 0; i < helpers; i++) push(work);
+        work();
+
+        /** help with other jobs until the last index finishes */
+        while (state->done.load() < count)
+        {
+            if (runOne()) continue;
+            std::unique_lock<std::mutex> l(state->mutex);
+            state->cv.wait_for(l, std::chrono::milliseconds(1), [&]() { return state->done.load() >= count; });
+        }
+
+        if (state->error) std::rethrow_exception(state->error);
+    }
+} // namespace core::utils
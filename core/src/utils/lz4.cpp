@@ -0,0 +1,139 @@
+#include <core/utils/lz4.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace core::utils::lz4
+{
+    static constexpr std::size_t minMatch     = 4;
+    static constexpr std::size_t lastLiterals = 5;  /** a block ends with at least this many literals */
+    static constexpr std::size_t matchLimit   = 12; /** and its last match starts at least this far from the end */
+    static constexpr std::size_t maxOffset    = 65535;
+    static constexpr int         hashBits     = 16;
+
+    static std::uint32_t read32(const char *p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static std::uint32_t hash(std::uint32_t sequence) noexcept { return (sequence * 2654435761u) >> (32 - hashBits); }
+
+    /** Writes the bytes of a length that didn't fit its 4 bits, @p length excludes the 15 in the token */
+    static void writeLength(std::vector<char> &out, std::size_t length)
+    {
+        for (; length >= 255; length -= 255) out.push_back(static_cast<char>(255));
+        out.push_back(static_cast<char>(length));
+    }
+
+    /** Writes literals followed by a match, @p matchLength 0 ends the block */
+    static void writeSequence(std::vector<char> &out,
+                              const char        *literals,
+                              std::size_t        literalCount,
+                              std::size_t        offset,
+                              std::size_t        matchLength)
+    {
+        std::size_t matchCode = matchLength ? matchLength - minMatch : 0;
+        out.push_back(static_cast<char>((std::min<std::size_t>(literalCount, 15) << 4)
+                                        | std::min<std::size_t>(matchCode, 15)));
+        if (literalCount >= 15) writeLength(out, literalCount - 15);
+        out.insert(out.end(), literals, literals + literalCount);
+        if (matchLength == 0) return;
+
+        out.push_back(static_cast<char>(offset & 0xff));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (matchCode >= 15) writeLength(out, matchCode - 15);
+    }
+
+    std::vector<char> compress(const char *src, std::size_t size)
+    {
+        std::vector<char> out;
+        out.reserve(compressBound(size));
+
+        /** last position + 1 of each hashed 4 byte sequence, 0 if none */
+        std::vector<std::uint32_t> table(std::size_t(1) << hashBits, 0);
+
+        std::size_t anchor = 0;
+        std::size_t ip     = 0;
+        while (size > matchLimit && ip < size - matchLimit)
+        {
+            std::uint32_t  sequence = read32(src + ip);
+            std::uint32_t &slot     = table[hash(sequence)];
+            std::size_t    ref      = slot;
+            slot                    = static_cast<std::uint32_t>(ip + 1);
+            if (ref == 0 || ip - (ref - 1) > maxOffset || read32(src + ref - 1) != sequence)
+            {
+                ip++;
+                continue;
+            }
+            ref--;
+
+            std::size_t length = minMatch;
+            while (ip + length < size - lastLiterals && src[ref + length] == src[ip + length]) length++;
+
+            writeSequence(out, src + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+
+        writeSequence(out, src + anchor, size - anchor, 0, 0);
+        return out;
+    }
+
+    bool decompress(const char *src, std::size_t srcSize, char *dst, std::size_t dstSize) noexcept
+    {
+        const std::uint8_t *ip    = reinterpret_cast<const std::uint8_t *>(src);
+        const std::uint8_t *ipEnd = ip + srcSize;
+        char               *op    = dst;
+        char               *opEnd = dst + dstSize;
+
+        /** adds the extra bytes of a length, false if the block ends first */
+        auto readLength = [&](std::size_t &length) {
+            std::uint8_t byte;
+            do
+            {
+                if (ip == ipEnd) return false;
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (ip < ipEnd)
+        {
+            const unsigned int token    = *ip++;
+            std::size_t        literals = token >> 4;
+            if (literals == 15 && !readLength(literals)) return false;
+            if (literals > static_cast<std::size_t>(ipEnd - ip) || literals > static_cast<std::size_t>(opEnd - op))
+                return false;
+            if (literals > 0) std::memcpy(op, ip, literals);
+            ip += literals;
+            op += literals;
+
+            /** the last sequence has no match */
+            if (ip == ipEnd) break;
+
+            if (ipEnd - ip < 2) return false;
+            std::size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<std::size_t>(op - dst)) return false;
+
+            std::size_t length = token & 15;
+            if (length == 15 && !readLength(length)) return false;
+            length += minMatch;
+            if (length > static_cast<std::size_t>(opEnd - op)) return false;
+
+            /** matches may overlap the bytes they produce, copy forward one at a time */
+            const char *match = op - offset;
+            if (offset >= length)
+                std::memcpy(op, match, length);
+            else
+                for (std::size_t i = 0; i < length; i++) op[i] = match[i];
+            op += length;
+        }
+
+        return op == opEnd;
+    }
+} // namespace core::utils::lz4
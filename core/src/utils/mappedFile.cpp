@@ -0,0 +1,107 @@
+#include <core/utils/mappedFile.hpp>
+#include <core/utils/logging.hpp>
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core::utils
+{
+    MappedFile::MappedFile() = default;
+
+    MappedFile::MappedFile(const std::string &path)
+    {
+        L_TAG("MappedFile::MappedFile");
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  NULL,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                  NULL);
+        if (file == INVALID_HANDLE_VALUE) L_THROW_RUNTIME("Could not open {} ({})", path, GetLastError());
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            L_THROW_RUNTIME("Could not stat {} ({})", path, GetLastError());
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+
+        /** empty files can't be mapped, they just have no data */
+        if (m_size > 0)
+        {
+            m_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (m_mapping) m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        CloseHandle(file);
+        if (m_size > 0 && !m_data)
+        {
+            unmap();
+            L_THROW_RUNTIME("Could not map {} ({})", path, GetLastError());
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) L_THROW_RUNTIME("Could not open {}", path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            L_THROW_RUNTIME("Could not stat {}", path);
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+
+        /** empty files can't be mapped, they just have no data */
+        void *data = m_size > 0 ? ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            m_size = 0;
+            L_THROW_RUNTIME("Could not map {}", path);
+        }
+        m_data = static_cast<const char *>(data);
+#endif
+
+        L_TRACE("Mapped {} ({} bytes)", path, m_size);
+    }
+
+    MappedFile::~MappedFile() { unmap(); }
+
+    MappedFile::MappedFile(MappedFile &&o) noexcept { *this = std::move(o); }
+
+    MappedFile &MappedFile::operator=(MappedFile &&o) noexcept
+    {
+        if (this == &o) return *this;
+        unmap();
+        m_data = std::exchange(o.m_data, nullptr);
+        m_size = std::exchange(o.m_size, 0);
+#ifdef _WIN32
+        m_mapping = std::exchange(o.m_mapping, nullptr);
+#endif
+        return *this;
+    }
+
+    void MappedFile::unmap() noexcept
+    {
+#ifdef _WIN32
+        if (m_data) UnmapViewOfFile(m_data);
+        if (m_mapping) CloseHandle(m_mapping);
+        m_mapping = nullptr;
+#else
+        if (m_data) ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+} // namespace core::utils
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <core/assets/assetPack.hpp>
+#include <core/utils/lz4.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using core::assets::AssetPack;
+using core::assets::AssetPackWriter;
+
+/** Pack file in the temp directory, removed when the test ends */
+class AssetPackTest : public ::testing::Test
+{
+protected:
+    std::string path;
+
+    void SetUp() override
+    {
+        path = (std::filesystem::temp_directory_path()
+                / ("utAssetPack-" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name())
+                   + ".pack"))
+                   .string();
+    }
+    void TearDown() override { std::remove(path.c_str()); }
+};
+
+static std::vector<char> bytes(const std::string &s) { return std::vector<char>(s.begin(), s.end()); }
+
+static std::string unpack(const AssetPack &pack, const AssetPack::Entry &entry)
+{
+    std::string data(entry.size, '\0');
+    if (entry.flags & AssetPack::Lz4)
+        EXPECT_TRUE(core::utils::lz4::decompress(pack.payload(entry), entry.storedSize, data.data(), data.size()));
+    else
+        data.assign(pack.payload(entry), entry.size);
+    return data;
+}
+
+TEST_F(AssetPackTest, FindsStoredAndCompressedAssets)
+{
+    std::string repetitive;
+    for (int i = 0; i < 200; i++) repetitive += "asteroid " + std::to_string(i % 7) + ";";
+
+    AssetPackWriter writer;
+    writer.add("assets/shaders/sprite.vert", bytes("void main() {}"), false);
+    writer.add("assets/spritesheets/ship.json", bytes(repetitive), true);
+    writer.add("assets/textures/empty.png", {}, true);
+    auto stats = writer.write(path);
+    EXPECT_EQ(stats.entries, 3u);
+    EXPECT_EQ(stats.compressed, 1u);
+    EXPECT_LT(stats.storedSize, stats.size);
+
+    AssetPack pack(path);
+    ASSERT_EQ(pack.size(), 3u);
+    for (std::size_t i = 1; i < pack.size(); i++) EXPECT_LE(pack.entry(i - 1).hash, pack.entry(i).hash);
+
+    const AssetPack::Entry *shader = pack.find("assets/shaders/sprite.vert");
+    ASSERT_NE(shader, nullptr);
+    EXPECT_EQ(shader->flags, 0u);
+    EXPECT_EQ(shader->offset % AssetPack::payloadAlignment, 0u);
+    EXPECT_EQ(unpack(pack, *shader), "void main() {}");
+
+    const AssetPack::Entry *sheet = pack.find("assets/spritesheets/ship.json");
+    ASSERT_NE(sheet, nullptr);
+    EXPECT_EQ(sheet->flags, AssetPack::Lz4);
+    EXPECT_EQ(unpack(pack, *sheet), repetitive);
+
+    const AssetPack::Entry *empty = pack.find("assets/textures/empty.png");
+    ASSERT_NE(empty, nullptr);
+    EXPECT_EQ(empty->size, 0u);
+
+    EXPECT_EQ(pack.find("assets/shaders/sprite.frag"), nullptr);
+    EXPECT_EQ(pack.find(""), nullptr);
+}
+
+TEST_F(AssetPackTest, RejectsDuplicatesAndCorruptPacks)
+{
+    AssetPackWriter duplicates;
+    duplicates.add("assets/fonts/a.ttf", bytes("a"), false);
+    duplicates.add("assets/fonts/a.ttf", bytes("b"), false);
+    EXPECT_THROW(duplicates.write(path), std::runtime_error);
+
+    AssetPackWriter writer;
+    writer.add("assets/fonts/a.ttf", bytes("font"), false);
+    writer.write(path);
+    std::filesystem::resize_file(path, sizeof(AssetPack::Header) + 8);
+    EXPECT_THROW(AssetPack pack(path), std::runtime_error);
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a pack, just some bytes";
+    EXPECT_THROW(AssetPack pack(path), std::runtime_error);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <core/assets/atlasPacker.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using core::assets::AtlasPacker;
+
+static bool overlaps(const AtlasPacker::Rect &a, const AtlasPacker::Rect &b, std::uint32_t padding)
+{
+    return a.x < b.x + b.w + padding && b.x < a.x + a.w + padding && a.y < b.y + b.h + padding
+        && b.y < a.y + a.h + padding;
+}
+
+static void expectValid(const AtlasPacker                         &packer,
+                        const std::vector<AtlasPacker::Placement> &placements)
+{
+    const std::uint32_t padding = packer.settings().padding;
+    for (std::size_t i = 0; i < placements.size(); i++)
+    {
+        const auto &a    = placements[i];
+        const auto &page = packer.pages().at(a.page);
+        EXPECT_GE(a.rect.x, padding);
+        EXPECT_GE(a.rect.y, padding);
+        EXPECT_LE(a.rect.x + a.rect.w + padding, page.width);
+        EXPECT_LE(a.rect.y + a.rect.h + padding, page.height);
+        for (std::size_t j = i + 1; j < placements.size(); j++)
+        {
+            const auto &b = placements[j];
+            if (a.page == b.page)
+            {
+                EXPECT_FALSE(overlaps(a.rect, b.rect, padding)) << i << " overlaps " << j;
+            }
+        }
+    }
+}
+
+TEST(AtlasPackerTest, PlacementsDoNotOverlap)
+{
+    AtlasPacker                    packer;
+    std::vector<AtlasPacker::Rect> sizes;
+    for (std::uint32_t i = 0; i < 200; i++)
+        sizes.push_back({0, 0, 8 + (i * 37) % 120, 8 + (i * 53) % 90});
+
+    auto placements = packer.pack(sizes);
+    ASSERT_EQ(placements.size(), sizes.size());
+    for (std::size_t i = 0; i < sizes.size(); i++)
+    {
+        EXPECT_EQ(placements[i].rect.w, sizes[i].w);
+        EXPECT_EQ(placements[i].rect.h, sizes[i].h);
+    }
+    expectValid(packer, placements);
+}
+
+TEST(AtlasPackerTest, PagesAreShrunkToPowerOfTwo)
+{
+    AtlasPacker packer;
+    auto        placements = packer.pack({{0, 0, 60, 60}, {0, 0, 60, 60}});
+
+    ASSERT_EQ(packer.pages().size(), 1u);
+    EXPECT_EQ(placements[0].page, 0u);
+    EXPECT_EQ(placements[1].page, 0u);
+    /** 2 x (60 + 2 * 2) side by side */
+    EXPECT_EQ(packer.pages()[0].width, 128u);
+    EXPECT_EQ(packer.pages()[0].height, 64u);
+    expectValid(packer, placements);
+}
+
+TEST(AtlasPackerTest, OverflowOpensNewPages)
+{
+    AtlasPacker::Settings settings;
+    settings.maxPageSize = 256;
+    settings.padding     = 0;
+    AtlasPacker packer(settings);
+
+    auto placements = packer.pack(std::vector<AtlasPacker::Rect>(5, {0, 0, 128, 128}));
+
+    ASSERT_EQ(packer.pages().size(), 2u);
+    EXPECT_FLOAT_EQ(packer.occupancy(0), 1.0f);
+    EXPECT_EQ(placements[4].page, 1u);
+    EXPECT_EQ(packer.pages()[1].width, 128u);
+    expectValid(packer, placements);
+}
+
+TEST(AtlasPackerTest, IncrementalPackFillsExistingPages)
+{
+    AtlasPacker packer;
+    auto        first = packer.pack({{0, 0, 100, 20}, {0, 0, 20, 100}});
+    ASSERT_EQ(packer.pages().size(), 1u);
+    const auto page = packer.pages()[0];
+
+    auto second = packer.pack({{0, 0, 16, 16}});
+    EXPECT_EQ(packer.pages().size(), 1u);
+    EXPECT_EQ(second[0].page, 0u);
+    EXPECT_EQ(packer.pages()[0].width, page.width);
+    EXPECT_EQ(packer.pages()[0].height, page.height);
+
+    first.insert(first.end(), second.begin(), second.end());
+    expectValid(packer, first);
+}
+
+TEST(AtlasPackerTest, OversizedRectThrows)
+{
+    AtlasPacker::Settings settings;
+    settings.maxPageSize = 64;
+    AtlasPacker packer(settings);
+
+    EXPECT_THROW(packer.pack({{0, 0, 62, 10}}), std::runtime_error);
+}
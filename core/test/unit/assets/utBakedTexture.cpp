@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <core/assets/bakedTexture.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using core::assets::BakedTexture;
+using core::assets::Texture;
+
+/** 4x2 image, top row red, bottom row blue */
+static Texture twoRows()
+{
+    std::vector<std::uint32_t> pixels(8);
+    for (std::size_t x = 0; x < 4; x++)
+    {
+        pixels[x]     = 0xff0000ff;
+        pixels[4 + x] = 0xffff0000;
+    }
+    return Texture("twoRows", 4, 2, pixels.data());
+}
+
+TEST(BakedTextureTest, BakesFlippedMipChain)
+{
+    BakedTexture baked("twoRows", BakedTexture::bake(twoRows(), 42));
+
+    EXPECT_EQ(baked.width(), 4u);
+    EXPECT_EQ(baked.height(), 2u);
+    EXPECT_EQ(baked.sourceHash(), 42u);
+    ASSERT_EQ(baked.levels(), 3u);
+    EXPECT_EQ(baked.level(1).width, 2u);
+    EXPECT_EQ(baked.level(1).height, 1u);
+    EXPECT_EQ(baked.level(2).width, 1u);
+    EXPECT_EQ(baked.level(2).height, 1u);
+
+    for (std::size_t i = 0; i < baked.levels(); i++)
+        EXPECT_EQ(baked.level(i).offset % BakedTexture::payloadAlignment, 0u) << "level " << i;
+
+    /** bottom row first */
+    const std::uint8_t *level0 = reinterpret_cast<const std::uint8_t *>(baked.payload());
+    EXPECT_EQ(level0[0], 0x00);
+    EXPECT_EQ(level0[2], 0xff);
+    EXPECT_EQ(level0[4 * 4 + 0], 0xff);
+    EXPECT_EQ(level0[4 * 4 + 2], 0x00);
+
+    /** both rows averaged */
+    const std::uint8_t *level2 = reinterpret_cast<const std::uint8_t *>(baked.payload() + baked.level(2).offset);
+    EXPECT_EQ(level2[0], 0x80);
+    EXPECT_EQ(level2[1], 0x00);
+    EXPECT_EQ(level2[2], 0x80);
+    EXPECT_EQ(level2[3], 0xff);
+}
+
+TEST(BakedTextureTest, RejectsCorruptBlobs)
+{
+    std::vector<char> blob = BakedTexture::bake(twoRows(), 0);
+
+    std::vector<char> truncated(blob.begin(), blob.end() - 32);
+    EXPECT_THROW(BakedTexture("twoRows", truncated), std::runtime_error);
+
+    std::vector<char> badMagic = blob;
+    badMagic[0] ^= 0xff;
+    EXPECT_THROW(BakedTexture("twoRows", badMagic), std::runtime_error);
+
+    EXPECT_THROW(BakedTexture("twoRows", std::vector<char>()), std::runtime_error);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <core/event.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Hit
+    {
+        int value;
+    };
+
+    struct Spawn
+    {
+        float x, y;
+    };
+} // namespace
+
+TEST(EventManagerTest, TypeIDsAreDistinct)
+{
+    EXPECT_NE(getEventTypeID<Hit>(), getEventTypeID<Spawn>());
+    EXPECT_EQ(getEventTypeID<Hit>(), getEventTypeID<const Hit &>());
+}
+
+TEST(EventManagerTest, DispatchesBatchAtRegisteredPhase)
+{
+    EventManager manager;
+    manager.init();
+    manager.registerEvent<Spawn>(EventPhase::PostUpdate);
+
+    std::vector<int> hits;
+    std::size_t      spawns = 0;
+    manager.subscribe<Hit>([&](const EventBatch<Hit> &batch) {
+        for (const Hit &hit : batch) hits.push_back(hit.value);
+    });
+    manager.subscribe<Spawn>([&](const EventBatch<Spawn> &batch) { spawns += batch.size; });
+
+    manager.post(Hit{1});
+    manager.post(Hit{2});
+    manager.post(Spawn{0.0f, 1.0f});
+    EXPECT_EQ(manager.pendingCount<Hit>(), 2u);
+
+    manager.dispatch(EventPhase::Update);
+    EXPECT_EQ(hits, (std::vector<int>{1, 2}));
+    EXPECT_EQ(spawns, 0u);
+    EXPECT_EQ(manager.pendingCount<Hit>(), 0u);
+
+    manager.dispatch(EventPhase::PostUpdate);
+    EXPECT_EQ(spawns, 1u);
+}
+
+TEST(EventManagerTest, UnsubscribeDuringDispatchKeepsOtherHandlers)
+{
+    EventManager manager;
+    manager.init();
+
+    int            first = 0, second = 0, third = 0;
+    EventHandlerID firstID = 0;
+    firstID                = manager.subscribe<Hit>([&](const EventBatch<Hit> &) {
+        manager.unsubscribe(firstID);
+        first++; /** the running handler must stay alive after unsubscribing */
+    });
+    manager.subscribe<Hit>([&](const EventBatch<Hit> &) { second++; });
+    manager.subscribe<Hit>([&](const EventBatch<Hit> &) {
+        third++;
+        manager.subscribe<Hit>([&](const EventBatch<Hit> &) { third += 10; });
+    });
+
+    manager.post(Hit{0});
+    manager.dispatch(EventPhase::Update);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 1);
+    EXPECT_EQ(third, 1); /** handlers subscribed during dispatch run from the next one */
+
+    manager.post(Hit{0});
+    manager.dispatch(EventPhase::Update);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 2);
+    EXPECT_EQ(third, 12);
+}
+
+TEST(EventManagerTest, PostsFromOtherThreadsAtNextDispatch)
+{
+    EventManager manager;
+    manager.init();
+
+    std::vector<int> hits;
+    manager.subscribe<Hit>([&](const EventBatch<Hit> &batch) {
+        for (const Hit &hit : batch) hits.push_back(hit.value);
+    });
+
+    std::thread([&]() {
+        for (int i = 0; i < 10; i++) EXPECT_TRUE(manager.post(Hit{i}));
+    }).join();
+    EXPECT_EQ(manager.pendingCount<Hit>(), 0u);
+
+    manager.dispatch(EventPhase::Update);
+    ASSERT_EQ(hits.size(), 10u);
+    for (int i = 0; i < 10; i++) EXPECT_EQ(hits[i], i);
+    EXPECT_EQ(manager.droppedCount(), 0u);
+}
+
+TEST(EventManagerTest, CountsEventsDroppedWhenQueueIsFull)
+{
+    EventManager manager;
+    manager.init();
+
+    std::size_t received = 0;
+    manager.subscribe<Hit>([&](const EventBatch<Hit> &batch) { received += batch.size; });
+
+    constexpr std::size_t posted = 4096;
+    std::size_t           failed = 0;
+    std::thread([&]() {
+        for (std::size_t i = 0; i < posted; i++)
+            if (!manager.post(Hit{static_cast<int>(i)})) failed++;
+    }).join();
+
+    manager.dispatch(EventPhase::Update);
+    EXPECT_GT(failed, 0u);
+    EXPECT_EQ(manager.droppedCount(), failed);
+    EXPECT_EQ(received + failed, posted);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <core/graphics/culling.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static float distance(const glm::vec4 &plane, const glm::vec3 &point) { return glm::dot(glm::vec3(plane), point) + plane.w; }
+
+/** culls one sphere alone, batches of less than 4 spheres only take the scalar path */
+static bool visibleAlone(const glm::vec3 &center, float radius, const glm::mat4 &viewProjection, bool orthographic)
+{
+    CullBatch batch;
+    batch.push(center, radius);
+    std::vector<std::uint32_t> visible;
+    batch.cull(viewProjection, orthographic, visible);
+    return !visible.empty();
+}
+
+/** culls 4 copies of one sphere, taken by the SSE path when available */
+static bool visibleInGroup(const glm::vec3 &center, float radius, const glm::mat4 &viewProjection, bool orthographic)
+{
+    CullBatch batch;
+    for (int i = 0; i < 4; i++) batch.push(center, radius);
+    std::vector<std::uint32_t> visible;
+    batch.cull(viewProjection, orthographic, visible);
+    EXPECT_TRUE(visible.empty() || visible.size() == 4u);
+    return visible.size() == 4u;
+}
+
+TEST(Culling, FrustumPlanesFromPerspective)
+{
+    /** 90 degree fov, planes go through the diagonals of the view */
+    Frustum frustum = Frustum::fromMatrix(glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f));
+
+    for (const auto &plane : frustum.planes)
+    {
+        EXPECT_NEAR(glm::length(glm::vec3(plane)), 1.0f, 1e-5f);
+        EXPECT_GT(distance(plane, glm::vec3(0.0f, 0.0f, -50.0f)), 0.0f);
+    }
+
+    /** left, right, bottom, top, near, far */
+    EXPECT_NEAR(distance(frustum.planes[0], glm::vec3(-10.0f, 0.0f, -10.0f)), 0.0f, 1e-4f);
+    EXPECT_NEAR(distance(frustum.planes[1], glm::vec3(10.0f, 0.0f, -10.0f)), 0.0f, 1e-4f);
+    EXPECT_NEAR(distance(frustum.planes[2], glm::vec3(0.0f, -10.0f, -10.0f)), 0.0f, 1e-4f);
+    EXPECT_NEAR(distance(frustum.planes[3], glm::vec3(0.0f, 10.0f, -10.0f)), 0.0f, 1e-4f);
+    EXPECT_NEAR(distance(frustum.planes[4], glm::vec3(0.0f, 0.0f, -1.0f)), 0.0f, 1e-4f);
+    EXPECT_NEAR(distance(frustum.planes[5], glm::vec3(0.0f, 0.0f, -100.0f)), 0.0f, 1e-2f);
+    EXPECT_LT(distance(frustum.planes[0], glm::vec3(-20.0f, 0.0f, -10.0f)), 0.0f);
+    EXPECT_LT(distance(frustum.planes[4], glm::vec3(0.0f, 0.0f, 0.0f)), 0.0f);
+}
+
+TEST(Culling, CullBatchReturnsIndicesInOrder)
+{
+    glm::mat4 viewProjection = glm::ortho(0.0f, 100.0f, 0.0f, 100.0f, -10.0f, 10.0f);
+
+    CullBatch batch;
+    batch.reserve(10);
+    for (int i = 0; i < 10; i++) batch.push(glm::vec3(i % 2 ? 50.0f : 500.0f, 50.0f, 0.0f), 1.0f);
+    ASSERT_EQ(batch.size(), 10u);
+
+    std::vector<std::uint32_t> visible = {42};
+    batch.cull(viewProjection, true, visible);
+    EXPECT_EQ(visible, (std::vector<std::uint32_t>{1, 3, 5, 7, 9}));
+
+    batch.cull(viewProjection, false, visible);
+    EXPECT_EQ(visible, (std::vector<std::uint32_t>{1, 3, 5, 7, 9}));
+
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+    batch.cull(viewProjection, true, visible);
+    EXPECT_TRUE(visible.empty());
+}
+
+TEST(Culling, SseAndScalarPathsAgree)
+{
+    const glm::mat4 perspective = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.5f, 200.0f);
+    const glm::mat4 ortho       = glm::ortho(-100.0f, 100.0f, -50.0f, 50.0f, -20.0f, 20.0f);
+
+    std::mt19937                          rng(1234);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 10.0f);
+
+    /** not a multiple of 4 so the tail goes through the scalar loop as well */
+    constexpr int          count = 1001;
+    std::vector<glm::vec4> spheres;
+    CullBatch              batch;
+    for (int i = 0; i < count; i++)
+    {
+        float x = position(rng), y = position(rng), z = position(rng);
+        spheres.push_back(glm::vec4(x, y, z, radius(rng)));
+        batch.push(glm::vec3(spheres.back()), spheres.back().w);
+    }
+
+    for (bool orthographic : {false, true})
+    {
+        const glm::mat4 &viewProjection = orthographic ? ortho : perspective;
+
+        std::vector<std::uint32_t> visible;
+        batch.cull(viewProjection, orthographic, visible);
+
+        std::vector<std::uint32_t> expected;
+        for (int i = 0; i < count; i++)
+        {
+            if (visibleAlone(glm::vec3(spheres[i]), spheres[i].w, viewProjection, orthographic))
+                expected.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        EXPECT_FALSE(expected.empty());
+        EXPECT_LT(expected.size(), static_cast<std::size_t>(count));
+        EXPECT_EQ(visible, expected) << "orthographic: " << orthographic;
+    }
+}
+
+TEST(Culling, SpheresTouchingPlanesAreVisible)
+{
+    /** powers of two keep the clip space math exact, the view is [0, 128] x [0, 128] x [-16, 16] */
+    const glm::mat4 viewProjection = glm::ortho(0.0f, 128.0f, 0.0f, 128.0f, -16.0f, 16.0f);
+
+    const glm::vec3 touching[] = {
+        {-8.0f, 64.0f, 0.0f}, {136.0f, 64.0f, 0.0f}, {64.0f, -8.0f, 0.0f},
+        {64.0f, 136.0f, 0.0f}, {64.0f, 64.0f, 24.0f}, {64.0f, 64.0f, -24.0f},
+    };
+    const glm::vec3 outside[] = {
+        {-8.5f, 64.0f, 0.0f}, {136.5f, 64.0f, 0.0f}, {64.0f, -8.5f, 0.0f},
+        {64.0f, 136.5f, 0.0f}, {64.0f, 64.0f, 24.5f}, {64.0f, 64.0f, -24.5f},
+    };
+
+    /** the ortho slab test and the plane test must agree on the boundary */
+    for (bool orthographic : {false, true})
+    {
+        for (const auto &center : touching)
+        {
+            EXPECT_TRUE(visibleAlone(center, 8.0f, viewProjection, orthographic)) << center.x << " " << center.y << " " << center.z;
+            EXPECT_TRUE(visibleInGroup(center, 8.0f, viewProjection, orthographic)) << center.x << " " << center.y << " " << center.z;
+        }
+        for (const auto &center : outside)
+        {
+            EXPECT_FALSE(visibleAlone(center, 8.0f, viewProjection, orthographic)) << center.x << " " << center.y << " " << center.z;
+            EXPECT_FALSE(visibleInGroup(center, 8.0f, viewProjection, orthographic)) << center.x << " " << center.y << " " << center.z;
+        }
+    }
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <generated/config.h>
+#include <core/graphics/renderer/recording/rec-renderer.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+/** orthographic camera covering [0, 100] x [0, 100] */
+static FramePacket::Camera orthoCamera()
+{
+    RenderMask mask;
+    mask.set(0);
+    return {glm::mat4(1.0f), glm::ortho(0.0f, 100.0f, 0.0f, 100.0f, -10.0f, 10.0f), true, mask};
+}
+
+static RenderMask defaultMask()
+{
+    RenderMask mask;
+    mask.set(0);
+    return mask;
+}
+
+static FramePacket::Sprite sprite(AssetID pipeline, AssetID texture, const glm::vec3 &position, std::uint8_t layer = 0)
+{
+    return {glm::translate(glm::mat4(1.0f), position), glm::vec4(0, 0, 1, 1), glm::vec4(1.0f), pipeline, texture, layer, defaultMask()};
+}
+
+static FramePacket::Mesh mesh(AssetID pipeline, AssetID texture, AssetID meshID, const glm::vec3 &position)
+{
+    return {glm::translate(glm::mat4(1.0f), position), pipeline, texture, meshID, 0, defaultMask()};
+}
+
+class RecordingRendererTest : public ::testing::Test
+{
+protected:
+    RecordingRenderer      renderer;
+    RecordingAssetManager &am = renderer.assetManager();
+    FramePacket            packet;
+
+    AssetID spritePipeline = am.loadAsset(AssetType::Pipeline, "sprite");
+    AssetID meshPipeline   = am.loadAsset(AssetType::Pipeline, "default");
+    AssetID textureA       = am.loadAsset(AssetType::Texture, "a.png");
+    AssetID textureB       = am.loadAsset(AssetType::Texture, "b.png");
+    AssetID cube           = am.loadAsset(AssetType::Mesh, "cube");
+
+    void SetUp() override { packet.cameras.push_back(orthoCamera()); }
+};
+
+TEST_F(RecordingRendererTest, SpritesDrawOncePerTexture)
+{
+    constexpr int spriteCount = 1000;
+    for (int i = 0; i < spriteCount; i++)
+        packet.sprites.push_back(sprite(spritePipeline, i % 2 ? textureA : textureB, glm::vec3(i % 90, i / 90 * 5, 0)));
+
+    const CommandLog &log = renderer.renderFrame(packet);
+
+    CommandLog::Budget budget;
+    budget.drawCalls     = 2;
+    budget.pipelineBinds = 1;
+    budget.textureBinds  = 2;
+    EXPECT_EQ(log.checkBudget(budget), "") << log.toString();
+    EXPECT_EQ(log.count(CommandLog::Op::DrawSprites), 2u);
+    EXPECT_EQ(renderer.stats().spriteCount, static_cast<std::size_t>(spriteCount));
+}
+
+TEST_F(RecordingRendererTest, SpritesDrawByLayer)
+{
+    /** overlapping sprites, submitted top layer first */
+    packet.sprites.push_back(sprite(spritePipeline, textureA, glm::vec3(10, 10, 0), 2));
+    packet.sprites.push_back(sprite(spritePipeline, textureB, glm::vec3(10, 10, 0), 1));
+    packet.sprites.push_back(sprite(spritePipeline, textureA, glm::vec3(10, 10, 0), 0));
+
+    const CommandLog &log = renderer.renderFrame(packet);
+
+    /** the same texture on two layers isn't merged across the layer in between */
+    std::vector<AssetID> drawn;
+    for (const auto &command : log.commands())
+        if (command.op == CommandLog::Op::DrawSprites) drawn.push_back(command.id);
+    EXPECT_EQ(drawn, (std::vector<AssetID>{textureA, textureB, textureA})) << log.toString();
+}
+
+TEST_F(RecordingRendererTest, IdenticalMeshesDrawInstanced)
+{
+    constexpr int meshCount = 100;
+    for (int i = 0; i < meshCount; i++)
+        packet.meshes.push_back(mesh(meshPipeline, textureA, cube, glm::vec3(i % 10 * 10 + 5, i / 10 * 10 + 5, 0)));
+
+    const CommandLog &log = renderer.renderFrame(packet);
+    EXPECT_EQ(log.drawCalls(), 1u) << log.toString();
+    ASSERT_EQ(log.count(CommandLog::Op::DrawInstanced), 1u);
+
+    /** without instancing every mesh is drawn, but state is still bound once */
+    am.setInstancing(false);
+    const CommandLog &fallback = renderer.renderFrame(packet);
+
+    CommandLog::Budget budget;
+    budget.drawCalls     = meshCount;
+    budget.pipelineBinds = 1;
+    budget.textureBinds  = 1;
+    budget.meshBinds     = 1;
+    EXPECT_EQ(fallback.checkBudget(budget), "") << fallback.toString();
+    EXPECT_EQ(fallback.count(CommandLog::Op::Draw), static_cast<std::size_t>(meshCount));
+}
+
+TEST_F(RecordingRendererTest, InstancedVariantsLoadWithPipeline)
+{
+    /** the variant exists before anything is drawn, drawing never adds a pipeline */
+    AssetID instanced = am.getInstancedPipeline(meshPipeline);
+    ASSERT_GE(instanced, 0);
+    EXPECT_EQ(am.getName(AssetType::Pipeline, instanced), "default_instanced");
+    EXPECT_LT(am.getInstancedPipeline(instanced), 0);
+
+    for (int i = 0; i < 16; i++)
+        packet.meshes.push_back(mesh(meshPipeline, textureA, cube, glm::vec3(i * 5 + 5, 50, 0)));
+    std::size_t pipelines = am.count(AssetType::Pipeline);
+    renderer.renderFrame(packet);
+    EXPECT_EQ(am.count(AssetType::Pipeline), pipelines);
+
+    /** a pipeline loaded between frames brings its variant, earlier ids stay valid */
+    AssetID outline = am.loadAsset(AssetType::Pipeline, "outline");
+    EXPECT_EQ(am.count(AssetType::Pipeline), pipelines + 2);
+    EXPECT_EQ(am.getInstancedPipeline(meshPipeline), instanced);
+    EXPECT_EQ(am.loadAsset(AssetType::Pipeline, "outline"), outline);
+
+    for (int i = 0; i < 16; i++)
+        packet.meshes.push_back(mesh(outline, textureA, cube, glm::vec3(i * 5 + 5, 60, 0)));
+    const CommandLog &log = renderer.renderFrame(packet);
+    EXPECT_EQ(am.count(AssetType::Pipeline), pipelines + 2);
+    EXPECT_EQ(log.count(CommandLog::Op::DrawInstanced), 2u) << log.toString();
+}
+
+TEST_F(RecordingRendererTest, MeshesSortedByState)
+{
+    /** interleaved textures, the render queue groups them */
+    for (int i = 0; i < 64; i++)
+        packet.meshes.push_back(mesh(meshPipeline, i % 2 ? textureA : textureB, cube, glm::vec3(i + 5, 50, 0)));
+
+    am.setInstancing(false);
+    const CommandLog &log = renderer.renderFrame(packet);
+    EXPECT_EQ(log.count(CommandLog::Op::BindTexture), 2u) << log.toString();
+    EXPECT_EQ(log.count(CommandLog::Op::BindPipeline), 1u);
+    EXPECT_GT(log.redundantBinds(), 0u);
+}
+
+TEST_F(RecordingRendererTest, CulledRenderablesAreNotDrawn)
+{
+    packet.meshes.push_back(mesh(meshPipeline, textureA, cube, glm::vec3(50, 50, 0)));
+    packet.meshes.push_back(mesh(meshPipeline, textureA, cube, glm::vec3(500, 50, 0)));
+    packet.sprites.push_back(sprite(spritePipeline, textureA, glm::vec3(-50, -50, 0)));
+
+    const CommandLog &log = renderer.renderFrame(packet);
+    EXPECT_EQ(log.drawCalls(), 1u) << log.toString();
+    EXPECT_EQ(renderer.stats().visible, 1u);
+    EXPECT_EQ(renderer.stats().culled, 2u);
+}
+
+TEST_F(RecordingRendererTest, RenderMaskFiltersCameras)
+{
+    RenderMask other;
+    other.set(1);
+    FramePacket::Sprite hidden = sprite(spritePipeline, textureA, glm::vec3(50, 50, 0));
+    hidden.renderMask          = other;
+    packet.sprites.push_back(hidden);
+
+    EXPECT_EQ(renderer.renderFrame(packet).drawCalls(), 0u);
+}
+
+TEST_F(RecordingRendererTest, DiffReportsFirstMismatch)
+{
+    for (int i = 0; i < 10; i++)
+        packet.sprites.push_back(sprite(spritePipeline, textureA, glm::vec3(i * 5, 50, 0)));
+
+    CommandLog first = renderer.renderFrame(packet);
+    CommandLog same  = renderer.renderFrame(packet);
+
+    /** only the frame number differs, which diff ignores */
+    ASSERT_NE(first[0], same[0]);
+    CommandLog::Diff diff = CommandLog::diff(first, same);
+    EXPECT_TRUE(diff.identical()) << diff.report;
+    EXPECT_EQ(diff.firstMismatch, CommandLog::Diff::npos);
+    EXPECT_EQ(diff.report, "");
+    EXPECT_EQ(diff.countDelta[static_cast<std::size_t>(CommandLog::Op::DrawSprites)], 0);
+
+    packet.sprites.push_back(sprite(spritePipeline, textureB, glm::vec3(80, 50, 0)));
+    CommandLog changed = renderer.renderFrame(packet);
+
+    diff = CommandLog::diff(same, changed);
+    EXPECT_FALSE(diff.identical());
+    EXPECT_GT(diff.firstMismatch, 0u);
+    EXPECT_EQ(diff.countDelta[static_cast<std::size_t>(CommandLog::Op::DrawSprites)], 1);
+    EXPECT_EQ(diff.countDelta[static_cast<std::size_t>(CommandLog::Op::BindTexture)], 1);
+    EXPECT_THAT(diff.report, ::testing::HasSubstr("DrawSprites"));
+
+    EXPECT_TRUE(CommandLog::diff(changed, changed).identical());
+}
+
+TEST_F(RecordingRendererTest, BudgetReportsExceededLimits)
+{
+    packet.sprites.push_back(sprite(spritePipeline, textureA, glm::vec3(10, 10, 0)));
+    packet.sprites.push_back(sprite(spritePipeline, textureB, glm::vec3(20, 10, 0)));
+
+    CommandLog::Budget budget;
+    budget.drawCalls = 1;
+    std::string report = renderer.renderFrame(packet).checkBudget(budget);
+    EXPECT_THAT(report, ::testing::HasSubstr("draw calls: 2 > 1"));
+}
+
+TEST_F(RecordingRendererTest, StaticTextIsUploadedOnce)
+{
+    AssetID textPipeline = am.loadAsset(AssetType::Pipeline, "text");
+
+    auto layout = std::make_shared<core::ui::TextLayout::Layout>();
+    for (int i = 0; i < 20; i++)
+    {
+        glm::vec2 min(i * 4.0f, 10.0f);
+        layout->quads.push_back({i % 2 ? textureA : textureB, min, min + glm::vec2(4.0f), glm::vec4(0, 0, 1, 1)});
+    }
+
+    core::ui::TextBatch batch;
+    batch.set(batch.add(), layout, glm::mat4(1.0f), glm::vec4(1.0f));
+
+    RenderMask textMask(RenderMaskBits::TEXT);
+    packet.cameras[0].renderMask |= textMask;
+    packet.texts.push_back({batch.build(), textPipeline, textMask});
+
+    const CommandLog &first = renderer.renderFrame(packet);
+    EXPECT_EQ(first.count(CommandLog::Op::UploadText), 1u);
+    EXPECT_EQ(first.count(CommandLog::Op::DrawText), 2u) << first.toString();
+    EXPECT_EQ(renderer.stats().textQuads, 20u);
+
+    /** an unchanged batch hands out the same mesh, nothing is uploaded again */
+    packet.texts[0].mesh = batch.build();
+    const CommandLog &second = renderer.renderFrame(packet);
+    EXPECT_EQ(second.count(CommandLog::Op::UploadText), 0u);
+    EXPECT_EQ(second.count(CommandLog::Op::DrawText), 2u);
+    EXPECT_EQ(renderer.stats().streamedBytes, 0u);
+}
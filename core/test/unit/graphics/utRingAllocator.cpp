@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <core/graphics/ringAllocator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+TEST(RingAllocator, RegionsAreReusedAfterAllFramesInFlight)
+{
+    constexpr std::size_t regions = 3;
+    RingAllocator         ring(1000, regions);
+    EXPECT_EQ(ring.frameSize(), 1024u);
+    EXPECT_EQ(ring.bufferSize(), 3072u);
+
+    /** a region comes back every 3 frames, that's when its fence gets waited on */
+    std::vector<std::size_t> order;
+    for (int frame = 0; frame < 7; frame++)
+    {
+        std::size_t region = ring.nextRegion();
+        order.push_back(region);
+        EXPECT_EQ(ring.region(), region);
+        EXPECT_EQ(ring.regionOffset(), region * ring.frameSize());
+        EXPECT_EQ(ring.head(), 0u);
+
+        std::size_t offset = 0;
+        ASSERT_TRUE(ring.allocate(100, 16, offset));
+        EXPECT_EQ(offset, 0u);
+    }
+    EXPECT_EQ(order, (std::vector<std::size_t>{1, 2, 0, 1, 2, 0, 1}));
+}
+
+TEST(RingAllocator, AllocationsAreAlignedAndBounded)
+{
+    RingAllocator ring(256, 2);
+    std::size_t   offset = 0;
+
+    ASSERT_TRUE(ring.allocate(10, 16, offset));
+    EXPECT_EQ(offset, 0u);
+    ASSERT_TRUE(ring.allocate(10, 64, offset));
+    EXPECT_EQ(offset, 64u);
+    ASSERT_TRUE(ring.allocate(1, 1, offset));
+    EXPECT_EQ(offset, 74u);
+    EXPECT_EQ(ring.head(), 75u);
+
+    /** exactly fills the region, then nothing fits */
+    ASSERT_TRUE(ring.allocate(256 - 80, 16, offset));
+    EXPECT_EQ(offset, 80u);
+    EXPECT_FALSE(ring.allocate(1, 1, offset));
+    EXPECT_EQ(ring.head(), 256u);
+
+    ring.nextRegion();
+    EXPECT_TRUE(ring.allocate(256, 16, offset));
+    EXPECT_EQ(ring.regionOffset(), 256u);
+}
+
+TEST(RingAllocator, GrowthKeepsTheRegionAndEmptiesIt)
+{
+    RingAllocator ring(512, 3);
+    ring.nextRegion();
+    std::size_t offset = 0;
+    ASSERT_TRUE(ring.allocate(200, 16, offset));
+
+    /** fits leaves room for a worst case region alignment of padding */
+    EXPECT_TRUE(ring.fits(512 - 200 - RingAllocator::regionAlignment));
+    EXPECT_FALSE(ring.fits(512 - 200 - RingAllocator::regionAlignment + 1));
+
+    ring.grow(100);
+    EXPECT_EQ(ring.frameSize(), 1024u);
+    EXPECT_EQ(ring.region(), 1u);
+    EXPECT_EQ(ring.regionOffset(), 1024u);
+    EXPECT_EQ(ring.head(), 0u);
+
+    /** requests larger than twice the size get what they asked for, aligned */
+    ring.grow(5000);
+    EXPECT_EQ(ring.frameSize(), 5376u);
+    EXPECT_TRUE(ring.fits(5000));
+    EXPECT_TRUE(ring.allocate(5000, 256, offset));
+    EXPECT_EQ(offset, 0u);
+    EXPECT_EQ(ring.bufferSize(), 3 * 5376u);
+}
+
+TEST(RingAllocator, SingleRegionForOrphaning)
+{
+    /** the orphaning fallback gets fresh storage every frame, offsets restart at 0 */
+    RingAllocator ring(256, 1);
+    EXPECT_EQ(ring.bufferSize(), ring.frameSize());
+
+    for (int frame = 0; frame < 4; frame++)
+    {
+        EXPECT_EQ(ring.nextRegion(), 0u);
+        EXPECT_EQ(ring.regionOffset(), 0u);
+
+        std::size_t offset = 1;
+        ASSERT_TRUE(ring.allocate(128, 16, offset));
+        EXPECT_EQ(offset, 0u);
+    }
+
+    /** zero regions is treated as one */
+    RingAllocator zero(256, 0);
+    EXPECT_EQ(zero.regionCount(), 1u);
+}
+
+TEST(RingAllocator, ConcurrentAllocationsDoNotOverlap)
+{
+    constexpr int threadCount = 4;
+    constexpr int perThread   = 256;
+    RingAllocator ring(threadCount * perThread * 32, 1);
+
+    std::vector<std::vector<std::size_t>> offsets(threadCount);
+    std::vector<std::thread>              threads;
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t]() {
+            std::size_t offset;
+            for (int i = 0; i < perThread; i++)
+                if (ring.allocate(24, 16, offset)) offsets[t].push_back(offset);
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    std::vector<std::size_t> all;
+    for (auto &list : offsets) all.insert(all.end(), list.begin(), list.end());
+    ASSERT_EQ(all.size(), static_cast<std::size_t>(threadCount * perThread));
+
+    std::sort(all.begin(), all.end());
+    for (std::size_t i = 0; i < all.size(); i++)
+        EXPECT_EQ(all[i] % 16, 0u);
+    for (std::size_t i = 1; i < all.size(); i++)
+        EXPECT_GE(all[i], all[i - 1] + 24);
+}
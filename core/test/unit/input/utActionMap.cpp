@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <core/input/actionMap.hpp>
+
+#include <array>
+#include <cstdint>
+
+/** keyboard state with nothing held */
+static std::array<std::uint8_t, SDL_NUM_SCANCODES> noKeys() { return {}; }
+
+static InputSample sampleOf(const std::array<std::uint8_t, SDL_NUM_SCANCODES> &keys)
+{
+    InputSample sample;
+    sample.keys     = keys.data();
+    sample.keyCount = static_cast<int>(keys.size());
+    return sample;
+}
+
+TEST(ActionMapTest, NamesAreUnique)
+{
+    ActionMap map;
+    ActionID  jump = map.addAction("jump");
+    EXPECT_EQ(map.addAction("jump"), jump);
+    EXPECT_NE(map.addAction("fire"), jump);
+    EXPECT_EQ(map.findAction("fire"), 1u);
+    EXPECT_EQ(map.findAction("missing"), InvalidAction);
+    EXPECT_EQ(map.actionCount(), 2u);
+}
+
+TEST(ActionMapTest, KeyBindingsReportEdges)
+{
+    ActionMap map;
+    ActionID  jump = map.addAction("jump");
+    map.bindKey(jump, SDL_SCANCODE_W);
+
+    auto        keys = noKeys();
+    ActionState state;
+
+    keys[SDL_SCANCODE_W] = 1;
+    map.evaluate(sampleOf(keys), state);
+    EXPECT_TRUE(state.isDown(jump));
+    EXPECT_TRUE(state.wasPressed(jump));
+    EXPECT_FALSE(state.wasReleased(jump));
+
+    map.evaluate(sampleOf(keys), state);
+    EXPECT_TRUE(state.isDown(jump));
+    EXPECT_FALSE(state.wasPressed(jump));
+
+    keys[SDL_SCANCODE_W] = 0;
+    map.evaluate(sampleOf(keys), state);
+    EXPECT_FALSE(state.isDown(jump));
+    EXPECT_TRUE(state.wasReleased(jump));
+    EXPECT_EQ(state.frame, 3u);
+}
+
+TEST(ActionMapTest, ChordsShareKeysAndActions)
+{
+    ActionMap map;
+    ActionID  up   = map.addAction("up");
+    ActionID  menu = map.addAction("menu");
+    /** two keys drive one action, one key drives two actions */
+    map.bindKey(up, SDL_SCANCODE_W).bindKey(up, SDL_SCANCODE_S).bindKey(menu, SDL_SCANCODE_S);
+
+    auto        keys = noKeys();
+    ActionState state;
+
+    keys[SDL_SCANCODE_W] = 1;
+    map.evaluate(sampleOf(keys), state);
+    EXPECT_TRUE(state.isDown(up));
+    EXPECT_FALSE(state.isDown(menu));
+
+    keys[SDL_SCANCODE_S] = 1;
+    map.evaluate(sampleOf(keys), state);
+    EXPECT_TRUE(state.isDown(up));
+    EXPECT_FALSE(state.wasPressed(up)); /** still held through W */
+    EXPECT_TRUE(state.wasPressed(menu));
+
+    keys[SDL_SCANCODE_W] = 0;
+    map.evaluate(sampleOf(keys), state);
+    EXPECT_TRUE(state.isDown(up));
+    EXPECT_FALSE(state.wasReleased(up));
+}
+
+TEST(ActionMapTest, MouseAndControllerMasks)
+{
+    ActionMap map;
+    ActionID  fire  = map.addAction("fire");
+    ActionID  aim   = map.addAction("aim");
+    ActionID  pause = map.addAction("pause");
+    map.bindMouseButton(fire, SDL_BUTTON_LEFT)
+        .bindMouseButton(aim, SDL_BUTTON_RIGHT)
+        .bindControllerButton(fire, SDL_CONTROLLER_BUTTON_A)
+        .bindControllerButton(pause, SDL_CONTROLLER_BUTTON_START);
+
+    ActionState state;
+    InputSample sample;
+
+    sample.mouseButtons = SDL_BUTTON(SDL_BUTTON_RIGHT) | SDL_BUTTON(2); /** middle is unbound */
+    map.evaluate(sample, state);
+    EXPECT_FALSE(state.isDown(fire));
+    EXPECT_TRUE(state.isDown(aim));
+    EXPECT_FALSE(state.isDown(pause));
+
+    sample.mouseButtons      = 0;
+    sample.controllerButtons = (1u << SDL_CONTROLLER_BUTTON_A) | (1u << SDL_CONTROLLER_BUTTON_START)
+                               | (1u << SDL_CONTROLLER_BUTTON_B);
+    map.evaluate(sample, state);
+    EXPECT_TRUE(state.isDown(fire));
+    EXPECT_FALSE(state.isDown(aim));
+    EXPECT_TRUE(state.isDown(pause));
+}
+
+TEST(ActionMapTest, AxesSumBindingsWithDeadzone)
+{
+    ActionMap map;
+    AxisID    move = map.addAxis("move");
+    map.bindKeyAxis(move, SDL_SCANCODE_A, SDL_SCANCODE_D).bindControllerAxis(move, SDL_CONTROLLER_AXIS_LEFTX, 1.0f, 0.2f);
+
+    auto        keys = noKeys();
+    ActionState state;
+    InputSample sample = sampleOf(keys);
+
+    keys[SDL_SCANCODE_D]                             = 1;
+    sample.controllerAxes[SDL_CONTROLLER_AXIS_LEFTX] = 0.1f;
+    map.evaluate(sample, state);
+    EXPECT_FLOAT_EQ(state.axis(move), 1.0f);
+
+    sample.controllerAxes[SDL_CONTROLLER_AXIS_LEFTX] = -0.5f;
+    map.evaluate(sample, state);
+    EXPECT_FLOAT_EQ(state.axis(move), 0.5f);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <generated/config.h>
+#include <core/ui/text/fontLoader.hpp>
+
+#include <vector>
+
+using core::ui::FontLoader;
+
+/** renders Latin-1 with arial, on the JobPool or on the calling thread */
+static std::vector<FontLoader::Glyph> glyphs(bool parallel)
+{
+    FontLoader loader;
+    loader.openFont(CORE_UT_ASSETS_DIR "/fonts/arial.ttf", 32, 256).setPixelSize(0, 32).setParallel(parallel);
+    return loader.generateGlyphs();
+}
+
+TEST(FontLoaderTest, ParallelGlyphsMatchSerial)
+{
+    const std::vector<FontLoader::Glyph> serial   = glyphs(false);
+    const std::vector<FontLoader::Glyph> parallel = glyphs(true);
+
+    ASSERT_EQ(serial.size(), 256u - 32u);
+    ASSERT_EQ(parallel.size(), serial.size());
+
+    std::size_t rendered = 0;
+    for (std::size_t i = 0; i < serial.size(); i++)
+    {
+        const auto &s = serial[i];
+        const auto &p = parallel[i];
+        EXPECT_EQ(s.charCode, 32 + i);
+        EXPECT_EQ(p.charCode, s.charCode);
+        EXPECT_EQ(p.size, s.size) << s.charCode;
+        EXPECT_EQ(p.bearing, s.bearing) << s.charCode;
+        EXPECT_EQ(p.advance, s.advance) << s.charCode;
+        EXPECT_EQ(p.pitch, s.pitch) << s.charCode;
+        EXPECT_EQ(p.bitmap, s.bitmap) << s.charCode;
+        if (!s.bitmap.empty()) rendered++;
+    }
+    /** spaces have no bitmap, most of the range does */
+    EXPECT_GT(rendered, serial.size() / 2);
+}
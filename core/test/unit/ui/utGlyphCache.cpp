@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <generated/config.h>
+#include <core/graphics/renderer/recording/rec-assetManager.hpp>
+#include <core/ui/text/glyphCache.hpp>
+
+#include <string>
+#include <vector>
+
+using core::ui::GlyphCache;
+
+/** the repo font, read from the source tree so the test doesn't depend on the inventory */
+static AssetSpan arial() { return AssetInventory::getInstance().openAsset(CORE_UT_ASSETS_DIR "/fonts/arial.ttf"); }
+
+/** small pages so a handful of glyphs fill one */
+static GlyphCache::Settings smallPages(std::size_t pages)
+{
+    GlyphCache::Settings settings;
+    settings.pageSize     = 64;
+    settings.memoryBudget = pages * 64 * 64 * 4;
+    settings.sdf          = false;
+    return settings;
+}
+
+static bool overlaps(const glm::vec4 &a, const glm::vec4 &b)
+{
+    return a.x < b.z && b.x < a.z && a.y < b.w && b.y < a.w;
+}
+
+/**
+ * Every font is the same file under another name, so the same code point gives
+ * glyphs of the same size that are cached separately.
+ */
+class GlyphCacheTest : public ::testing::Test
+{
+protected:
+    static constexpr std::uint32_t size = 24;
+
+    RecordingAssetManager am;
+    AssetSpan             file = arial();
+
+    GlyphCache::FontID font(GlyphCache &cache, std::size_t i) { return cache.loadFont("arial" + std::to_string(i), file); }
+
+    /** copies of 'H' until one doesn't fit on the first page */
+    std::size_t pageCapacity()
+    {
+        GlyphCache  cache(am, smallPages(2));
+        std::size_t count = 0;
+        while (cache.get(font(cache, count), size, U'H').page == 0) count++;
+        return count;
+    }
+};
+
+TEST_F(GlyphCacheTest, FullPageAddsAnotherWithinBudget)
+{
+    GlyphCache cache(am, smallPages(2));
+
+    std::vector<GlyphCache::Glyph> glyphs;
+    for (std::size_t i = 0; cache.stats().pages < 2; i++)
+    {
+        ASSERT_LT(i, 64u);
+        glyphs.push_back(cache.get(font(cache, i), size, U'H'));
+    }
+    ASSERT_GT(glyphs.size(), 1u);
+    EXPECT_EQ(cache.stats().evictions, 0u);
+    EXPECT_EQ(cache.stats().bytes, 2 * 64 * 64 * 4u);
+    EXPECT_EQ(cache.generation(), 0u);
+
+    /** the glyphs before the last one share the first page without overlapping */
+    const GlyphCache::Glyph last = glyphs.back();
+    glyphs.pop_back();
+    for (std::size_t i = 0; i < glyphs.size(); i++)
+    {
+        EXPECT_EQ(glyphs[i].page, 0u);
+        EXPECT_EQ(glyphs[i].texture, glyphs[0].texture);
+        EXPECT_EQ(glyphs[i].size, last.size);
+        for (std::size_t j = 0; j < i; j++) EXPECT_FALSE(overlaps(glyphs[i].uvRect, glyphs[j].uvRect)) << i << " " << j;
+    }
+
+    /** the last one starts the new page in its top-left corner */
+    EXPECT_EQ(last.page, 1u);
+    EXPECT_NE(last.texture, glyphs[0].texture);
+    EXPECT_FLOAT_EQ(last.uvRect.x, 1.0f / 64.0f);
+    EXPECT_FLOAT_EQ(last.uvRect.w, 1.0f - 1.0f / 64.0f);
+    EXPECT_EQ(am.count(AssetType::Texture), 2u);
+}
+
+TEST_F(GlyphCacheTest, EvictionReusesTheShelfSlot)
+{
+    const std::size_t capacity = pageCapacity();
+    ASSERT_GT(capacity, 1u);
+
+    GlyphCache                     cache(am, smallPages(1));
+    std::vector<GlyphCache::Glyph> glyphs;
+    for (std::size_t i = 0; i < capacity; i++) glyphs.push_back(cache.get(font(cache, i), size, U'H'));
+    ASSERT_EQ(cache.stats().pages, 1u);
+    cache.update();
+
+    /** the least recently used glyph makes room, the new one takes its place */
+    for (std::size_t i = 1; i < capacity; i++) cache.get(font(cache, i), size, U'H');
+    GlyphCache::Glyph added = cache.get(font(cache, capacity), size, U'H');
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.stats().pages, 1u);
+    EXPECT_EQ(cache.stats().glyphs, capacity);
+    EXPECT_EQ(added.page, 0u);
+    EXPECT_EQ(added.uvRect, glyphs[0].uvRect);
+
+    /** the evicted glyph is rasterized again on its next use */
+    cache.update();
+    const std::size_t misses = cache.stats().misses;
+    cache.get(font(cache, 0), size, U'H');
+    EXPECT_EQ(cache.stats().misses, misses + 1);
+    EXPECT_EQ(cache.stats().evictions, 2u);
+}
+
+TEST_F(GlyphCacheTest, EvictionBumpsTheGeneration)
+{
+    const std::size_t capacity = pageCapacity();
+
+    GlyphCache cache(am, smallPages(1));
+    for (std::size_t i = 0; i < capacity; i++) cache.get(font(cache, i), size, U'H');
+    cache.update();
+
+    /** hits keep the generation */
+    const std::uint64_t generation = cache.generation();
+    for (std::size_t i = 0; i < capacity; i++) cache.get(font(cache, i), size, U'H');
+    EXPECT_EQ(cache.generation(), generation);
+    EXPECT_EQ(cache.stats().hits, capacity);
+
+    cache.update();
+    cache.get(font(cache, capacity), size, U'H');
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_GT(cache.generation(), generation);
+
+    /** glyphs used this frame are never evicted, the page goes over budget instead */
+    const std::uint64_t evicted = cache.generation();
+    for (std::size_t i = 1; i <= capacity; i++) cache.get(font(cache, i), size, U'H');
+    cache.get(font(cache, capacity + 1), size, U'H');
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.stats().pages, 2u);
+    EXPECT_EQ(cache.generation(), evicted);
+
+    cache.clear();
+    EXPECT_GT(cache.generation(), evicted);
+    EXPECT_EQ(cache.stats().glyphs, 0u);
+}
+
+TEST_F(GlyphCacheTest, UpdateUploadsOnlyChangedShelves)
+{
+    GlyphCache cache(am, smallPages(1));
+    cache.get(font(cache, 0), size, U'H');
+    cache.update();
+    EXPECT_EQ(cache.stats().uploads, 1u);
+
+    /** nothing changed, nothing uploaded */
+    const std::size_t bytes = am.textureBytes();
+    cache.update();
+    EXPECT_EQ(cache.stats().uploads, 1u);
+    EXPECT_EQ(am.textureBytes(), bytes);
+
+    /** a smaller glyph starts a new shelf, only its rows are uploaded */
+    const std::size_t uploaded = cache.stats().uploadBytes;
+    cache.get(font(cache, 0), size / 2, U'.');
+    cache.update();
+    EXPECT_EQ(cache.stats().uploads, 2u);
+    EXPECT_GT(cache.stats().uploadBytes, uploaded);
+    EXPECT_LT(cache.stats().uploadBytes - uploaded, 64 * 64 * 4u);
+    EXPECT_EQ(cache.stats().uploadBytes - uploaded, am.textureBytes() - bytes);
+}
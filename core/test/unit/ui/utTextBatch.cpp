@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <generated/config.h>
+#include <core/ui/text/textBatch.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using core::ui::TextBatch;
+using core::ui::TextLayout;
+
+/** layout with one 10x10 glyph per texture in @p pages, side by side */
+static std::shared_ptr<const TextLayout::Layout> layout(const std::vector<AssetID> &pages)
+{
+    auto result = std::make_shared<TextLayout::Layout>();
+    for (std::size_t i = 0; i < pages.size(); i++)
+    {
+        glm::vec2 min(i * 10.0f, 0.0f);
+        result->quads.push_back({pages[i], min, min + glm::vec2(10.0f), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)});
+    }
+    result->size  = glm::vec2(pages.size() * 10.0f, 10.0f);
+    result->lines = 1;
+    return result;
+}
+
+TEST(TextBatchTest, QuadsAreGroupedByPage)
+{
+    TextBatch batch;
+    auto      a = batch.add();
+    auto      b = batch.add();
+    batch.set(a, layout({2, 1, 2}), glm::mat4(1.0f), glm::vec4(1.0f));
+    batch.set(b, layout({1, 2}), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 100.0f, 0.0f)), glm::vec4(1.0f));
+
+    auto mesh = batch.build();
+    ASSERT_EQ(mesh->quads(), 5u);
+    ASSERT_EQ(mesh->runs.size(), 2u);
+    EXPECT_EQ(mesh->runs[0].texture, 1);
+    EXPECT_EQ(mesh->runs[0].first, 0u);
+    EXPECT_EQ(mesh->runs[0].count, 2u);
+    EXPECT_EQ(mesh->runs[1].texture, 2);
+    EXPECT_EQ(mesh->runs[1].first, 2u);
+    EXPECT_EQ(mesh->runs[1].count, 3u);
+
+    /** texts keep their order within a run and are placed by their model matrix */
+    EXPECT_EQ(mesh->vertices[0].position, glm::vec3(10.0f, 0.0f, 0.0f));
+    EXPECT_EQ(mesh->vertices[4].position, glm::vec3(0.0f, 100.0f, 0.0f));
+    EXPECT_EQ(mesh->vertices[2 * 4 + 2].position, glm::vec3(10.0f, 10.0f, 0.0f));
+}
+
+TEST(TextBatchTest, UnchangedBatchKeepsItsMesh)
+{
+    TextBatch batch;
+    auto      text = batch.add();
+    batch.set(text, layout({1, 1}), glm::mat4(1.0f), glm::vec4(1.0f));
+
+    auto first = batch.build();
+    EXPECT_EQ(batch.build(), first);
+
+    batch.set(text, layout({1}), glm::mat4(1.0f), glm::vec4(1.0f));
+    auto second = batch.build();
+    EXPECT_NE(second->version, first->version);
+    EXPECT_EQ(second->quads(), 1u);
+    /** the previous mesh is still held here, it must not have been rebuilt in place */
+    EXPECT_EQ(first->quads(), 2u);
+
+    batch.remove(text);
+    EXPECT_EQ(batch.build()->quads(), 0u);
+    EXPECT_EQ(batch.size(), 0u);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <generated/config.h>
+#include <core/graphics/renderer/recording/rec-assetManager.hpp>
+#include <core/ui/text/textLayout.hpp>
+
+#include <string>
+
+using core::ui::GlyphCache;
+using core::ui::TextLayout;
+
+class TextLayoutTest : public ::testing::Test
+{
+protected:
+    static constexpr std::uint32_t size = 24;
+
+    RecordingAssetManager am;
+    GlyphCache            glyphs{am};
+    TextLayout            layouts{glyphs};
+    GlyphCache::FontID    font =
+        glyphs.loadFont("arial", AssetInventory::getInstance().openAsset(CORE_UT_ASSETS_DIR "/fonts/arial.ttf"));
+
+    std::shared_ptr<const TextLayout::Layout> layout(const std::string &text, float wrapWidth = 0.0f)
+    {
+        return layouts.layout(text, font, size, wrapWidth);
+    }
+
+    /** same glyphs at the same places */
+    static void expectSameQuads(const TextLayout::Layout &a, const TextLayout::Layout &b)
+    {
+        ASSERT_EQ(a.quads.size(), b.quads.size());
+        for (std::size_t i = 0; i < a.quads.size(); i++)
+        {
+            EXPECT_EQ(a.quads[i].texture, b.quads[i].texture) << i;
+            EXPECT_EQ(a.quads[i].uvRect, b.quads[i].uvRect) << i;
+            EXPECT_FLOAT_EQ(a.quads[i].min.x, b.quads[i].min.x) << i;
+            EXPECT_FLOAT_EQ(a.quads[i].min.y, b.quads[i].min.y) << i;
+            EXPECT_FLOAT_EQ(a.quads[i].max.x, b.quads[i].max.x) << i;
+            EXPECT_FLOAT_EQ(a.quads[i].max.y, b.quads[i].max.y) << i;
+        }
+    }
+};
+
+TEST_F(TextLayoutTest, DecodesUtf8)
+{
+    /** two, three and four byte sequences give the glyph of their code point */
+    const std::pair<std::string, char32_t> sequences[] = {
+        {"\xc3\xa9", U'é'},
+        {"\xe2\x82\xac", U'€'},
+        {"\xf0\x9f\x98\x80", U'\U0001f600'},
+    };
+    for (const auto &[text, codepoint] : sequences)
+    {
+        auto result = layout(text);
+        ASSERT_EQ(result->quads.size(), 1u) << text;
+        EXPECT_EQ(result->quads[0].uvRect, glyphs.get(font, size, codepoint).uvRect) << text;
+    }
+}
+
+TEST_F(TextLayoutTest, InvalidUtf8GivesReplacementCharacter)
+{
+    auto replacement = layout("\xef\xbf\xbd" "A");
+
+    /** lone continuation byte, invalid lead byte, truncated sequences before another character */
+    for (const std::string text : {"\x80" "A", "\xf8" "A", "\xc3" "A", "\xe2\x82" "A", "\xf0\x9f\x98" "A"})
+    {
+        SCOPED_TRACE(testing::PrintToString(text));
+        expectSameQuads(*layout(text), *replacement);
+    }
+
+    /** truncated at the end of the text */
+    expectSameQuads(*layout("A\xe2\x82"), *layout("A\xef\xbf\xbd"));
+}
+
+TEST_F(TextLayoutTest, NewLinesMoveDownByLineHeight)
+{
+    const float lineHeight = glyphs.lineHeight(font, size);
+    auto        hello      = layout("hello");
+    auto        lines      = layout("hello\nhello");
+
+    EXPECT_EQ(hello->lines, 1u);
+    EXPECT_FLOAT_EQ(hello->size.y, lineHeight);
+    EXPECT_EQ(lines->lines, 2u);
+    EXPECT_FLOAT_EQ(lines->size.y, 2 * lineHeight);
+    EXPECT_FLOAT_EQ(lines->size.x, hello->size.x);
+
+    ASSERT_EQ(lines->quads.size(), 2 * hello->quads.size());
+    for (std::size_t i = 0; i < hello->quads.size(); i++)
+    {
+        const auto &second = lines->quads[hello->quads.size() + i];
+        EXPECT_FLOAT_EQ(second.min.x, hello->quads[i].min.x);
+        EXPECT_FLOAT_EQ(second.min.y, hello->quads[i].min.y - lineHeight);
+    }
+}
+
+TEST_F(TextLayoutTest, WrapsBetweenWords)
+{
+    const float full = layout("hello world")->size.x;
+
+    /** wide enough, one line */
+    EXPECT_EQ(layout("hello world", full)->lines, 1u);
+
+    /** the last word moves to the next line as if there was a line break */
+    auto wrapped = layout("hello world", full - 1.0f);
+    auto broken  = layout("hello\nworld");
+    EXPECT_EQ(wrapped->lines, 2u);
+    EXPECT_FLOAT_EQ(wrapped->size.x, broken->size.x);
+    EXPECT_FLOAT_EQ(wrapped->size.y, broken->size.y);
+    expectSameQuads(*wrapped, *broken);
+
+    /** a word wider than the line is broken where it overflows */
+    const float word = layout("abcdefghij")->size.x;
+    auto        narrow = layout("abcdefghij", word / 2);
+    EXPECT_GE(narrow->lines, 2u);
+    EXPECT_LE(narrow->size.x, word / 2);
+    EXPECT_EQ(narrow->quads.size(), 10u);
+}
+
+TEST_F(TextLayoutTest, LayoutsAreCachedByTextFontSizeAndWrap)
+{
+    auto first = layout("cached");
+    EXPECT_EQ(layouts.stats().misses, 1u);
+    EXPECT_EQ(layout("cached"), first);
+    EXPECT_EQ(layouts.stats().hits, 1u);
+
+    /** every part of the key gives its own layout */
+    GlyphCache::FontID other =
+        glyphs.loadFont("arial2", AssetInventory::getInstance().openAsset(CORE_UT_ASSETS_DIR "/fonts/arial.ttf"));
+    EXPECT_NE(layout("cached!"), first);
+    EXPECT_NE(layouts.layout("cached", other, size), first);
+    EXPECT_NE(layouts.layout("cached", font, size + 1), first);
+    EXPECT_NE(layout("cached", 1000.0f), first);
+    EXPECT_EQ(layouts.stats().misses, 5u);
+    EXPECT_EQ(layouts.stats().entries, 5u);
+    EXPECT_EQ(layout("cached", 1000.0f), layout("cached", 1000.0f));
+
+    /** layouts made before the glyphs were cleared are shaped again */
+    glyphs.clear();
+    EXPECT_FALSE(layouts.valid(*first));
+    auto reshaped = layout("cached");
+    EXPECT_NE(reshaped, first);
+    EXPECT_TRUE(layouts.valid(*reshaped));
+    EXPECT_EQ(layouts.stats().misses, 6u);
+}
+
+TEST_F(TextLayoutTest, LeastRecentlyUsedLayoutsAreDropped)
+{
+    TextLayout small(glyphs, TextLayout::Settings{2});
+    auto       a = small.layout("a", font, size);
+    auto       b = small.layout("b", font, size);
+    EXPECT_EQ(small.layout("a", font, size), a);
+
+    /** b is the least recently used */
+    small.layout("c", font, size);
+    EXPECT_EQ(small.stats().entries, 2u);
+    EXPECT_EQ(small.layout("a", font, size), a);
+    EXPECT_NE(small.layout("b", font, size), b);
+    EXPECT_EQ(small.stats().misses, 4u);
+
+    small.clear();
+    EXPECT_EQ(small.stats().entries, 0u);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <generated/config.h>
+#include <core/utils/jobs.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using core::utils::JobPool;
+
+TEST(JobPoolTest, ParallelForCallsEveryIndexOnce)
+{
+    JobPool pool(3);
+    ASSERT_EQ(pool.size(), 3u);
+
+    for (std::size_t count : {0, 1, 2, 1000})
+    {
+        std::vector<std::atomic<int>> calls(count);
+        pool.parallelFor(count, [&](std::size_t index) { calls[index]++; });
+        for (std::size_t i = 0; i < count; i++) EXPECT_EQ(calls[i].load(), 1) << "count " << count << " index " << i;
+    }
+}
+
+TEST(JobPoolTest, ParallelForRethrowsAfterAllCalls)
+{
+    JobPool          pool(3);
+    std::atomic<int> calls{0};
+
+    EXPECT_THROW(pool.parallelFor(100,
+                                  [&](std::size_t index) {
+                                      calls++;
+                                      if (index % 10 == 3) throw std::runtime_error("job failed");
+                                  }),
+                 std::runtime_error);
+    /** a throwing call doesn't stop the others */
+    EXPECT_EQ(calls.load(), 100);
+
+    /** the pool is still usable afterwards */
+    calls = 0;
+    pool.parallelFor(10, [&](std::size_t) { calls++; });
+    EXPECT_EQ(calls.load(), 10);
+}
+
+TEST(JobPoolTest, SubmitReturnsResultsAndExceptions)
+{
+    JobPool pool(2);
+
+    auto value  = pool.submit([]() { return 42; });
+    auto failed = pool.submit([]() -> int { throw std::logic_error("job failed"); });
+    auto done   = pool.submit([]() {});
+
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_THROW(failed.get(), std::logic_error);
+    done.get();
+}
+
+TEST(JobPoolTest, NestedJobsDoNotDeadlock)
+{
+    /** one worker, nested calls only finish if waiting threads run queued jobs */
+    JobPool pool(1);
+
+    /** a job submitting another one */
+    auto outer = pool.submit([&pool]() { return pool.submit([]() { return 7; }); });
+    EXPECT_EQ(outer.get().get(), 7);
+
+    /** parallelFor inside a job and inside parallelFor */
+    std::vector<std::atomic<int>> calls(16);
+    auto                          job = pool.submit([&]() {
+        pool.parallelFor(4, [&](std::size_t i) {
+            pool.parallelFor(4, [&](std::size_t j) { calls[i * 4 + j]++; });
+        });
+    });
+    job.get();
+    for (std::size_t i = 0; i < calls.size(); i++) EXPECT_EQ(calls[i].load(), 1) << i;
+}
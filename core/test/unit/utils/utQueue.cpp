@@ -4,6 +4,10 @@
 #include <generated/config.h>
 #include <core/utils/queue.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 TEST(AtomicQueueTest, PushTestInt)
 {
     core::utils::atomic_queue<int> aQueue;
@@ -88,4 +92,147 @@ TEST(AtomicQueueTest, PushTestCopyableMoveable)
     };
 
     core::utils::atomic_queue<payloadStruct> aQueue;
-}
\ No newline at end of file
+}
+
+TEST(SpscRingTest, PushPopFull)
+{
+    core::utils::spsc_ring<int, 4> ring;
+
+    int pushVal = 0;
+    ASSERT_EQ(ring.try_push(pushVal), true);
+    ASSERT_EQ(ring.try_push(1), true);
+    ASSERT_EQ(ring.try_push(2), true);
+    ASSERT_EQ(ring.try_push(3), true);
+    ASSERT_EQ(ring.try_push(4), false);
+    ASSERT_EQ(ring.was_size(), 4u);
+
+    int popVal;
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(ring.try_pop(popVal), true);
+        ASSERT_EQ(popVal, i);
+    }
+    ASSERT_EQ(ring.try_pop(popVal), false);
+    ASSERT_EQ(ring.was_empty(), true);
+}
+
+TEST(SpscRingTest, StressOrdered)
+{
+    constexpr unsigned int                    count = 100000;
+    core::utils::spsc_ring<unsigned int, 256> ring;
+    std::atomic<bool>                         stop{false};
+
+    // the producer gives up if the consumer stopped early, the ring would stay full
+    std::thread producer([&ring, &stop]() {
+        for (unsigned int i = 0; i < count; i++)
+            while (!ring.try_push(i))
+            {
+                if (stop) return;
+                std::this_thread::yield();
+            }
+    });
+
+    unsigned int expected = 0;
+    unsigned int popVal;
+    while (expected < count)
+    {
+        if (!ring.try_pop(popVal))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_EQ(popVal, expected);
+        if (popVal != expected) break;
+        expected++;
+    }
+    stop = true;
+    producer.join();
+
+    ASSERT_EQ(expected, count);
+    ASSERT_EQ(ring.try_pop(popVal), false);
+}
+
+namespace
+{
+    struct mpscPayload : core::utils::mpsc_node
+    {
+        unsigned int producer;
+        unsigned int sequence;
+    };
+} // namespace
+
+TEST(MpscQueueTest, PushPop)
+{
+    core::utils::mpsc_queue<mpscPayload> mQueue;
+    mpscPayload                          a, b;
+    a.sequence = 1;
+    b.sequence = 2;
+
+    ASSERT_EQ(mQueue.was_empty(), true);
+    mQueue.try_push(&a);
+    mQueue.try_push(&b);
+    ASSERT_EQ(mQueue.was_size(), 2u);
+
+    mpscPayload *popVal;
+    ASSERT_EQ(mQueue.try_pop(popVal), true);
+    ASSERT_EQ(popVal, &a);
+    ASSERT_EQ(mQueue.try_pop(popVal), true);
+    ASSERT_EQ(popVal, &b);
+    ASSERT_EQ(mQueue.try_pop(popVal), false);
+    ASSERT_EQ(mQueue.was_empty(), true);
+
+    // nodes can be pushed again once popped
+    mQueue.try_push(&a);
+    ASSERT_EQ(mQueue.try_pop(popVal), true);
+    ASSERT_EQ(popVal, &a);
+}
+
+TEST(MpscQueueTest, StressMultiProducer)
+{
+    constexpr unsigned int producerCount = 4;
+    constexpr unsigned int count         = 25000;
+
+    core::utils::mpsc_queue<mpscPayload> mQueue;
+    std::vector<mpscPayload>             nodes(producerCount * count);
+
+    std::vector<std::thread> producers;
+    for (unsigned int p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&mQueue, &nodes, p]() {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                mpscPayload &node = nodes[p * count + i];
+                node.producer     = p;
+                node.sequence     = i;
+                mQueue.try_push(&node);
+            }
+        });
+    }
+
+    // each producer's elements must arrive in order and exactly once
+    std::vector<unsigned int> nextSequence(producerCount, 0);
+    unsigned int              received = 0;
+    mpscPayload              *popVal;
+    while (received < producerCount * count)
+    {
+        if (!mQueue.try_pop(popVal))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_LT(popVal->producer, producerCount);
+        if (popVal->producer >= producerCount) break;
+        EXPECT_EQ(popVal->sequence, nextSequence[popVal->producer]);
+        if (popVal->sequence != nextSequence[popVal->producer]) break;
+        nextSequence[popVal->producer]++;
+        received++;
+    }
+    // producers never block on the queue, they finish even if the loop stopped early
+    for (auto &t : producers)
+        t.join();
+
+    ASSERT_EQ(received, producerCount * count);
+    ASSERT_EQ(mQueue.try_pop(popVal), false);
+    for (auto s : nextSequence)
+        ASSERT_EQ(s, count);
+}
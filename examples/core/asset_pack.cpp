@@ -0,0 +1,82 @@
+/**
+ * @file examples/core/asset_pack.cpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * Packs an asset directory into one asset pack, see core::assets::AssetPack.
+ *
+ * Entries are named by their path relative to the parent of the asset
+ * directory, so packing build/assets gives the "assets/textures/..." paths
+ * the AssetInventory looks up. Files are stored in path order so a cold start
+ * reads the pack front to back. Prints a summary as json on stdout.
+ *
+ * Usage: asset_pack [--lz4] <asset directory> <pack file>
+ */
+
+#include <core/assets/assetPack.hpp>
+#include <core/utils/logging.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char **argv)
+{
+    bool                     lz4 = false;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--lz4"))
+            lz4 = true;
+        else
+            args.push_back(argv[i]);
+    }
+    if (args.size() != 2 || !fs::is_directory(args[0]))
+    {
+        std::fprintf(stderr, "Usage: %s [--lz4] <asset directory> <pack file>\n", argv[0]);
+        return 1;
+    }
+    core::utils::logging::setLevel(core::utils::logging::level::WARN);
+
+    /** a trailing separator leaves an empty file name, the parent would be the directory itself */
+    fs::path assetDirectory = fs::absolute(args[0]).lexically_normal();
+    if (!assetDirectory.has_filename()) assetDirectory = assetDirectory.parent_path();
+    const fs::path root = assetDirectory.parent_path();
+
+    std::vector<fs::path> files;
+    for (const auto &entry : fs::recursive_directory_iterator(assetDirectory))
+        if (entry.is_regular_file()) files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+
+    try
+    {
+        core::assets::AssetPackWriter writer;
+        for (const fs::path &file : files)
+        {
+            std::ifstream     f(file, std::ios::binary);
+            std::vector<char> data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+            writer.add(fs::relative(file, root).generic_string(), std::move(data), lz4);
+        }
+
+        auto stats = writer.write(args[1]);
+        std::printf("{\"pack\": \"%s\", \"entries\": %zu, \"compressed\": %zu, \"size\": %zu, \"stored_size\": %zu}\n",
+                    args[1].c_str(),
+                    stats.entries,
+                    stats.compressed,
+                    stats.size,
+                    stats.storedSize);
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
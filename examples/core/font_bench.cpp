@@ -0,0 +1,117 @@
+/**
+ * @file examples/core/font_bench.cpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * Benchmark for FontLoader::generateFont, serial against the JobPool.
+ *
+ * Builds SDF glyph atlases for a few code point ranges and prints the results as
+ * json on stdout:
+ *  - serial_ms / parallel_ms: median time of generateFont over the runs
+ *  - speedup: serial_ms / parallel_ms
+ *
+ * Code points missing from the font render its missing glyph, so every range
+ * does the same amount of work per code point whatever the font covers.
+ *
+ * Usage: font_bench [--font PATH] [--size N] [--runs N]
+ */
+
+#include <core/ui/text/fontLoader.hpp>
+#include <core/utils/jobs.hpp>
+#include <core/utils/logging.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::string  font;
+        unsigned int size = 32;
+        unsigned int runs = 5;
+    };
+
+    struct Range
+    {
+        const char *name;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    const Range ranges[] = {
+        {"ascii",   0x20, 0x7f         },
+        {"latin1",  0x20, 0x100        },
+        {"range5k", 0x20, 0x20 + 5000  },
+    };
+
+    /** median milliseconds of generateFont over @p runs */
+    double measure(const Options &opt, const Range &range, bool parallel)
+    {
+        std::vector<double> samples;
+        for (unsigned int run = 0; run < opt.runs; run++)
+        {
+            core::ui::FontLoader loader;
+            loader.openFont(opt.font, range.begin, range.end).setPixelSize(0, opt.size).setParallel(parallel);
+
+            auto start = std::chrono::steady_clock::now();
+            loader.generateFont();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    Options parseOptions(int argc, char **argv)
+    {
+        Options opt;
+        opt.font = (std::filesystem::path(argv[0]).parent_path() / "assets" / "fonts" / "arial.ttf").string();
+        for (int i = 1; i < argc; i++)
+        {
+            if (!std::strcmp(argv[i], "--font") && i + 1 < argc)
+                opt.font = argv[++i];
+            else if (!std::strcmp(argv[i], "--size") && i + 1 < argc)
+                opt.size = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc)
+                opt.runs = static_cast<unsigned int>(std::max(1ul, std::strtoul(argv[++i], nullptr, 10)));
+            else
+            {
+                std::fprintf(stderr, "Usage: %s [--font PATH] [--size N] [--runs N]\n", argv[0]);
+                std::exit(1);
+            }
+        }
+        return opt;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options opt = parseOptions(argc, argv);
+    core::utils::logging::setLevel(core::utils::logging::level::WARN);
+
+    std::printf("{\n  \"font\": \"%s\",\n  \"size\": %u,\n  \"workers\": %zu,\n  \"ranges\": {\n",
+                opt.font.c_str(),
+                opt.size,
+                core::utils::JobPool::getInstance().size());
+    for (std::size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+    {
+        const Range &range    = ranges[i];
+        double       serial   = measure(opt, range, false);
+        double       parallel = measure(opt, range, true);
+        std::printf("    \"%s\": {\"glyphs\": %zu, \"serial_ms\": %.3f, \"parallel_ms\": %.3f, \"speedup\": %.2f}%s\n",
+                    range.name,
+                    range.end - range.begin,
+                    serial,
+                    parallel,
+                    parallel > 0 ? serial / parallel : 0.0,
+                    i + 1 < sizeof(ranges) / sizeof(ranges[0]) ? "," : "");
+    }
+    std::printf("  }\n}\n");
+    return 0;
+}
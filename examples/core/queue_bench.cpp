@@ -0,0 +1,338 @@
+/**
+ * @file examples/core/queue_bench.cpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * Throughput and latency benchmark for the queues in core/utils/queue.hpp.
+ *
+ * Sweeps producer/consumer counts and payload sizes for every queue implementation
+ * enabled in the config and prints the results as json on stdout:
+ *  - ops_per_sec: messages dequeued per second, first push to last pop
+ *  - latency_ns: enqueue-to-dequeue latency percentiles over all runs
+ *
+ * Usage: queue_bench [--messages N] [--runs N] [--queue NAME] [--oversubscribe]
+ */
+
+#include <generated/config.h>
+#include <core/utils/queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    typedef std::chrono::steady_clock clock_type;
+    typedef std::int64_t              time_point;
+
+    const clock_type::time_point programStart = clock_type::now();
+
+    /** nanoseconds since program start */
+    time_point getTime()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - programStart).count();
+    }
+
+    template <std::size_t _Pad>
+    struct PayloadPad
+    {
+        unsigned char pad[_Pad] = {};
+    };
+
+    template <>
+    struct PayloadPad<0>
+    {
+    };
+
+    /** message with enqueue timestamp, padded up to @p _Size bytes */
+    template <std::size_t _Size>
+    struct Payload : PayloadPad<_Size - 16>
+    {
+        time_point    stamp = 0;
+        std::uint64_t seq   = 0;
+    };
+
+    /** adapter for queues storing payloads by value */
+    template <typename _Queue, typename _Payload>
+    struct ValueAdapter
+    {
+        _Queue queue;
+
+        void prepare(unsigned int, unsigned int) {}
+        bool push(unsigned int, _Payload &p) { return queue.try_push(p); }
+        bool pop(_Payload &p) { return queue.try_pop(p); }
+    };
+
+#if defined(CONFIG_CORE_QUEUE_LOCKFREE_ENABLE)
+    /** adapter for the intrusive mpsc_queue, nodes are preallocated per producer */
+    template <typename _Payload>
+    struct MpscAdapter
+    {
+        struct Node : core::utils::mpsc_node
+        {
+            _Payload payload;
+        };
+
+        core::utils::mpsc_queue<Node> queue;
+        std::vector<Node>             nodes;
+        unsigned int                  perProducer = 0;
+
+        void prepare(unsigned int producers, unsigned int messages)
+        {
+            nodes       = std::vector<Node>(static_cast<std::size_t>(producers) * messages);
+            perProducer = messages;
+        }
+
+        bool push(unsigned int producer, _Payload &p)
+        {
+            Node &n   = nodes[static_cast<std::size_t>(producer) * perProducer + p.seq];
+            n.payload = p;
+            return queue.try_push(&n);
+        }
+
+        bool pop(_Payload &p)
+        {
+            Node *n;
+            if (!queue.try_pop(n)) return false;
+            p = n->payload;
+            return true;
+        }
+    };
+#endif
+
+    struct Options
+    {
+        unsigned int messages      = 200000;
+        unsigned int runs          = 3;
+        std::string  queueFilter   = "";
+        bool         oversubscribe = false;
+    };
+
+    struct Result
+    {
+        std::string             queue;
+        unsigned int            producers;
+        unsigned int            consumers;
+        std::size_t             payloadSize;
+        double                  opsPerSec;
+        std::vector<time_point> latencies;
+    };
+
+    template <typename _Adapter, typename _Payload>
+    void runOnce(unsigned int producers, unsigned int consumers, unsigned int messages, Result &result)
+    {
+        _Adapter adapter;
+        adapter.prepare(producers, messages);
+
+        std::atomic<bool>         go{false};
+        std::atomic<bool>         producersDone{false};
+        std::atomic<unsigned int> producersLeft{producers};
+        std::atomic<time_point>   firstPush{0};
+        std::atomic<time_point>   lastPop{0};
+
+        std::vector<std::vector<time_point>> latencies(consumers);
+        std::vector<std::thread>             threads;
+
+        for (unsigned int p = 0; p < producers; p++)
+        {
+            threads.emplace_back([&, p]() {
+                while (!go.load(std::memory_order_acquire)) {}
+                time_point expected = 0;
+                firstPush.compare_exchange_strong(expected, getTime(), std::memory_order_relaxed);
+
+                _Payload payload;
+                for (unsigned int i = 0; i < messages; i++)
+                {
+                    payload.seq = i;
+                    do
+                    {
+                        payload.stamp = getTime();
+                    } while (!adapter.push(p, payload));
+                }
+                if (producersLeft.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    producersDone.store(true, std::memory_order_release);
+            });
+        }
+
+        for (unsigned int c = 0; c < consumers; c++)
+        {
+            latencies[c].reserve(static_cast<std::size_t>(producers) * messages / consumers + 1);
+            threads.emplace_back([&, c]() {
+                while (!go.load(std::memory_order_acquire)) {}
+                auto    &samples = latencies[c];
+                _Payload payload;
+                for (;;)
+                {
+                    if (adapter.pop(payload))
+                    {
+                        samples.push_back(getTime() - payload.stamp);
+                        continue;
+                    }
+                    if (!producersDone.load(std::memory_order_acquire)) continue;
+                    // producers are done, an empty pop now means the queue is drained
+                    if (!adapter.pop(payload)) break;
+                    samples.push_back(getTime() - payload.stamp);
+                }
+                time_point end  = getTime();
+                time_point last = lastPop.load(std::memory_order_relaxed);
+                while (end > last && !lastPop.compare_exchange_weak(last, end, std::memory_order_relaxed)) {}
+            });
+        }
+
+        go.store(true, std::memory_order_release);
+        for (auto &t : threads)
+            t.join();
+
+        std::size_t total = 0;
+        for (auto &l : latencies)
+        {
+            total += l.size();
+            result.latencies.insert(result.latencies.end(), l.begin(), l.end());
+        }
+        if (total != static_cast<std::size_t>(producers) * messages)
+        {
+            std::fprintf(stderr, "%s: lost messages (%zu of %zu)\n", result.queue.c_str(), total,
+                         static_cast<std::size_t>(producers) * messages);
+            std::exit(EXIT_FAILURE);
+        }
+
+        double seconds = static_cast<double>(lastPop.load() - firstPush.load()) / 1e9;
+        result.opsPerSec += static_cast<double>(total) / seconds;
+    }
+
+    time_point percentile(std::vector<time_point> &samples, double p)
+    {
+        if (samples.empty()) return 0;
+        std::size_t idx = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + idx, samples.end());
+        return samples[idx];
+    }
+
+    void printResult(Result &r, bool first)
+    {
+        time_point p50  = percentile(r.latencies, 0.50);
+        time_point p90  = percentile(r.latencies, 0.90);
+        time_point p99  = percentile(r.latencies, 0.99);
+        time_point p999 = percentile(r.latencies, 0.999);
+        time_point max  = r.latencies.empty() ? 0 : *std::max_element(r.latencies.begin(), r.latencies.end());
+
+        std::printf("%s    {\"queue\": \"%s\", \"producers\": %u, \"consumers\": %u, \"payload_bytes\": %zu, "
+                    "\"ops_per_sec\": %.0f, \"latency_ns\": {\"p50\": %lld, \"p90\": %lld, \"p99\": %lld, "
+                    "\"p999\": %lld, \"max\": %lld}}",
+                    first ? "" : ",\n",
+                    r.queue.c_str(),
+                    r.producers,
+                    r.consumers,
+                    r.payloadSize,
+                    r.opsPerSec,
+                    static_cast<long long>(p50),
+                    static_cast<long long>(p90),
+                    static_cast<long long>(p99),
+                    static_cast<long long>(p999),
+                    static_cast<long long>(max));
+        std::fflush(stdout);
+    }
+
+    /**
+     * @brief Runs the producer/consumer sweep for one queue adapter and payload size
+     *
+     * @param maxProducers maximum producers supported by the queue, 0 for unlimited
+     * @param maxConsumers maximum consumers supported by the queue, 0 for unlimited
+     */
+    template <typename _Adapter, typename _Payload>
+    void sweep(const char *name, unsigned int maxProducers, unsigned int maxConsumers, const Options &opt, bool &first)
+    {
+        if (!opt.queueFilter.empty() && opt.queueFilter != name) return;
+
+        static const unsigned int producerCounts[] = {1, 2, 4, 8};
+        static const unsigned int consumerCounts[] = {1, 2, 4};
+        const unsigned int        hwThreads        = std::max(2u, std::thread::hardware_concurrency());
+
+        for (unsigned int producers : producerCounts)
+        {
+            if (maxProducers && producers > maxProducers) continue;
+            for (unsigned int consumers : consumerCounts)
+            {
+                if (maxConsumers && consumers > maxConsumers) continue;
+                // spinning threads on shared cores only measure the scheduler
+                if (!opt.oversubscribe && producers + consumers > hwThreads) continue;
+
+                Result r{name, producers, consumers, sizeof(_Payload), 0.0, {}};
+                r.latencies.reserve(static_cast<std::size_t>(opt.runs) * producers * opt.messages);
+                for (unsigned int run = 0; run < opt.runs; run++)
+                    runOnce<_Adapter, _Payload>(producers, consumers, opt.messages, r);
+                r.opsPerSec /= opt.runs;
+
+                printResult(r, first);
+                first = false;
+            }
+        }
+    }
+
+    template <std::size_t _Size>
+    void sweepQueues(const Options &opt, bool &first)
+    {
+        typedef Payload<_Size> payload_type;
+        static_assert(sizeof(payload_type) == _Size, "unexpected payload padding");
+#if defined(CONFIG_CORE_QUEUE_STDMUTEX_ENABLE)
+        sweep<ValueAdapter<core::utils::mutex_queue<payload_type>, payload_type>, payload_type>(
+            "mutex_queue", 0, 0, opt, first);
+#endif
+#if defined(CONFIG_CORE_QUEUE_LOCKFREE_ENABLE)
+        sweep<ValueAdapter<core::utils::atomic_queue<payload_type>, payload_type>, payload_type>(
+            "atomic_queue", 0, 0, opt, first);
+        sweep<ValueAdapter<core::utils::spsc_ring<payload_type, 1024>, payload_type>, payload_type>(
+            "spsc_ring", 1, 1, opt, first);
+        sweep<MpscAdapter<payload_type>, payload_type>("mpsc_queue", 0, 1, opt, first);
+#endif
+    }
+
+    Options parseOptions(int argc, char **argv)
+    {
+        Options opt;
+        for (int i = 1; i < argc; i++)
+        {
+            if (!std::strcmp(argv[i], "--messages") && i + 1 < argc)
+                opt.messages = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc)
+                opt.runs = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (!std::strcmp(argv[i], "--queue") && i + 1 < argc)
+                opt.queueFilter = argv[++i];
+            else if (!std::strcmp(argv[i], "--oversubscribe"))
+                opt.oversubscribe = true;
+            else
+            {
+                std::fprintf(stderr,
+                             "usage: %s [--messages N] [--runs N] [--queue NAME] [--oversubscribe]\n",
+                             argv[0]);
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        opt.messages = std::max(1u, opt.messages);
+        opt.runs     = std::max(1u, opt.runs);
+        return opt;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options opt   = parseOptions(argc, argv);
+    bool    first = true;
+
+    std::printf("{\n  \"messages_per_producer\": %u,\n  \"runs\": %u,\n  \"hardware_threads\": %u,\n  \"results\": [\n",
+                opt.messages,
+                opt.runs,
+                std::thread::hardware_concurrency());
+    sweepQueues<16>(opt, first);
+    sweepQueues<64>(opt, first);
+    sweepQueues<256>(opt, first);
+    std::printf("\n  ]\n}\n");
+
+    return 0;
+}
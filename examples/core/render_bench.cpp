@@ -0,0 +1,262 @@
+/**
+ * @file examples/core/render_bench.cpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * Offscreen benchmark for the OpenGL renderer.
+ *
+ * Renders a scripted scene (a grid of textured cubes seen by an orbiting camera)
+ * for a fixed number of frames and prints the results as json on stdout:
+ *  - submit_ms / extract_ms / present_ms: per-frame CPU time percentiles
+ *  - draw_calls, instanced_draws, visible, culled, state_changes: per-frame averages
+ *  - checksums: FNV-1a hash of every frame's pixels in frame order, identical
+ *    across runs of the same build on the same GL stack
+ *
+ * The scene only depends on the frame number, never on wall time, so checksums
+ * can be compared between runs. Checksums are collected per frame number from
+ * the renderer, so they don't depend on the frames in flight either. With
+ * CONFIG_CORE_RENDER_THREAD the stats are those of the last presented frame and
+ * trail by the frames in flight.
+ *
+ * Runs without a display when CORE_RENDER_OFFSCREEN is set (the default here),
+ * e.g. on Mesa llvmpipe:
+ *      LIBGL_ALWAYS_SOFTWARE=1 EGL_PLATFORM=surfaceless render_bench
+ *
+ * Usage: render_bench [--frames N] [--grid N] [--texture NAME] [--onscreen]
+ */
+
+#include <generated/config.h>
+#include <core/game.hpp>
+#include <core/ecs/entity.hpp>
+#include <core/ecs/entityManager.hpp>
+#include <core/ecs/componentManager.hpp>
+#include <core/ecs/components.hpp>
+#include <core/graphics/renderer.hpp>
+#include <core/graphics/renderer/opengl/gl-renderer.hpp>
+#include <core/assets/mesh.hpp>
+#include <core/utils/logging.hpp>
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        unsigned int frames   = 300;
+        unsigned int grid     = 16; /** cubes per side, grid^3 cubes */
+        std::string  texture  = "crate.png";
+        bool         onscreen = false;
+    };
+
+    /** unit cube centered on the origin, 4 vertices per face for flat normals */
+    core::assets::Mesh cubeMesh()
+    {
+        const glm::vec3 normals[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+        std::vector<Vertex>        vertices;
+        std::vector<std::uint32_t> indices;
+        for (const glm::vec3 &n : normals)
+        {
+            /** two axes spanning the face, ordered so faces wind counter-clockwise from outside */
+            glm::vec3     u    = glm::vec3(n.y, n.z, n.x);
+            glm::vec3     v    = glm::cross(n, u);
+            std::uint32_t base = static_cast<std::uint32_t>(vertices.size());
+            const float   uv[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+            for (auto &c : uv)
+            {
+                Vertex vertex;
+                vertex.v  = 0.5f * n + (c[0] - 0.5f) * u + (c[1] - 0.5f) * v;
+                vertex.vn = n;
+                vertex.uv = glm::vec2(c[0], c[1]);
+                vertices.push_back(vertex);
+            }
+            for (std::uint32_t i : {0u, 1u, 2u, 0u, 2u, 3u})
+                indices.push_back(base + i);
+        }
+        return core::assets::Mesh("render_bench/cube", false, false, std::move(vertices), std::move(indices));
+    }
+
+    class Cube : public Entity
+    {
+    public:
+        TransformComponent *transform;
+
+        Cube(const glm::vec3 &position, AssetID mesh, AssetID texture)
+        {
+            transform = &this->addComponent<TransformComponent>();
+            transform->setPosition(position);
+            this->addComponent<MeshRenderer>(mesh, texture);
+        }
+    };
+
+    class Camera : public Entity
+    {
+    public:
+        TransformComponent *transform;
+        CameraComponent    *camera;
+
+        Camera()
+        {
+            transform = &this->addComponent<TransformComponent>();
+            camera    = &this->addComponent<CameraComponent>(CameraComponent::Projection::Perspective);
+        }
+
+        /** orbits the origin, one revolution every 360 frames */
+        void place(unsigned int frame, float distance)
+        {
+            float     angle = glm::radians(static_cast<float>(frame % 360));
+            glm::vec3 eye   = glm::vec3(std::sin(angle), 0.35f, std::cos(angle)) * distance;
+            transform->setPosition(eye).setOrientation(glm::normalize(-eye), TransformComponent::worldUp);
+            camera->updateMatrix();
+        }
+    };
+
+    struct Summary
+    {
+        std::vector<float>                                   submitMs;
+        std::vector<float>                                   extractMs;
+        std::vector<float>                                   presentMs;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> checksums; /** (frame number, checksum) */
+        double                                               drawCalls      = 0;
+        double                                               instancedDraws = 0;
+        double                                               visible        = 0;
+        double                                               culled         = 0;
+        double                                               stateChanges   = 0;
+    };
+
+    float percentile(std::vector<float> samples, double p)
+    {
+        if (samples.empty()) return 0.0f;
+        std::size_t index = static_cast<std::size_t>(p * (samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index];
+    }
+
+    void printTimes(const char *name, const std::vector<float> &samples)
+    {
+        std::printf("  \"%s\": {\"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n",
+                    name,
+                    percentile(samples, 0.50),
+                    percentile(samples, 0.90),
+                    percentile(samples, 0.99),
+                    percentile(samples, 1.00));
+    }
+
+    Options parseOptions(int argc, char **argv)
+    {
+        Options opt;
+        for (int i = 1; i < argc; i++)
+        {
+            if (!std::strcmp(argv[i], "--frames") && i + 1 < argc)
+                opt.frames = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (!std::strcmp(argv[i], "--grid") && i + 1 < argc)
+                opt.grid = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            else if (!std::strcmp(argv[i], "--texture") && i + 1 < argc)
+                opt.texture = argv[++i];
+            else if (!std::strcmp(argv[i], "--onscreen"))
+                opt.onscreen = true;
+            else
+            {
+                std::fprintf(stderr,
+                             "Usage: %s [--frames N] [--grid N] [--texture NAME] [--onscreen]\n",
+                             argv[0]);
+                std::exit(1);
+            }
+        }
+        return opt;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options opt = parseOptions(argc, argv);
+
+    /** keep stdout for the results, and don't require an audio device */
+    core::utils::logging::setLevel(core::utils::logging::level::WARN);
+    if (!opt.onscreen) SDL_setenv("CORE_RENDER_OFFSCREEN", "1", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    Game *game = new Game("render_bench", 1280, 720);
+
+    OpenGLRenderer *renderer = dynamic_cast<OpenGLRenderer *>(Game::renderer());
+    if (!renderer)
+    {
+        std::fprintf(stderr, "render_bench: requires the OpenGL renderer\n");
+        return 1;
+    }
+    renderer->setFrameCapture(true);
+
+    AssetManager *assetManager = Game::assetManager();
+    AssetID       mesh         = assetManager->loadMesh(cubeMesh());
+    AssetID       texture      = assetManager->loadAsset(AssetType::Texture, opt.texture);
+
+    EntityManager *entityManager = Game::entityManager();
+    const float    spacing       = 2.0f;
+    const float    half          = 0.5f * spacing * (opt.grid - 1);
+    for (unsigned int x = 0; x < opt.grid; x++)
+        for (unsigned int y = 0; y < opt.grid; y++)
+            for (unsigned int z = 0; z < opt.grid; z++)
+                entityManager->addEntity<Cube>(glm::vec3(x, y, z) * spacing - glm::vec3(half), mesh, texture);
+    Camera &camera = entityManager->addEntity<Camera>();
+
+    Game::componentManager()->refresh();
+    entityManager->refresh();
+
+    Summary summary;
+    for (unsigned int frame = 0; frame < opt.frames; frame++)
+    {
+        camera.place(frame, 3.0f * half + 5.0f);
+
+        renderer->renderBegin();
+        renderer->render();
+        renderer->renderEnd();
+
+        const RendererStats &stats   = renderer->stats();
+        const RenderTimings &timings = renderer->timings();
+        summary.submitMs.push_back(timings.submitMs);
+        summary.extractMs.push_back(timings.extractMs);
+        summary.presentMs.push_back(timings.presentMs);
+        for (const auto &checksum : renderer->takeFrameChecksums()) summary.checksums.push_back(checksum);
+        summary.drawCalls += stats.drawCalls;
+        summary.instancedDraws += stats.instancedDraws;
+        summary.visible += stats.visible;
+        summary.culled += stats.culled;
+        summary.stateChanges += stats.stateChanges;
+    }
+
+    /** frames still in flight present their checksums once the render thread is done */
+    renderer->finish();
+    for (const auto &checksum : renderer->takeFrameChecksums()) summary.checksums.push_back(checksum);
+    std::sort(summary.checksums.begin(), summary.checksums.end());
+    if (summary.checksums.size() != opt.frames)
+        std::fprintf(stderr, "render_bench: %zu checksums for %u frames\n", summary.checksums.size(), opt.frames);
+
+    const double frames = std::max(opt.frames, 1u);
+    std::printf("{\n  \"frames\": %u,\n  \"cubes\": %u,\n", opt.frames, opt.grid * opt.grid * opt.grid);
+    printTimes("submit_ms", summary.submitMs);
+    printTimes("extract_ms", summary.extractMs);
+    printTimes("present_ms", summary.presentMs);
+    std::printf("  \"draw_calls\": %.2f,\n  \"instanced_draws\": %.2f,\n  \"visible\": %.2f,\n"
+                "  \"culled\": %.2f,\n  \"state_changes\": %.2f,\n",
+                summary.drawCalls / frames,
+                summary.instancedDraws / frames,
+                summary.visible / frames,
+                summary.culled / frames,
+                summary.stateChanges / frames);
+    std::printf("  \"checksums\": [");
+    for (std::size_t i = 0; i < summary.checksums.size(); i++)
+        std::printf("%s\"%016llx\"", i ? ", " : "", static_cast<unsigned long long>(summary.checksums[i].second));
+    std::printf("]\n}\n");
+
+    delete game;
+    return 0;
+}
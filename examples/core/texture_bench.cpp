@@ -0,0 +1,110 @@
+/**
+ * @file examples/core/texture_bench.cpp
+ * @author Cedric Velandres (ccvelandres@gmail.com)
+ *
+ * Benchmark for texture loads, decoding the source image against the bake cache.
+ *
+ * Loads each texture asset and prints the results as json on stdout:
+ *  - decode_ms: median time to decode the source into RGBA, what a load cost
+ *    without the cache before flipping the rows and building the mip chain in
+ *    the driver, neither of which is counted
+ *  - bake_ms: median time to decode the source and bake its mip chain, paid
+ *    once when the cache entry is missing or stale
+ *  - cached_ms: median time to hash the source and map the cache entry, its
+ *    pages are read once the levels are uploaded
+ *  - speedup: decode_ms / cached_ms
+ *
+ * Usage: texture_bench [--texture NAME]... [--runs N]
+ */
+
+#include <core/assets/bakedTexture.hpp>
+#include <core/assets/texture.hpp>
+#include <core/utils/logging.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::vector<std::string> textures;
+        unsigned int             runs = 5;
+    };
+
+    /** median milliseconds of @p load over @p runs */
+    double measure(unsigned int runs, const std::function<void()> &load)
+    {
+        std::vector<double> samples;
+        for (unsigned int run = 0; run < runs; run++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            load();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    Options parseOptions(int argc, char **argv)
+    {
+        Options opt;
+        for (int i = 1; i < argc; i++)
+        {
+            if (!std::strcmp(argv[i], "--texture") && i + 1 < argc)
+                opt.textures.push_back(argv[++i]);
+            else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc)
+                opt.runs = static_cast<unsigned int>(std::max(1ul, std::strtoul(argv[++i], nullptr, 10)));
+            else
+            {
+                std::fprintf(stderr, "Usage: %s [--texture NAME]... [--runs N]\n", argv[0]);
+                std::exit(1);
+            }
+        }
+        if (opt.textures.empty()) opt.textures = {"asteroids-backgrounds.png", "asteroids-sprites.png"};
+        return opt;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options opt = parseOptions(argc, argv);
+    core::utils::logging::setLevel(core::utils::logging::level::WARN);
+
+    std::printf("{\n  \"runs\": %u,\n  \"textures\": {\n", opt.runs);
+    for (std::size_t i = 0; i < opt.textures.size(); i++)
+    {
+        const std::string &name = opt.textures[i];
+
+        /** make sure the cache entry is current before timing cached loads */
+        core::assets::BakedTexture baked = core::assets::BakedTexture::load(name);
+
+        double decodeMs = measure(opt.runs, [&]() { core::assets::Texture texture(name); });
+        double bakeMs   = measure(opt.runs, [&]() {
+            core::assets::BakedTexture::bake(core::assets::Texture(name), 0);
+        });
+        double cachedMs = measure(opt.runs, [&]() { core::assets::BakedTexture::load(name); });
+
+        std::printf("    \"%s\": {\"width\": %zu, \"height\": %zu, \"levels\": %zu, \"mapped\": %s, "
+                    "\"decode_ms\": %.3f, \"bake_ms\": %.3f, \"cached_ms\": %.3f, \"speedup\": %.2f}%s\n",
+                    name.c_str(),
+                    baked.width(),
+                    baked.height(),
+                    baked.levels(),
+                    baked.mapped() ? "true" : "false",
+                    decodeMs,
+                    bakeMs,
+                    cachedMs,
+                    cachedMs > 0 ? decodeMs / cachedMs : 0.0,
+                    i + 1 < opt.textures.size() ? "," : "");
+    }
+    std::printf("  }\n}\n");
+    return 0;
+}
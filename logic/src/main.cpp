@@ -9,6 +9,7 @@
 #include <core/ecs/entityManager.hpp>
 #include <core/ecs/components.hpp>
 #include <core/graphics/renderer.hpp>
+#include <core/input/inputManager.hpp>
 #include <core/ui/text/fontLoader.hpp>
 #include <core/utils/logging.hpp>
 #include <core/assets/model.hpp>
@@ -40,17 +41,97 @@ public:
 
 class CameraObject : public Entity
 {
+    static constexpr float moveSpeed = 5.0f;  /** units per second */
+    static constexpr float turnSpeed = 90.0f; /** degrees per second */
+
+    AxisID                    moveX, moveY, moveZ, yaw, pitch, roll;
+    ActionID                  flip, toggleRelative, dumpAxes;
+    InputManager::LateLatchID lateLatch;
+    bool                      relative = true;
+
 public:
     TransformComponent *transform;
     CameraComponent    *camera;
-    InputComponent     *inputComponent;
 
     CameraObject()
     {
         transform = &this->addComponent<TransformComponent>();
         camera =
             &this->addComponent<CameraComponent>(CameraComponent::Projection::Perspective);
-        inputComponent = &this->addComponent<InputComponent>();
+
+        ActionMap &actions = Game::inputManager()->actionMap();
+        moveX              = actions.addAxis("camera.moveX");
+        moveY              = actions.addAxis("camera.moveY");
+        moveZ              = actions.addAxis("camera.moveZ");
+        yaw                = actions.addAxis("camera.yaw");
+        pitch              = actions.addAxis("camera.pitch");
+        roll               = actions.addAxis("camera.roll");
+        flip               = actions.addAction("camera.flip");
+        toggleRelative     = actions.addAction("camera.toggleRelative");
+        dumpAxes           = actions.addAction("camera.dumpAxes");
+
+        actions.bindKeyAxis(moveX, SDL_SCANCODE_A, SDL_SCANCODE_D)
+            .bindKeyAxis(moveY, SDL_SCANCODE_LCTRL, SDL_SCANCODE_LSHIFT)
+            .bindKeyAxis(moveZ, SDL_SCANCODE_W, SDL_SCANCODE_S)
+            .bindKeyAxis(yaw, SDL_SCANCODE_KP_4, SDL_SCANCODE_KP_6)
+            .bindKeyAxis(pitch, SDL_SCANCODE_KP_2, SDL_SCANCODE_KP_8)
+            .bindKeyAxis(roll, SDL_SCANCODE_KP_7, SDL_SCANCODE_KP_9)
+            .bindKey(flip, SDL_SCANCODE_R)
+            .bindKey(toggleRelative, SDL_SCANCODE_KP_0)
+            .bindKey(dumpAxes, SDL_SCANCODE_KP_ENTER);
+
+        /** orientation is applied at late-latch time, right before the view matrix is used */
+        lateLatch = Game::inputManager()->addLateLatchCallback(
+            [this](const ActionState &state, const time_ms &delta) { updateOrientation(state, delta); });
+    }
+
+    ~CameraObject() { Game::inputManager()->removeLateLatchCallback(lateLatch); }
+
+    void updateOrientation(const ActionState &state, const time_ms &delta)
+    {
+        const float dt = delta.count() / 1000.0f;
+
+        if (state.axis(yaw)) transform->rotate(state.axis(yaw) * turnSpeed * dt, TransformComponent::worldUp, relative);
+        if (state.axis(pitch))
+            transform->rotate(state.axis(pitch) * turnSpeed * dt, TransformComponent::worldRight, relative);
+        if (state.axis(roll))
+            transform->rotate(state.axis(roll) * turnSpeed * dt, TransformComponent::worldFront, relative);
+        camera->updateMatrix();
+    }
+
+    void update(time_ms delta) override
+    {
+        L_TAG("CameraObject::update");
+        const ActionState &state = Game::inputManager()->actions();
+        const float        dt    = delta.count() / 1000.0f;
+
+        glm::vec3 move = TransformComponent::worldRight * state.axis(moveX)
+                       + TransformComponent::worldUp * state.axis(moveY)
+                       + TransformComponent::worldFront * state.axis(moveZ);
+        if (move != glm::vec3(0.0f)) transform->translate(move * moveSpeed * dt, relative);
+
+        if (state.wasPressed(flip))
+        {
+            L_TRACE("pre ori:     {}", glm::to_string(transform->getOrientation()));
+            transform->setOrientation(glm::conjugate(transform->getOrientation()));
+            L_TRACE("pos ori:     {}", glm::to_string(transform->getOrientation()));
+        }
+        if (state.wasPressed(toggleRelative))
+        {
+            relative = !relative;
+            L_TRACE("Transform relative to {}", relative ? "self" : "world");
+        }
+        if (state.wasPressed(dumpAxes))
+        {
+            glm::vec3 forward = TransformComponent::worldFront * (transform->getOrientation());
+            glm::vec3 right   = TransformComponent::worldRight * (transform->getOrientation());
+            glm::vec3 up      = TransformComponent::worldUp * (transform->getOrientation());
+
+            L_TRACE("forward:     {}", glm::to_string(forward));
+            L_TRACE("right:       {}", glm::to_string(right));
+            L_TRACE("up:          {}", glm::to_string(up));
+        }
+        camera->updateMatrix();
     }
 };
 
@@ -106,75 +187,6 @@ int main(int arc, char **argv)
         // MeshRenderer &mesh = font.addComponent<MeshRenderer>(quadId, textureId);
     }
 
-    // Set KeyDown input listener
-    camObject.inputComponent->setListener(
-        InputEventType::KeyDown,
-        [&camObject](const InputEventType type, SDL_Event *ev) -> void {
-            static bool relative = true;
-            L_TAG("inputListener");
-            // L_INFO_RATE(32, "cameraInput KeyDown Event: {}", ev->key.keysym.sym);
-            CameraComponent    *cam       = &camObject.getComponent<CameraComponent>();
-            TransformComponent *transform = &camObject.getComponent<TransformComponent>();
-            switch (ev->key.keysym.sym)
-            {
-            case SDLK_w:
-                transform->translate(-TransformComponent::worldFront, relative);
-                break;
-            case SDLK_s:
-                transform->translate(TransformComponent::worldFront, relative);
-                break;
-            case SDLK_d:
-                transform->translate(TransformComponent::worldRight, relative);
-                break;
-            case SDLK_a:
-                transform->translate(-TransformComponent::worldRight, relative);
-                break;
-            case SDLK_r:
-                L_TRACE("pre ori:     {}", glm::to_string(transform->getOrientation()));
-                transform->setOrientation(glm::conjugate(transform->getOrientation()));
-                L_TRACE("pos ori:     {}", glm::to_string(transform->getOrientation()));
-                break;
-            case SDLK_LSHIFT:
-                transform->translate(TransformComponent::worldUp, relative);
-                break;
-            case SDLK_LCTRL:
-                transform->translate(-TransformComponent::worldUp, relative);
-                break;
-            case SDLK_KP_4:
-                transform->rotate(-5.0f, TransformComponent::worldUp, relative);
-                break;
-            case SDLK_KP_6:
-                transform->rotate(5.0f, TransformComponent::worldUp, relative);
-                break;
-            case SDLK_KP_2:
-                transform->rotate(-5.0f, TransformComponent::worldRight, relative);
-                break;
-            case SDLK_KP_8:
-                transform->rotate(5.0f, TransformComponent::worldRight, relative);
-                break;
-            case SDLK_KP_7:
-                transform->rotate(-5.0f, TransformComponent::worldFront, relative);
-                break;
-            case SDLK_KP_9:
-                transform->rotate(5.0f, TransformComponent::worldFront, relative);
-                break;
-            case SDLK_KP_0:
-                relative = !relative;
-                L_TRACE("Transform relative to {}", relative ? "self" : "world");
-                break;
-            case SDLK_KP_ENTER:
-                glm::vec3 forward = TransformComponent::worldFront * (transform->getOrientation());
-                glm::vec3 right = TransformComponent::worldRight * (transform->getOrientation());
-                glm::vec3 up = TransformComponent::worldUp * (transform->getOrientation());
-                
-                L_TRACE("forward:     {}", glm::to_string(forward));
-                L_TRACE("right:       {}", glm::to_string(right));
-                L_TRACE("up:          {}", glm::to_string(up));;
-                break;
-            }
-            cam->updateMatrix();
-        });
-
     audioComponent = &camObject.addComponent<AudioComponent>();
 
     core::audio::Audio &music0 = audioComponent->addAudioClip("ImperialMarch60.wav", false);